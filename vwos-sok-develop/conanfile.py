@@ -23,9 +23,13 @@ class Recipe(ConanFile):
     revision_mode = "scm"
     options = {
         "gtest": [True, False],
+        "shm_signal_transport": [True, False],
+        "perf_tools": [True, False],
     }
     default_options = {
         "gtest": False,
+        "shm_signal_transport": False,
+        "perf_tools": False,
     }
     generators = "CMakeDeps"
 
@@ -54,6 +58,8 @@ class Recipe(ConanFile):
         tc.cache_variables["CONAN_PKG_NAME"] = self.name
         tc.cache_variables["CONAN_PKG_VERSION"] = self.version
         tc.cache_variables['ENABLE_UNIT_TESTS'] = self.options.gtest
+        tc.cache_variables['ENABLE_SHM_SIGNAL_TRANSPORT'] = self.options.shm_signal_transport
+        tc.cache_variables['ENABLE_PERF_TOOLS'] = self.options.perf_tools
         if self.settings.os == 'Neutrino':
             tc.preprocessor_definitions["NEUTRINO_BUILD"] = 1
         tc.generate()
@@ -3,6 +3,8 @@
 #ifndef CSM_ACCESSOR_DEMO_HPP
 #define CSM_ACCESSOR_DEMO_HPP
 
+#include <mutex>
+#include <random>
 #include "ICsmAccessor.hpp"
 
 namespace sok {
@@ -12,6 +14,13 @@ class CsmAccessorDemo : public ICsmAccessor {
 public:
     CsmAccessorDemo();
 
+    /**
+     * @brief Construct a CSM accessor whose random bytes are repeatable, e.g. for a replay
+     * 
+     * @param seed seed of the random bytes, the same seed generates the same sequence of bytes
+     */
+    explicit CsmAccessorDemo(uint32_t seed);
+
     /**
      * @brief Creates MAC
      * 
@@ -51,6 +60,9 @@ public:
 
 private:
     std::vector<uint8_t>  hash(const std::vector<std::uint8_t>& v) const;
+
+    mutable std::mutex mRandomMutex;
+    mutable std::mt19937 mRandom;
 };    
 
 } // namespace common
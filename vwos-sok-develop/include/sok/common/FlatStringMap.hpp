@@ -0,0 +1,182 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FLAT_STRING_MAP_HPP
+#define FLAT_STRING_MAP_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sok
+{
+namespace common
+{
+
+/**
+ * @brief Hash map from string keys to values, for tables which are filled at initialization and
+ *        looked up on every signal event.
+ *
+ * All entries live in a single array (open addressing with linear probing) together with the hash
+ * of their key, so that a lookup touches one contiguous memory region and compares strings only
+ * on a full hash match. Keys can be looked up without constructing a std::string.
+ * Entries cannot be erased individually, only the whole map can be cleared.
+ */
+template <typename T>
+class FlatStringMap final
+{
+public:
+    FlatStringMap() = default;
+    ~FlatStringMap() = default;
+
+    /**
+     * @brief Find the value of a key
+     *
+     * @param key pointer to the key characters, not necessarily null terminated
+     * @param length number of characters of the key
+     * @return T* the value, nullptr if the key is not contained
+     */
+    T* Find(char const* key, size_t length)
+    {
+        return const_cast<T*>(static_cast<FlatStringMap const*>(this)->Find(key, length));
+    }
+
+    T const* Find(char const* key, size_t length) const
+    {
+        if (0U == mSize) {
+            return nullptr;
+        }
+        auto const& slot = mSlots[probe(Hash(key, length), key, length)];
+        return slot.occupied ? &slot.value : nullptr;
+    }
+
+    T* Find(std::string const& key) { return Find(key.data(), key.size()); }
+    T const* Find(std::string const& key) const { return Find(key.data(), key.size()); }
+
+    bool Contains(std::string const& key) const { return nullptr != Find(key); }
+
+    /**
+     * @brief Insert a value if the key is not contained yet
+     *
+     * @param key the key
+     * @param value the value to insert
+     * @return std::pair<T*, bool> the value of the key and true if it was inserted, false if the key already existed
+     */
+    std::pair<T*, bool> Emplace(std::string const& key, T value)
+    {
+        reserveForInsert();
+        auto hash = Hash(key.data(), key.size());
+        auto& slot = mSlots[probe(hash, key.data(), key.size())];
+        if (slot.occupied) {
+            return {&slot.value, false};
+        }
+        slot.hash = hash;
+        slot.occupied = true;
+        slot.key = key;
+        slot.value = std::move(value);
+        ++mSize;
+        return {&slot.value, true};
+    }
+
+    /**
+     * @brief Access the value of a key, a default constructed value is inserted if the key is not contained
+     *
+     * @param key the key
+     * @return T& the value of the key
+     */
+    T& operator[](std::string const& key)
+    {
+        return *Emplace(key, T()).first;
+    }
+
+    size_t Size() const { return mSize; }
+    bool Empty() const { return 0U == mSize; }
+
+    void Clear()
+    {
+        mSlots.clear();
+        mSize = 0U;
+    }
+
+    /**
+     * @brief Call a function for every entry, in unspecified order
+     *
+     * @param func callable with the signature void(std::string const& key, T& value)
+     */
+    template <typename F>
+    void ForEach(F&& func)
+    {
+        for (auto& slot : mSlots) {
+            if (slot.occupied) {
+                func(static_cast<std::string const&>(slot.key), slot.value);
+            }
+        }
+    }
+
+    /**
+     * @brief FNV-1a hash of a string
+     *
+     */
+    static uint64_t Hash(char const* key, size_t length)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<uint8_t>(key[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+private:
+    struct Slot {
+        uint64_t hash = 0U;
+        bool occupied = false;
+        std::string key;
+        T value{};
+    };
+
+    static constexpr size_t MIN_CAPACITY = 8U;
+
+    // index of the slot holding the key, or of the empty slot where it would be inserted
+    size_t probe(uint64_t hash, char const* key, size_t length) const
+    {
+        size_t const mask = mSlots.size() - 1U;
+        size_t index = static_cast<size_t>(hash) & mask;
+        while (mSlots[index].occupied) {
+            auto const& slot = mSlots[index];
+            if ((slot.hash == hash) && (slot.key.size() == length) && (0 == std::memcmp(slot.key.data(), key, length))) {
+                break;
+            }
+            index = (index + 1U) & mask;
+        }
+        return index;
+    }
+
+    // keeps the load factor at or below 1/2, so that probe sequences stay short
+    void reserveForInsert()
+    {
+        if (2U * (mSize + 1U) <= mSlots.size()) {
+            return;
+        }
+        std::vector<Slot> oldSlots(mSlots.empty() ? MIN_CAPACITY : 2U * mSlots.size());
+        oldSlots.swap(mSlots);
+        for (auto& slot : oldSlots) {
+            if (slot.occupied) {
+                mSlots[probe(slot.hash, slot.key.data(), slot.key.size())] = std::move(slot);
+            }
+        }
+    }
+
+private:
+    std::vector<Slot> mSlots;
+    size_t mSize = 0U;
+};
+
+template <typename T>
+constexpr size_t FlatStringMap<T>::MIN_CAPACITY;
+
+}  // namespace common
+}  // namespace sok
+
+#endif  // FLAT_STRING_MAP_HPP
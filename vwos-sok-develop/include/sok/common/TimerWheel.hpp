@@ -0,0 +1,169 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sok
+{
+namespace common
+{
+
+/**
+ * @brief Hashed timer wheel for many short timeouts which are mostly cancelled before they expire.
+ *
+ * A timer is placed in the slot of its expiry tick, so scheduling and cancelling do not depend on the number of
+ * running timers and advancing visits only the slots of the elapsed ticks. Timers which expire more than one
+ * revolution ahead stay in their slot until their tick is reached. The time is given by the caller in milliseconds
+ * and must not go backwards. Not thread safe.
+ */
+template <typename T>
+class TimerWheel final
+{
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER_ID = 0U;
+
+    /**
+     * @brief Construct a timer wheel
+     *
+     * @param tickMs the resolution of the wheel, a timer expires at the first advance on or after its expiry tick
+     * @param slotCount the number of slots of one revolution, best chosen to cover the longest timeout
+     */
+    TimerWheel(uint32_t tickMs, size_t slotCount)
+    : mTickMs((0U == tickMs) ? 1U : tickMs)
+    , mSlots((0U == slotCount) ? 1U : slotCount)
+    , mSlotOfTimer()
+    , mCurrentTick(0)
+    , mNextTimerId(INVALID_TIMER_ID + 1U)
+    {
+    }
+
+    /**
+     * @brief Start a timer
+     *
+     * @param nowMs the current time
+     * @param timeoutMs the time after which the timer expires
+     * @param value the value handed to the expiry callback
+     * @return TimerId the ID of the timer, to cancel it
+     */
+    TimerId Schedule(uint64_t nowMs, uint64_t timeoutMs, T value)
+    {
+        auto expiryTick = (nowMs + timeoutMs + mTickMs - 1U) / mTickMs;
+        if (expiryTick <= mCurrentTick) {
+            // the slot of the tick was already visited, the timer expires on the next advance
+            expiryTick = mCurrentTick + 1U;
+        }
+        auto const id = mNextTimerId++;
+        auto const slot = static_cast<size_t>(expiryTick % mSlots.size());
+        mSlots[slot].push_back(Timer{id, expiryTick, std::move(value)});
+        mSlotOfTimer[id] = slot;
+        return id;
+    }
+
+    /**
+     * @brief Stop a timer before it expires
+     *
+     * @param id the ID of the timer
+     * @return true if the timer was running
+     */
+    bool Cancel(TimerId id)
+    {
+        auto findRes = mSlotOfTimer.find(id);
+        if (mSlotOfTimer.end() == findRes) {
+            return false;
+        }
+        auto& timers = mSlots[findRes->second];
+        for (auto it = timers.begin(); it != timers.end(); ++it) {
+            if (id == it->id) {
+                if (&*it != &timers.back()) {
+                    *it = std::move(timers.back());
+                }
+                timers.pop_back();
+                break;
+            }
+        }
+        mSlotOfTimer.erase(findRes);
+        return true;
+    }
+
+    /**
+     * @brief Advance the wheel to the current time and expire the timers which are due
+     *
+     * @param nowMs the current time
+     * @param onExpired called with the ID and the value of each expired timer, after the timer was removed
+     */
+    template <typename F>
+    void Advance(uint64_t nowMs, F&& onExpired)
+    {
+        auto const nowTick = nowMs / mTickMs;
+        if (nowTick <= mCurrentTick) {
+            return;
+        }
+        // beyond one revolution every slot is visited once, all its due timers expire
+        auto const ticks = nowTick - mCurrentTick;
+        auto const visits = (ticks < mSlots.size()) ? ticks : static_cast<uint64_t>(mSlots.size());
+        std::vector<Timer> expired;
+        for (uint64_t i = 1; i <= visits; ++i) {
+            auto& timers = mSlots[static_cast<size_t>((mCurrentTick + i) % mSlots.size())];
+            for (size_t t = 0; t < timers.size();) {
+                if (timers[t].expiryTick <= nowTick) {
+                    mSlotOfTimer.erase(timers[t].id);
+                    expired.push_back(std::move(timers[t]));
+                    if ((t + 1U) != timers.size()) {
+                        timers[t] = std::move(timers.back());
+                    }
+                    timers.pop_back();
+                }
+                else {
+                    ++t;
+                }
+            }
+        }
+        mCurrentTick = nowTick;
+        for (auto&& timer : expired) {
+            onExpired(timer.id, timer.value);
+        }
+    }
+
+    /**
+     * @brief Stop all timers and restart the time of the wheel at 0
+     *
+     */
+    void Clear()
+    {
+        for (auto&& timers : mSlots) {
+            timers.clear();
+        }
+        mSlotOfTimer.clear();
+        mCurrentTick = 0;
+    }
+
+    size_t Size() const { return mSlotOfTimer.size(); }
+    bool Empty() const { return mSlotOfTimer.empty(); }
+
+private:
+    struct Timer {
+        TimerId id;
+        uint64_t expiryTick;
+        T value;
+    };
+
+    uint64_t mTickMs;
+    std::vector<std::vector<Timer>> mSlots;
+    std::unordered_map<TimerId, size_t> mSlotOfTimer;
+    uint64_t mCurrentTick;
+    TimerId mNextTimerId;
+};
+
+template <typename T>
+constexpr typename TimerWheel<T>::TimerId TimerWheel<T>::INVALID_TIMER_ID;
+
+} // namespace common
+} // namespace sok
+
+#endif // TIMER_WHEEL_HPP
@@ -5,22 +5,63 @@
 
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include "FreshnessValueManagerError.hpp"
 #include "FreshnessValueManagerDefinitions.hpp"
 #include "FreshnessValueManagerConfigAccessor.hpp"
+#include "FvmDiagnosticsDefinitions.hpp"
+#include "FvmExecutor.hpp"
+#include "FvStatePage.hpp"
+#include "FvStateSeqlock.hpp"
 #include "IFvmRuntimeAttributesManager.hpp"
 #include "ISignalManager.hpp"
 #include "sok/common/ICsmAccessor.hpp"
+#include "sok/common/FlatStringMap.hpp"
+#include "sok/common/TimerWheel.hpp"
 
 namespace sok
 {
 namespace fvm
 {
 
+/**
+ * @brief The collaborators of an FVM instance, the ones left empty are created by the internal factories.
+ *        Allows running FVM instances without the platform, e.g.: many instances in one simulation process
+ * 
+ */
+struct FvmDependencies {
+    std::shared_ptr<common::ICsmAccessor> csmAccessor;
+    std::shared_ptr<ISignalManager> signalManager;
+    std::shared_ptr<IFvmRuntimeAttributesManager> attributesManager;
+    std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor;
+    // the clock of the time stamps of the received signals, steady_clock::now if empty, e.g.: the virtual clock of a replay
+    std::function<std::chrono::steady_clock::time_point()> steadyClock;
+    // the seed of the FVM's own pseudo random numbers which are not taken from the CSM, 0 for a random seed
+    uint32_t randomSeed;
+};
+
 class AFreshnessValueManagerImpl
 {
 public:
     AFreshnessValueManagerImpl();
+
+    /**
+     * @brief Construct an FVM instance which exchanges its signals via the given signal manager,
+     *        e.g.: the SignalManagerReplay of a replay run
+     * 
+     * @param signalManager the signal manager to be used instead of the one of the platform
+     */
+    explicit AFreshnessValueManagerImpl(std::shared_ptr<ISignalManager> signalManager);
+
+    /**
+     * @brief Construct an FVM instance with the given collaborators
+     * 
+     * @param dependencies the collaborators to be used, the empty ones are created by the internal factories
+     */
+    explicit AFreshnessValueManagerImpl(FvmDependencies dependencies);
     virtual ~AFreshnessValueManagerImpl() = default;
 
     /**
@@ -38,9 +79,10 @@ public:
      * @param SecOCFreshnessValueID the identifier of the freshness value
      * @param SecOCTruncatedFreshnessValue optional - A shortened part of the freshness value may be transmitted by the SecOC as "Truncated Freshness Value" in the secured I-PDU. In the context of SOK, the truncated freshness value is used to transmit the session counter if one is used. Otherwise, the length of the Truncated Freshness Value is zero.
      * @param SecOCAuthVerifyAttempts the number of authentication verify attempts of this I-PDU/message since the last reception. The value is 0 for the first attempt and incremented on every unsuccessful verification attempt up to a configured `SecOCAuthenticationVerifyAttempts`.
+     *        For a challenge FV ID with several pending challenges, each attempt returns the next challenge, newest first.
      * @return FvmResult<FVContainer> freshness value container that holds the freshness value to be used for the calculation of the the authenticator by the SecOC or recoverable error.
      */
-    FvmResult<FVContainer> GetRxFreshness(SokFreshnessValueId SecOCFreshnessValueID, const FVContainer &SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts) noexcept;
+    virtual FvmResult<FVContainer> GetRxFreshness(SokFreshnessValueId SecOCFreshnessValueID, const FVContainer &SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts) noexcept;
 
     /**
      * @brief This method is used by the SecOC to obtain the current freshness value for creation of outgoing secure I-PDUs
@@ -48,21 +90,21 @@ public:
      * @param SecOCFreshnessValueID the identifier of the freshness value
      * @return FvmResult<FVContainer> freshness value container that holds the freshness value to be used for the calculation of the the authenticator by the SecOC or recoverable error.
      */
-    FvmResult<FVContainer> GetTxFreshness(SokFreshnessValueId SecOCFreshnessValueID) noexcept;
+    virtual FvmResult<FVContainer> GetTxFreshness(SokFreshnessValueId SecOCFreshnessValueID) noexcept;
 
     /**
      * @brief This function receives the result of a signature verification from the SecOC module.
      * 
      * @param [in] SecOC_VerificationStatusType - Data structure to bundle the status of a verification attempt for a specific Freshness Value and Data ID
      */
-    void VerificationStatusCallout(SecOC_VerificationStatusType verificationStatus) noexcept;
+    virtual void VerificationStatusCallout(SecOC_VerificationStatusType verificationStatus) noexcept;
 
     /**
      * @brief This interface is used by the SecOC to indicate that the Secured I-PDU has been initiated for transmission.
      * 
      * @param [in] SecOCFreshnessValueID - Holds the identifier of the freshness value.
      */
-    void SPduTxConfirmation(SokFreshnessValueId SecOCFreshnessValueID) noexcept;
+    virtual void SPduTxConfirmation(SokFreshnessValueId SecOCFreshnessValueID) noexcept;
 
     /**
      * @brief This function resets the internal state of SOK-FM to its initial value and checks the status of the VKMS keys used by SOK.
@@ -77,16 +119,17 @@ public:
      * MainFunction() is called at the specified intervals, e.g. when the ECU goes to sleep. 
      * Furthermore the status of all SOK protocols is reset. The function puts the SOK-FM in an inactive 
      * state with respect to SOK time until the next time the SokFm_MainFunction() is called. Challenge-response protocols can still be executed.
+     * A challenge indication which is running completes before Deinit() returns, must not be called by a challenge indication.
      * 
      * @return FvmErrorCode 
      */
     FvmErrorCode Deinit() noexcept;
 
     /**
-     * @brief  Trigger the transmission of a challenge
+     * @brief  Trigger the transmission of a challenge, up to `SOK_FM_MAX_CR_SESSIONS_PER_FV_ID` challenges of an FV ID may be pending
      * 
      */
-    FvmErrorCode TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID);
+    virtual FvmErrorCode TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID);
 
     /**
      * @brief Offer a CR service (producer side)
@@ -95,7 +138,38 @@ public:
      * @param cb a callback to be called to indicate that a challenge matching the provided SecOCFreshnessValueID has arrived
      * @return FvmErrorCode if offer registration has succeeded, error code otherwise
      */
-    FvmErrorCode OfferCrRequest(SokFreshnessValueId SecOCFreshnessValueID, ChallengeReceivedIndicationCb const& cb);
+    virtual FvmErrorCode OfferCrRequest(SokFreshnessValueId SecOCFreshnessValueID, ChallengeReceivedIndicationCb const& cb);
+
+    /**
+     * @brief The challenges indicated to the application, the data of the CR indication info
+     *        diagnostics parameter, may be called from any thread
+     * 
+     * @return FvmCrIndicationInfo the indication counters
+     */
+    FvmCrIndicationInfo GetCrIndicationInfo() const;
+
+    /**
+     * @brief The FV and the state it is valid in, as last published by the MainFunction or a resync.
+     *        May be called from any thread without locking
+     * 
+     * @return FvStateRecord a consistent record of the FV state
+     */
+    virtual FvStateRecord GetFvState() const noexcept;
+
+    /**
+     * @brief Mirror the published FV state into the FV state page of the FVM daemon, must be called before `Init()`
+     * 
+     * @param page the writable FV state page
+     */
+    void SetFvStatePage(std::shared_ptr<FvStatePage> page) noexcept;
+
+    /**
+     * @brief Whether the freshness value ID is configured for this instance, e.g.: to route the SecOC calls of a gateway
+     * 
+     * @param SecOCFreshnessValueID the identifier of the freshness value
+     * @return true if configured as an authentic broadcast or a challenge-response FV
+     */
+    bool IsFreshnessValueIdConfigured(SokFreshnessValueId SecOCFreshnessValueID) const noexcept;
 
 protected:
     /**
@@ -103,7 +177,7 @@ protected:
      * 
      * @return bool result of subscription
      */
-    bool registerToSignals() noexcept;
+    virtual bool registerToSignals() noexcept;
 
     /**
      * @brief increments internal timers, must be called by inheritors with each `MainFunction()` call
@@ -111,6 +185,14 @@ protected:
      */
     void incTimers() noexcept;
 
+    /**
+     * @brief publishes the FV state to the SecOC threads, must be called by inheritors whenever they set
+     *        the FV or its validity outside of `incTimers()`
+     * 
+     * @param resynced true if the FV was set instead of incremented, starts a new epoch of the FV state
+     */
+    void publishFvState(bool resynced) noexcept;
+
     /**
      * @brief does specific initialization actions. e.g.: registering for the FV distribution specific signals.
      * 
@@ -119,13 +201,58 @@ protected:
      */
     virtual bool serverOrParticipantInit() noexcept = 0;
 
+    /**
+     * @brief returns the FV distribution signals which are published by this role, e.g.: the FV responses of the server.
+     * 
+     * @return std::vector<SignalConfig> the outgoing signals to be prepared at `Init()`
+     */
+    virtual std::vector<SignalConfig> serverOrParticipantOutgoingSignals() noexcept = 0;
+
+    /**
+     * @brief does specific deinitialization actions before the state is reset, e.g.: stopping the processing of the received signals.
+     * 
+     */
+    virtual void serverOrParticipantDeinit() noexcept {}
+
+    /**
+     * @brief starts the executor of the challenge indication callbacks if one is configured
+     * 
+     * @return true on success or if none is configured
+     */
+    bool startCrIndicationExecutor() noexcept;
+
 private:
+    /**
+     * @brief The session a timeout belongs to
+     *
+     */
+    struct CrSessionTimeout {
+        SokFreshnessValueId fvId;
+        bool outgoing;
+    };
+
+    /**
+     * @brief A pending challenge-response session, the challenge identifies it among the sessions of its FV ID
+     *
+     */
+    struct CrSession {
+        std::vector<uint8_t> challenge;
+        common::TimerWheel<CrSessionTimeout>::TimerId timerId;
+    };
+
+    using CrSessions = std::unordered_map<SokFreshnessValueId, std::deque<CrSession>>;
+    // the timer ID of a session is its key, it stays unique after the session completed
+    using CrSessionKey = common::TimerWheel<CrSessionTimeout>::TimerId;
+
+    void warmUpOutgoingSignals() noexcept;
+    void expireCrSessions() noexcept;
+    void eraseCrSession(CrSessions& allSessions, SokFreshnessValueId fvId, common::TimerWheel<CrSessionTimeout>::TimerId timerId);
     void incomingChallengeSignalCb(std::string const& signal, std::vector<uint8_t> const& value);
-    FvmResult<FVContainer> getChallengeForIncomingResponse(SokFreshnessValueId SecOCFreshnessValueID, FVContainer const& SecOCTruncatedFreshnessValue);
+    FvmResult<FVContainer> getChallengeForIncomingResponse(SokFreshnessValueId SecOCFreshnessValueID, FVContainer const& SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts);
     FvmResult<FVContainer> getChallengeForOutgoingResponse(SokFreshnessValueId SecOCFreshnessValueID);
     FvmResult<FVContainer> getRxFv(SokFreshnessValueId SecOCFreshnessValueID, SokFreshnessType type, FVContainer const& SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts);
     FvmResult<FVContainer> getTxFv(SokFreshnessValueId SecOCFreshnessValueID, SokFreshnessType type);
-    void updateVerificationStatusChallenge(SokFreshnessValueId SecOCFreshnessValueID, bool verificationSucceeded);
+    void updateVerificationStatusChallenge(SokFreshnessValueId SecOCFreshnessValueID, CrSessionKey session, bool verificationSucceeded);
     void updateVerificationStatusAuthBroadcast(SokFreshnessValueId SecOCFreshnessValueID, bool verificationSucceeded);
 
 protected:
@@ -134,15 +261,33 @@ protected:
     uint64_t mTimeSinceInit;
     uint32_t mClockCount;
     std::atomic_uint64_t mFV;
-    std::unordered_map<SokFreshnessValueId, std::pair<uint64_t, std::vector<uint8_t>>> mActiveOutgoingChallenges;
-    std::unordered_map<SokFreshnessValueId, std::pair<uint64_t, std::vector<uint8_t>>> mActiveIncomingChallenges;
-    std::unordered_map<std::string, SokFreshnessValueId> mChallengeSignalToFvId;
+    // the members above are owned by the MainFunction thread, the other threads read this snapshot of them
+    FvStateSeqlock mFvState;
+    std::shared_ptr<FvStatePage> mFvStatePage;
+    uint32_t mFvEpoch;
+    std::function<std::chrono::steady_clock::time_point()> mSteadyNow;
+    uint32_t mRandomSeed;
+    // the CR sessions are accessed by the SecOC, the signal and the MainFunction threads, oldest session first
+    std::mutex mCrSessionsMutex;
+    CrSessions mOutgoingCrSessions;
+    CrSessions mIncomingCrSessions;
+    // the sessions of the responses SecOC is verifying, in the order of their first verify attempt. A session
+    // completes on the successful verification of its response, the verification statuses arrive in the same order
+    std::unordered_map<SokFreshnessValueId, std::deque<CrSessionKey>> mVerifyingSessions;
+    common::TimerWheel<CrSessionTimeout> mCrSessionTimers;
+    // runs the indication callbacks of the application if configured, they run on the signal thread otherwise
+    std::unique_ptr<FvmExecutor> mCrIndicationExecutor;
+    mutable std::mutex mCrIndicationInfoMutex;
+    FvmCrIndicationInfo mCrIndicationInfo;
+    common::FlatStringMap<SokFreshnessValueId> mChallengeSignalToFvId;
+    // guarded by mCrSessionsMutex, the callbacks are withdrawn by Deinit() while challenges may arrive
     std::unordered_map<SokFreshnessValueId, ChallengeReceivedIndicationCb> mFvIdToNotificationCallback;
     std::unordered_map<SokFreshnessValueId, std::vector<uint64_t>> mFvRxCandidates;
+    // initialized first, the default collaborators of the instance read its configuration
+    std::shared_ptr<IFreshnessValueManagerConfigAccessor> mFvmConfAccessor;
     std::shared_ptr<common::ICsmAccessor> mCsmAccessor;
     std::shared_ptr<ISignalManager> mSignalManager;
     std::shared_ptr<IFvmRuntimeAttributesManager> mAttrMgr;
-    std::shared_ptr<IFreshnessValueManagerConfigAccessor> mFvmConfAccessor;
 };
 
 } // namespace fvm
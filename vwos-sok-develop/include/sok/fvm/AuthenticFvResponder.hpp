@@ -0,0 +1,151 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef AUTHENTIC_FV_RESPONDER_HPP
+#define AUTHENTIC_FV_RESPONDER_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "FreshnessValueManagerError.hpp"
+#include "FreshnessValueManagerDefinitions.hpp"
+#include "FvmDiagnosticsDefinitions.hpp"
+#include "ISignalManager.hpp"
+#include "sok/common/ICsmAccessor.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief Answers the authentic FV challenges of a set of clients with the FV of its owner.
+ *
+ * Used by the SOK time server for its participants, and by a participant relaying its authentic FV to
+ * downstream ECUs. Challenges are received without locking and answered by the owner's MainFunction
+ * in response rounds, the earliest deadline first within a MAC budget per round.
+ */
+class AuthenticFvResponder
+{
+public:
+    AuthenticFvResponder(std::shared_ptr<common::ICsmAccessor> csmAccessor, std::shared_ptr<ISignalManager> signalManager);
+    ~AuthenticFvResponder() = default;
+
+    AuthenticFvResponder(AuthenticFvResponder const&) = delete;
+    AuthenticFvResponder& operator=(AuthenticFvResponder const&) = delete;
+
+    /**
+     * @brief Check the keys of the clients and subscribe to their challenge signals
+     *
+     * @param clients the clients to answer
+     * @param timeSinceInitMs the current time of the owner
+     * @return true upon success, false otherwise
+     */
+    bool Init(FmServerClientsConfigMap const& clients, uint64_t timeSinceInitMs);
+
+    /**
+     * @brief Update the time with which arriving challenges are stamped, to be called by the owner's
+     *        MainFunction after advancing its time
+     *
+     * @param timeSinceInitMs the current time of the owner
+     */
+    void UpdateClock(uint64_t timeSinceInitMs);
+
+    /**
+     * @brief Answer the pending challenges, up to `SOK_FM_SERVER_MAX_RESPONSES_PER_CYCLE`
+     *
+     * @param fv the FV to respond with
+     * @param timeSinceInitMs the current time of the owner
+     * @return true if challenges beyond the budget were deferred to the next round, false otherwise
+     */
+    bool SendResponses(uint64_t fv, uint64_t timeSinceInitMs);
+
+    /**
+     * @brief The response signals of the clients
+     *
+     * @return std::vector<SignalConfig> the outgoing signals to be prepared at init
+     */
+    std::vector<SignalConfig> OutgoingSignals() const;
+
+    /**
+     * @brief Health of the authentic FV distribution per client, may be called from any thread
+     *
+     * @return std::vector<FvmClientHealthRecord> a record per client
+     */
+    std::vector<FvmClientHealthRecord> GetClientHealth() const;
+
+    bool HasClients() const { return !mClientSlots.empty(); }
+
+private:
+    /**
+     * @brief Per client configuration of the authentic FV distribution, the index of a client's slot is bound to
+     *        the subscription of its challenge signal at init
+     *
+     */
+    struct ClientSlot {
+        std::string ecuName;
+        uint16_t keyId;
+        SignalConfig challengeSignal;
+        SignalConfig responseValueSignal;
+        SignalConfig responseSignatureSignal;
+    };
+
+    /**
+     * @brief The latest challenge of a client, written by the signal thread and read by the MainFunction
+     *        without locking (sequence lock, a single writer per client)
+     *
+     */
+    struct PendingChallenge {
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint8_t> length;
+        std::atomic<uint64_t> value;
+        std::atomic<uint64_t> arrivalTimeMs;
+    };
+
+    /**
+     * @brief A challenge taken over by a response round
+     *
+     */
+    struct ResponseCandidate {
+        size_t clientIndex;
+        uint64_t arrivalTimeMs;
+        uint32_t sequence;
+        std::vector<uint8_t> challenge;
+    };
+
+    void incomingChallengeSignalCb(size_t clientIndex, std::vector<uint8_t> const& challenge);
+    void allocatePendingChallenges();
+    bool readPendingChallenge(size_t clientIndex, std::vector<uint8_t>& challenge, uint64_t& arrivalTimeMs, uint32_t& sequence) const;
+    void recordChallenge(ResponseCandidate const& candidate);
+    void takeChallenge(ResponseCandidate const& candidate);
+    std::vector<ResponseCandidate> admitPendingChallenges(uint64_t timeSinceInitMs);
+    FvmErrorCode sendResponse(ResponseCandidate const& candidate, std::vector<uint8_t> const& serializedFv, uint64_t timeSinceInitMs,
+                              std::vector<uint8_t>& data);
+
+private:
+    std::shared_ptr<common::ICsmAccessor> mCsmAccessor;
+    std::shared_ptr<ISignalManager> mSignalManager;
+    std::vector<ClientSlot> mClientSlots;
+    std::unique_ptr<PendingChallenge[]> mPendingChallenges;
+    // bit i of word i / 64 is set while client i has a challenge waiting for its response. It is set after the
+    // challenge was written, so a bit may be set again for a challenge a round has already taken, see mTakenChallengeSequence
+    std::unique_ptr<std::atomic<uint64_t>[]> mPendingClientsBitmap;
+    size_t mPendingClientsBitmapWords;
+    // the time since init as seen by the challenge callbacks, to stamp the arrival of challenges
+    std::atomic<uint64_t> mChallengeClockMs;
+    // per client, the earliest time of its next response (SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS)
+    std::vector<uint64_t> mNextResponseTimeMs;
+    std::atomic<uint64_t> mExpiredChallenges;
+    std::atomic<uint64_t> mRateLimitedChallenges;
+    mutable std::mutex mClientHealthMutex;
+    std::vector<FvmClientHealthRecord> mClientHealth;
+    // per client, the sequence of the pending challenge which was last counted in the client's health record
+    std::vector<uint32_t> mCountedChallengeSequence;
+    // per client, the sequence of the pending challenge which was last answered or dropped, accessed by the owner's MainFunction only
+    std::vector<uint32_t> mTakenChallengeSequence;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // AUTHENTIC_FV_RESPONDER_HPP
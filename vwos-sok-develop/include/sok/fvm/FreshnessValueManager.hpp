@@ -4,21 +4,71 @@
 #define FRESHNESS_VALUE_MANAGER_HPP
 
 #include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
 #include "FreshnessValueManagerError.hpp"
 #include "FreshnessValueManagerDefinitions.hpp"
 
 namespace sok
 {
+namespace common
+{
+class ICsmAccessor;
+} // namespace common
+
 namespace fvm
 {
 
 // forward declaration for the abstract impl class
 class AFreshnessValueManagerImpl;
+class ISignalManager;
+class IFreshnessValueManagerConfigAccessor;
+class FvmDaemonServer;
+struct FvmIpcMessage;
+
+/**
+ * @brief The settings of an FVM instance created by FreshnessValueManager::Create()
+ * 
+ * @param role the role of the instance if its configuration has no `ecu_function`
+ * @param configFile the path of the configuration file, if empty the default file of the role is read from the static data
+ * @param csmAccessor optional - the crypto accessor of the instance, if empty the one of the platform is created
+ * @param signalManager optional - the signal manager of the instance, if empty the one of the platform is created.
+ *        The roles of a gateway share the crypto accessor and a given signal manager
+ * @param runMainFunctionThread if true, the MainFunction() is called by a thread of the instance between Init() and Deinit()
+ * @param cpuAffinity optional - the CPU the MainFunction thread is pinned to, negative for none
+ */
+struct FvmInstanceConfig {
+    FvmRole role;
+    std::string configFile;
+    std::shared_ptr<common::ICsmAccessor> csmAccessor;
+    std::shared_ptr<ISignalManager> signalManager;
+    bool runMainFunctionThread;
+    int32_t cpuAffinity;
+};
 
 class FreshnessValueManager 
 {
 public:
+    /**
+     * @brief Get the default instance of the process. Its role is the `ecu_function` of its configuration,
+     *        the default configuration file and role are defined at build time.
+     *        With an `fv_daemon_config` in its configuration, the instance is either the FVM daemon of the ECU
+     *        or a client of it which reads the FV of the daemon instead of running the FV synchronization itself
+     * 
+     */
     static std::shared_ptr<FreshnessValueManager> GetInstance();
+
+    /**
+     * @brief Create an FVM instance independent of the default one and of the other created instances,
+     *        e.g.: a gateway serving a time domain per vehicle network
+     * 
+     * @param config the settings of the instance
+     * @return std::shared_ptr<FreshnessValueManager> the new instance, not initialized yet. Its configuration is read
+     *         and its role selected by the first Init()
+     */
+    static std::shared_ptr<FreshnessValueManager> Create(FvmInstanceConfig const& config);
     ~FreshnessValueManager();
     /**
      * @brief This method is used by the SecOC to obtain the current freshness value for validation of incoming secured I-PDUs
@@ -55,6 +105,7 @@ public:
     /**
      * @brief This function must be called before SOK-protected communication can begin.
      *        This function must be called every `SokFmMainFunctionPeriod` milliseconds after the first call.
+     *        Not to be called for an instance running its own MainFunction thread.
      * 
      * 
      * @return FvmErrorCode 
@@ -80,7 +131,8 @@ public:
     FvmErrorCode Deinit() noexcept;
 
     /**
-     * @brief  Trigger the transmission of a challenge (consumer side)
+     * @brief  Trigger the transmission of a challenge (consumer side), up to `SOK_FM_MAX_CR_SESSIONS_PER_FV_ID` challenges
+     *         of an FV ID may be pending
      * 
      */
     FvmErrorCode TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID);
@@ -106,8 +158,28 @@ private:
      */
     FreshnessValueManager();
 
+    FreshnessValueManager(FvmInstanceConfig const& config, std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor);
+
+    bool createImpls() noexcept;
+    AFreshnessValueManagerImpl* implOf(SokFreshnessValueId SecOCFreshnessValueID) const noexcept;
+    void handleDaemonRequest(uint64_t connection, FvmIpcMessage const& request, FvmIpcMessage& response) noexcept;
+    bool startMainFunctionThread() noexcept;
+    void stopMainFunctionThread() noexcept;
+    void runMainFunction() noexcept;
+
 private:
+    FvmInstanceConfig mInstanceConfig;
+    std::shared_ptr<IFreshnessValueManagerConfigAccessor> mConfAccessor;
+    std::mutex mInitMutex;
+    // set once the impls below are created, they are not replaced afterwards
+    std::atomic<bool> mImplsCreated;
     std::unique_ptr<AFreshnessValueManagerImpl> pImpl;
+    // the participant role of a gateway, pImpl is its server role
+    std::unique_ptr<AFreshnessValueManagerImpl> pGatewayParticipantImpl;
+    // the IPC endpoint of the SecOC processes of the ECU if this instance is its FVM daemon
+    std::unique_ptr<FvmDaemonServer> mDaemonServer;
+    std::atomic<bool> mMainFunctionThreadRunning;
+    std::thread mMainFunctionThread;
 };
 
 } // namespace fvm
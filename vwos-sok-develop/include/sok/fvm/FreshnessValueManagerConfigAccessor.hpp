@@ -18,6 +18,15 @@ class FreshnessValueManagerConfigAccessor : public IFreshnessValueManagerConfigA
 public:
     static std::shared_ptr<FreshnessValueManagerConfigAccessor> GetInstance();
 
+    /**
+     * @brief Create a config accessor of its own for an FVM instance
+     * 
+     * @param role the role of the FVM instance, selects the default configuration file
+     * @param configFile the path of the configuration file, if empty the default file of the role is read from the static data
+     * @return std::shared_ptr<FreshnessValueManagerConfigAccessor> the new accessor, not initialized yet
+     */
+    static std::shared_ptr<FreshnessValueManagerConfigAccessor> Create(FvmRole role, std::string const& configFile);
+
     /**
      * @brief Get the SokFvConfigArrayInstance Entry By FvId
      * 
@@ -63,6 +72,17 @@ public:
 
     SokKeyConfig GetSokKeyConfig() const override;
     uint16_t GetEcuKeyIdForFvDistribution() const override;
+    bool IsSignalTxBatchingEnabled() const override;
+    std::string GetSignalRecordingFile() const override;
+    std::string GetFvCheckpointFile() const override;
+    bool IsEventDrivenProcessingEnabled() const override;
+    FvmRole GetEcuFunction() const override;
+    std::string GetGatewayParticipantConfigFile() const override;
+    GroupFvBroadcastConfig GetGroupFvBroadcastConfig() const override;
+    TimeServerEndpoints GetRedundantTimeServers() const override;
+    FvRequestRetryPolicy GetFvRequestRetryPolicy() const override;
+    FvDaemonConfig GetFvDaemonConfig() const override;
+    CrIndicationExecutorConfig GetCrIndicationExecutorConfig() const override;
 
     FreshnessValueManagerConfigAccessor(const FreshnessValueManagerConfigAccessor&)            = delete;
     FreshnessValueManagerConfigAccessor(FreshnessValueManagerConfigAccessor&&)                 = delete;
@@ -75,7 +95,11 @@ private:
      */
     FreshnessValueManagerConfigAccessor();
 
+    FreshnessValueManagerConfigAccessor(FvmRole role, std::string const& configFile);
+
 private:
+    FvmRole mRole;
+    std::string mConfigFile;
     FvmConfigParser mParser;
     SokFmConfig mConfig;
     bool mInitialized;
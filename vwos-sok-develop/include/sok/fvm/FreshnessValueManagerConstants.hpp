@@ -55,18 +55,97 @@ constexpr uint8_t SOK_FM_TIME_REQUEST_TIMEOUT_MS = 250;
  */
 constexpr uint8_t SOK_FM_CHALLENGE_TIMEOUT_MS = 250;
 
+/**
+ * @brief The number of challenge-response sessions which can be pending at the same time for one freshness value ID in each
+ *        direction, further challenges are rejected until a session completes or times out
+ * 
+ */
+constexpr uint8_t SOK_FM_MAX_CR_SESSIONS_PER_FV_ID = 4;
+
 /**
  * @brief This value represents the time interval in milliseconds after which the SOK timeserver sends an unprotected time message
  * 
  */
 constexpr uint16_t SOK_FM_TIME_SEND_MS = 1000;
 
+/**
+ * @brief The minimum time interval in milliseconds between two challenges of the same participant which the SOK time server accepts,
+ *        challenges arriving faster are dropped. A participant repeats its challenge only after `SOK_FM_TIME_REQUEST_TIMEOUT_MS`
+ * 
+ */
+constexpr uint8_t SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS = 50;
+
+/**
+ * @brief The maximum number of authentic FV responses (MACs) which the SOK time server creates in one MainFunction() cycle,
+ *        the remaining challenges are answered in the following cycles
+ * 
+ */
+constexpr uint16_t SOK_FM_SERVER_MAX_RESPONSES_PER_CYCLE = 16;
+
+/**
+ * @brief The longest round trip in milliseconds of an authentic FV request which a participant takes as a sample of the
+ *        transmission delay. The server holds a challenge until its next FV increment, a longer round trip mostly measures that hold
+ * 
+ */
+constexpr uint8_t SOK_FM_AUTH_FV_ROUND_TRIP_SAMPLE_MAX_MS = 4 * SOK_FM_MAIN_FUNCTION_PERIOD_MS;
+
+/**
+ * @brief The minimum time interval in milliseconds between two writes of the FV checkpoint of the SOK time server
+ * 
+ */
+constexpr uint16_t SOK_FM_FV_CHECKPOINT_PERIOD_MS = 1000;
+
+/**
+ * @brief The number of FV increments (10 minutes) the SOK time server reserves ahead of its FV in the FV checkpoint, the server
+ *        renews the reservation once half of it is used, so the reservation is synced to the storage only every few minutes.
+ *        A server restarted after a reboot continues from the reservation
+ * 
+ */
+constexpr uint64_t SOK_FM_FV_CHECKPOINT_MARGIN = (10U * 60U * 1000U) / SOK_FM_TIME_INCREMENT_PERIOD_MS;
+
+/**
+ * @brief The number of unauthenticated FV broadcasts over which a participant estimates the drift of its clock
+ * 
+ */
+constexpr uint8_t SOK_FM_DRIFT_WINDOW = 32;
+
+/**
+ * @brief The number of unauthenticated FV broadcasts a participant needs before it slews its clock
+ * 
+ */
+constexpr uint8_t SOK_FM_DRIFT_MIN_SAMPLES = 4;
+
+/**
+ * @brief The maximum rate in ppm at which a participant slews its clock towards the clock of the SOK time server,
+ *        above the tolerance of the oscillators
+ * 
+ */
+constexpr uint16_t SOK_FM_MAX_SLEW_PPM = 500;
+
+/**
+ * @brief The time in milliseconds over which a participant slews away the offset of its clock, in addition to its drift
+ * 
+ */
+constexpr uint16_t SOK_FM_SLEW_HORIZON_MS = 10000;
+
 /**
  * @brief number of allowed verification attempts for freshness value IDs of Challenge/Response type
  * 
  */
 constexpr uint8_t MAX_VERIFY_ATTEMPTS_CR_TYPE = 1;
 
+/**
+ * @brief The number of tasks the FVM executor queues, further tasks are rejected until the queue drains
+ * 
+ */
+constexpr uint16_t SOK_FM_EXECUTOR_QUEUE_CAPACITY = 32;
+
+/**
+ * @brief The time in milliseconds a SecOC process waits for the FVM daemon to answer a request forwarded to it
+ * 
+ */
+constexpr uint16_t SOK_FM_DAEMON_IPC_TIMEOUT_MS = 50;
+
 /**
  * @brief number of allowed verification attempts for plain freshness value IDs
  * 
@@ -84,6 +163,15 @@ constexpr uint8_t CHALLENGE_LENGTH_BYTES = 8;
 
 constexpr uint8_t FVM_SERVER_NUM_OF_BYTES_INITIAL_FV = 7;
 
+/**
+ * @brief The group FV broadcast carries the server nonce, the FV and the MAC over both, in this order.
+ *        The nonce consists of the server session (upper 4 bytes, random per server start) and a counter of the broadcasts
+ * 
+ */
+constexpr uint8_t GROUP_FV_NONCE_LENGTH_BYTES = 8;
+
+constexpr uint8_t GROUP_FV_BROADCAST_LENGTH_BYTES = GROUP_FV_NONCE_LENGTH_BYTES + FVM_SERVER_NUM_OF_BYTES_INITIAL_FV + AUTH_FV_SIGNATURE_SIZE_BYTES;
+
 } // namespace fvm
 } // namespace sok
 
@@ -35,6 +35,17 @@ enum class SokFreshnessType : uint8_t {
     kEndEnum
 };
 
+/**
+ * @brief enum representing the role of an FVM instance in the SOK time protocol
+ *
+ */
+enum class FvmRole : uint8_t {
+    kServer = 0,
+    kParticipant,
+    // the time server of one domain and a participant of another
+    kGateway
+};
+
 /**
  * @brief struct representing a verification status
  * 
@@ -137,10 +148,93 @@ struct SokFvClientConfigArrayInstance {
     uint16_t keyId;
 };
 
+/**
+ * @brief struct representing the group authenticated FV broadcast of the FVM server, an FV with a MAC under a
+ *        key shared by all participants. Disabled if not configured
+ * 
+ */
+struct GroupFvBroadcastConfig {
+    bool enabled;
+    uint16_t keyId;
+    uint32_t periodMs;
+    SignalConfig signal;
+};
+
+/**
+ * @brief for FVM participant only - the delay of a repeated authentic FV request after an unanswered one,
+ *        drawn uniformly from [0, min(maxDelayMs, baseDelayMs * 2^(retry - 1))] (exponential backoff with full
+ *        jitter) and waited for after `SOK_FM_TIME_REQUEST_TIMEOUT_MS` before the request is sent again.
+ *        Disabled if not configured
+ * 
+ */
+struct FvRequestRetryPolicy {
+    bool enabled;
+    uint32_t baseDelayMs;
+    uint32_t maxDelayMs;
+};
+
+/**
+ * @brief for FVM participant only - an additional SOK time server which is challenged in parallel to the
+ *        server of the authenticated FV signals, the first verified response is taken over
+ * 
+ */
+struct TimeServerEndpointConfig {
+    std::string serverEcuName;
+    uint16_t keyId;
+    SignalConfig challengeSignal;
+    SignalConfig responseValueSignal;
+    SignalConfig responseSignatureSignal;
+};
+
+/**
+ * @brief The part an FVM instance takes in sharing the FV of an ECU among its SecOC processes
+ * 
+ */
+enum class FvDaemonMode : uint8_t {
+    // the FVM instance serves only the SecOC of its own process
+    kDisabled = 0,
+    // the FVM instance of the ECU, publishes its FV state to the FV state page and serves the IPC requests
+    kDaemon,
+    // the FVM instance of a SecOC process, reads the FV state page of the daemon and forwards the rest to it
+    kClient
+};
+
+// the user or group ID of the FVM daemon process itself
+constexpr int64_t FV_DAEMON_OWN_ID = -1;
+
+/**
+ * @brief The FVM daemon of an ECU, runs the FV synchronization once for all SecOC processes of the ECU.
+ *        Disabled if not configured
+ * 
+ */
+struct FvDaemonConfig {
+    FvDaemonMode mode;
+    // the name of the POSIX shared memory page of the FV state
+    std::string pageName;
+    // the path of the local socket of the session counter and challenge-response requests
+    std::string socketPath;
+    // the SecOC processes of this user or group may connect to the daemon's socket, besides root
+    int64_t clientUid;
+    int64_t clientGid;
+};
+
+/**
+ * @brief An executor owned by the FVM which runs the challenge indication callbacks of the application off the signal
+ *        receive thread. Disabled if not configured, the callbacks then run on the receive thread
+ * 
+ */
+struct CrIndicationExecutorConfig {
+    bool enabled;
+    uint8_t threadCount;
+    // the number of indications which may wait for a thread, further challenges are dropped
+    uint16_t queueDepth;
+};
+
 using SokFvConfig = std::unordered_map<SokFreshnessValueId, SokFvConfigInstance>;
 using ChallengeConfig = std::unordered_map<SokFreshnessValueId, ChallengeConfigInstance>;
 using FmServerClientsConfigMap = std::unordered_map<std::string, SokFvClientConfigArrayInstance>;
 using SokKeyConfig = std::unordered_map<SokFreshnessValueId, uint16_t>;
+using TimeServerEndpoints = std::vector<TimeServerEndpointConfig>;
 
 struct SokFmConfig {
     std::string mNetworkInterface;
@@ -154,6 +248,17 @@ struct SokFmConfig {
     SignalConfig mAuthFvChallengeSignal;
     SignalConfig mAuthFvValueSignal;
     SignalConfig mAuthFvSignatureSignal;
+    bool mSignalTxBatching;
+    std::string mSignalRecordingFile;
+    std::string mFvCheckpointFile;
+    bool mEventDrivenProcessing;
+    FvmRole mEcuFunction;
+    std::string mGatewayParticipantConfigFile;
+    GroupFvBroadcastConfig mGroupFvBroadcast;
+    TimeServerEndpoints mRedundantTimeServers;
+    FvRequestRetryPolicy mFvRequestRetryPolicy;
+    FvDaemonConfig mFvDaemon;
+    CrIndicationExecutorConfig mCrIndicationExecutor;
 };
 
 inline bool operator==(FrameConfig const& A, FrameConfig const& B)
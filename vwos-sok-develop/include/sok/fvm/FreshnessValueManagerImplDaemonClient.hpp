@@ -0,0 +1,78 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FRESHNESS_VALUE_MANAGER_IMPL_DAEMON_CLIENT_HPP
+#define FRESHNESS_VALUE_MANAGER_IMPL_DAEMON_CLIENT_HPP
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "AFreshnessValueManagerImpl.hpp"
+#include "FvStatePage.hpp"
+#include "FvmDaemonIpc.hpp"
+#include "FvmExecutor.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief The FVM instance of a SecOC process on an ECU with an FVM daemon.
+ *
+ * Runs no FV synchronization and exchanges no signals: the FV of the plain authentic broadcast IDs is read from
+ * the FV state page of the daemon and answered locally, the session counter and challenge-response IDs are
+ * forwarded to the daemon which owns their state.
+ */
+class FreshnessValueManagerImplDaemonClient : public AFreshnessValueManagerImpl
+{
+public:
+    explicit FreshnessValueManagerImplDaemonClient(FvmDependencies dependencies);
+    ~FreshnessValueManagerImplDaemonClient();
+
+    /**
+     * @brief Nothing to run periodically, the FV state is kept by the daemon
+     *
+     * @return FvmErrorCode kSuccess if initialized, kNotInitialized otherwise
+     */
+    FvmErrorCode MainFunction() noexcept override;
+
+    FvmResult<FVContainer> GetRxFreshness(SokFreshnessValueId SecOCFreshnessValueID, const FVContainer &SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts) noexcept override;
+    FvmResult<FVContainer> GetTxFreshness(SokFreshnessValueId SecOCFreshnessValueID) noexcept override;
+    void VerificationStatusCallout(SecOC_VerificationStatusType verificationStatus) noexcept override;
+    void SPduTxConfirmation(SokFreshnessValueId SecOCFreshnessValueID) noexcept override;
+    FvmErrorCode TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID) override;
+    FvmErrorCode OfferCrRequest(SokFreshnessValueId SecOCFreshnessValueID, ChallengeReceivedIndicationCb const& cb) override;
+
+    /**
+     * @brief The FV state as published by the daemon
+     *
+     * @return FvStateRecord a consistent record of the FV state of the daemon, not valid before `Init()`
+     */
+    FvStateRecord GetFvState() const noexcept override;
+
+    bool serverOrParticipantInit() noexcept override;
+
+    std::vector<SignalConfig> serverOrParticipantOutgoingSignals() noexcept override;
+
+    void serverOrParticipantDeinit() noexcept override;
+
+protected:
+    bool registerToSignals() noexcept override;
+
+private:
+    bool isAnsweredLocally(SokFreshnessValueId SecOCFreshnessValueID) const;
+    FvmErrorCode forward(FvmIpcMessage const& request, FvmIpcMessage& response) noexcept;
+    void indicateChallenge(SokFreshnessValueId SecOCFreshnessValueID) noexcept;
+
+private:
+    FvDaemonConfig mDaemonConfig;
+    std::shared_ptr<FvStatePage> mDaemonFvStatePage;
+    std::unique_ptr<FvmDaemonClient> mDaemonClient;
+    // the application callbacks are not run on the receiver thread of the IPC, they may request a response
+    FvmExecutor mIndicationExecutor;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FRESHNESS_VALUE_MANAGER_IMPL_DAEMON_CLIENT_HPP
@@ -4,8 +4,15 @@
 #define FRESHNESS_VALUE_MANAGER_IMPL_PARTICIPANT_HPP
 
 #include "AFreshnessValueManagerImpl.hpp"
+#include "AuthenticFvResponder.hpp"
 #include "FreshnessValueStateManager.hpp"
+#include "FvDriftEstimator.hpp"
+#include "FvmExecutor.hpp"
+#include "FvmDiagnosticsDefinitions.hpp"
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <random>
 
 namespace sok
 {
@@ -16,6 +23,8 @@ class FreshnessValueManagerImplParticipant : public AFreshnessValueManagerImpl
 {  
 public:
     FreshnessValueManagerImplParticipant();
+    explicit FreshnessValueManagerImplParticipant(std::shared_ptr<ISignalManager> signalManager);
+    explicit FreshnessValueManagerImplParticipant(FvmDependencies dependencies);
     virtual ~FreshnessValueManagerImplParticipant() = default;
 
     /**
@@ -35,13 +44,55 @@ public:
      */
     bool serverOrParticipantInit() noexcept override;
 
+    /**
+     * @brief returns the authentic FV request signal, and the response signals of the downstream ECUs
+     *        in case the participant relays its authentic FV
+     * 
+     * @return std::vector<SignalConfig> the outgoing signals to be prepared at `Init()`
+     */
+    std::vector<SignalConfig> serverOrParticipantOutgoingSignals() noexcept override;
+
+    /**
+     * @brief stops the event driven processing of the received FV signals, a running processing completes first
+     * 
+     */
+    void serverOrParticipantDeinit() noexcept override;
+
+    /**
+     * @brief The authentic FV requests and their retries, the data of the FV request retry info
+     *        diagnostics parameter, may be called from any thread
+     * 
+     * @return FvmFvRequestRetryInfo the request counters
+     */
+    FvmFvRequestRetryInfo GetFvRequestRetryInfo() const;
+
 private:
+    /**
+     * @brief An additional SOK time server, challenged together with the server of the authenticated FV signals
+     * 
+     */
+    struct RedundantTimeServer {
+        TimeServerEndpointConfig config;
+        std::pair<std::vector<uint8_t>, std::vector<uint8_t>> authFvAndMac;
+    };
+
     void incomingAuthFvSignalsCb(std::string const& signal, std::vector<uint8_t> const& value);
+    void incomingRedundantAuthFvSignalsCb(size_t serverIndex, std::string const& signal, std::vector<uint8_t> const& value);
     void incomingUnAuthFvSignalsCb(std::string const& signal, std::vector<uint8_t> const& value);  
+    void incomingGroupFvSignalCb(std::string const& signal, std::vector<uint8_t> const& value);
     FvmErrorCode requestAnAuthenticFv();
     FvmErrorCode waitForAnAuthenticFv();
     FvmErrorCode processAnAuthenticFv();
     FvmErrorCode processAnUnauthenticFv();
+    FvmErrorCode processGroupFv();
+    bool verifyAnAuthenticFv(uint16_t keyId, std::pair<std::vector<uint8_t>, std::vector<uint8_t>>& authFvAndMac);
+    uint32_t nextRequestBackoffMs();
+    void adoptAuthenticFv(uint64_t fv);
+    void slewClock();
+    void postSignalProcessing();
+    void processSignalsOnExecutor();
+    void resetClockSlew();
+    FvmErrorCode relayAuthenticFvResponses();
 
     std::shared_ptr<FreshnessValueStateManager> mFvStateManager;
     uint32_t mTimeSinceAuthFvReq;
@@ -49,8 +100,47 @@ private:
     FVContainer mUnAuthFv;
     std::pair<std::vector<uint8_t>, std::vector<uint8_t>> mCrAuthFvAndMac;
     uint16_t mEcuKeyIdForFvDistribution;
+    std::string mAuthFvValueSignalName;
+    std::string mAuthFvSignatureSignalName;
+    std::string mUnauthFvSignalName;
+    // guarded by mRecFVMutex like the response of the primary server
+    std::vector<RedundantTimeServer> mRedundantTimeServers;
     std::mutex mRecFVMutex;
     std::mutex mRecUnauthFvMutex;
+    GroupFvBroadcastConfig mGroupFvBroadcast;
+    FVContainer mGroupFvMessage;
+    // the server session of the group FV broadcast and its latest accepted nonce counter, kept over Deinit()
+    bool mGroupSessionKnown;
+    uint32_t mGroupSession;
+    uint32_t mGroupNonceFloor;
+    std::mutex mRecGroupFvMutex;
+    // answers the challenges of the downstream ECUs with the authentic FV of this participant, null without clients
+    std::unique_ptr<AuthenticFvResponder> mRelay;
+    bool mNeedToRelayResponses;
+    FvRequestRetryPolicy mRetryPolicy;
+    // jitter only, spreads the retries of the participants, thus not taken from the CSM
+    std::minstd_rand mRetryRandom;
+    // the remaining delay of the pending retry, counted down in RequestFV
+    uint32_t mRequestBackoffMs;
+    mutable std::mutex mRetryInfoMutex;
+    FvmFvRequestRetryInfo mRetryInfo;
+    // the round trip of the authentic FV request, to estimate how old a received authentic FV is. mMinAuthFvRoundTrip
+    // is the shortest round trip short enough to be a sample of the transmission delay.
+    // mAuthFvResponseTime is stamped by the signal callbacks, guarded by mRecFVMutex
+    std::chrono::steady_clock::time_point mAuthFvRequestTime;
+    std::chrono::steady_clock::time_point mAuthFvResponseTime;
+    std::chrono::steady_clock::duration mMinAuthFvRoundTrip;
+    // the drift against the server's clock estimated from the unauthenticated FV broadcasts, slewed away gradually.
+    // mSlewAppliedUs is the correction applied to the local clock since the FV was last set
+    FvDriftEstimator mDriftEstimator;
+    double mSlewPpm;
+    double mSlewRemainderUs;
+    int64_t mSlewAppliedUs;
+    // serializes the state machine between the MainFunction and the executor
+    std::mutex mProcessingMutex;
+    // processes the received FV signals right away in event driven mode, null otherwise.
+    // Declared last, so that its thread is stopped before the members it uses are destroyed
+    std::unique_ptr<FvmExecutor> mExecutor;
 };
 
 } // namespace fvm
@@ -4,9 +4,11 @@
 #define FRESHNESS_VALUE_MANAGER_IMPL_SERVER_HPP
 
 #include "AFreshnessValueManagerImpl.hpp"
-#include <unordered_map>
-#include <regex>
-#include <mutex>
+#include "AuthenticFvResponder.hpp"
+#include "FvCheckpoint.hpp"
+#include "FvmDiagnosticsDefinitions.hpp"
+#include <vector>
+#include <memory>
 
 namespace sok
 {
@@ -17,6 +19,8 @@ class FreshnessValueManagerImplServer : public AFreshnessValueManagerImpl
 {
 public:
     FreshnessValueManagerImplServer();
+    explicit FreshnessValueManagerImplServer(std::shared_ptr<ISignalManager> signalManager);
+    explicit FreshnessValueManagerImplServer(FvmDependencies dependencies);
     ~FreshnessValueManagerImplServer() = default;
 
     /**
@@ -30,21 +34,41 @@ public:
 
     bool serverOrParticipantInit() noexcept override;
 
+    std::vector<SignalConfig> serverOrParticipantOutgoingSignals() noexcept override;
+
+    /**
+     * @brief Health of the authentic FV distribution per participant, the data of the client health list
+     *        diagnostics parameter, may be called from any thread
+     * 
+     * @return std::vector<FvmClientHealthRecord> a record per configured participant
+     */
+    std::vector<FvmClientHealthRecord> GetClientHealth() const;
+
 #ifndef UNIT_TESTS
 private:
 #endif // UNIT_TESTS
 
-    void incomingAuthFvChallengeSignalsCb(std::string const& signal, std::vector<uint8_t> const& challenge);
     FvmErrorCode unauthenticatedBroadcast();
     FvmErrorCode sendAuthenticFvResponses();
+    FvmErrorCode groupAuthenticatedBroadcast();
+    void updateChallengeClock();
+    void restoreFvCheckpoint();
+    bool isFvReservationDue() const;
+    void storeFvCheckpoint();
 
 private:
-    std::mutex mChallengesMutex;
     std::atomic_bool mNeedToSendAuthFvResponses;
     std::atomic_bool mNeedToBroadcastFv;
-    std::unordered_map<std::string, std::vector<uint8_t>> mResponsePendingChallenges;
-    std::unordered_map<std::string, uint16_t> mClientNameToKeyId;
-    FmServerClientsConfigMap mClientConfigMap;
+    uint64_t mLastFvBroadcastMs;
+    std::unique_ptr<AuthenticFvResponder> mResponder;
+    GroupFvBroadcastConfig mGroupFvBroadcast;
+    std::atomic_bool mNeedToBroadcastGroupFv;
+    uint64_t mLastGroupBroadcastMs;
+    uint64_t mGroupNonce;
+    std::unique_ptr<FvCheckpoint> mFvCheckpoint;
+    uint64_t mLastFvCheckpointMs;
+    // the FV reservation last stored to the checkpoint, the FV stays below it
+    uint64_t mFvReservation;
 };
 
 } // namespace fvm
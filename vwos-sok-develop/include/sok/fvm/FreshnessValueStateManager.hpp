@@ -4,7 +4,8 @@
 #define FRESHNESS_VALUE_STATE_MANAGER_HPP
 
 #include "AFreshnessValueManagerImpl.hpp"
-#include <unordered_map>
+#include <array>
+#include <atomic>
 
 namespace sok
 {
@@ -18,16 +19,31 @@ enum class FreshnessValueState : uint8_t {
     FVInProgress, 
     ProcessFV, 
     ProcessAnauthFV,
+    ProcessGroupFV,
     Idle
 };
 
+constexpr size_t FRESHNESS_VALUE_STATE_COUNT = static_cast<size_t>(FreshnessValueState::Idle) + 1U;
+
+/**
+ * @brief The received FV signals the state machine reacts to, see the transition table in FreshnessValueStateManager.cpp
+ * 
+ */
+enum class FreshnessValueEvent : uint8_t {
+    AuthenticFvReceived,
+    UnauthenticFvReceived,
+    GroupFvReceived
+};
+
+constexpr size_t FRESHNESS_VALUE_EVENT_COUNT = static_cast<size_t>(FreshnessValueEvent::GroupFvReceived) + 1U;
+
 class FreshnessValueStateManager {
 public:
     FreshnessValueStateManager();
     virtual ~FreshnessValueStateManager() = default;
 
     /**
-     * @brief enter the state, run the state action function
+     * @brief enter the state, run the state action function, must not be called concurrently
      * 
      * @return FvmErrorCode
      */
@@ -36,9 +52,14 @@ public:
     /**
      * @brief transit between states, assign the new state to mCurrentFvState
      * 
+     * Called by a state action, the transition is a compare and swap from the state the action is processing:
+     * if a received signal moved the state in the meantime, the transition is dropped and the action of the
+     * new state is run by the next enter(). Outside of an action, e.g. at init, the state is set unconditionally.
+     * 
      * @param state FreshnessValueState enum describing the different states 
+     * @return true if the state was changed, false if the state is unregistered or changed by a received signal
      */
-    void transiteTo(FreshnessValueState const state);
+    bool transiteTo(FreshnessValueState const state);
 
     /**
      * @brief register a new state
@@ -47,6 +68,13 @@ public:
      * @param action the state action function, will be called by enter()
      */
     void registerState(FreshnessValueState const state, StateAction const& action);
+
+    /**
+     * @brief the current state, may be called from any thread
+     * 
+     * @return FreshnessValueState the current state, RequestFV if no state was entered yet
+     */
+    FreshnessValueState currentState() const;
     
     /**
      * @brief react to an incoming authentic fv response according to the current state
@@ -58,9 +86,24 @@ public:
      */
     void reactToUnauthenticFVRes();
 
+    /**
+     * @brief react to an incoming group authenticated fv broadcast according to the current state
+     */
+    void reactToGroupFVRes();
+
 private:
-    std::unordered_map<FreshnessValueState, StateAction> mFvActions;
-    std::shared_ptr<FreshnessValueState> mCurrentFvState;
+    /**
+     * @brief take the transition of the event from the current state, a single compare and swap so that a
+     *        transition of another thread in the meantime is never overwritten
+     * 
+     */
+    void react(FreshnessValueEvent const event);
+
+    // the actions are registered at init and called in place, registerState() must not race with enter()
+    std::array<StateAction, FRESHNESS_VALUE_STATE_COUNT> mFvActions;
+    std::atomic<FreshnessValueState> mCurrentFvState;
+    // the state whose action enter() is running, only accessed by the thread calling enter()
+    FreshnessValueState mEnteredFvState;
 };
 
 } // namespace fvm
@@ -0,0 +1,137 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FV_CHECKPOINT_HPP
+#define FV_CHECKPOINT_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "FreshnessValueManagerError.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+struct FvCheckpointFile;
+
+/**
+ * @brief A point in time of the checkpoint clock
+ *
+ */
+struct FvCheckpointTime {
+    uint64_t bootId;    // identifies the boot of the ECU, 0 if unknown
+    uint64_t timeMs;    // time since boot in milliseconds, including suspend
+};
+
+/**
+ * @brief The FV of the SOK time server as persisted in the checkpoint
+ *
+ */
+struct FvCheckpointState {
+    uint64_t fv;            // the current FV
+    uint64_t reservedFv;    // the server uses no FV at or above it, until a higher reservation is stored
+    uint32_t phaseMs;       // the time elapsed since the FV was incremented, below SOK_FM_TIME_INCREMENT_PERIOD_MS
+};
+
+/**
+ * @brief Persists the FV of the SOK time server in a memory mapped file, so that a restarted
+ *        server continues the FV monotonically instead of starting from a random FV.
+ *
+ * The file holds two records which are written alternately, each with a sequence number and a
+ * checksum, so that a write interrupted by a crash leaves the previous record intact.
+ * A process crash keeps the page cache, so within a boot the latest record is exact. A power loss
+ * may lose the records which were not synced, thus a new reservation is synced by a background thread,
+ * the server renews its reservation early enough to not reach an FV which is not covered by a synced one.
+ * File layout (native endianness, the file is local to the ECU):
+ *  header: magic "SOKFVCP\0" (8 bytes), format version (uint32), padding (uint32)
+ *  record A, record B: sequence, FV, reserved FV, phase ms, boot id, time ms, checksum (uint64 each)
+ */
+class FvCheckpoint
+{
+public:
+    FvCheckpoint();
+    ~FvCheckpoint();
+
+    FvCheckpoint(FvCheckpoint const&) = delete;
+    FvCheckpoint& operator=(FvCheckpoint const&) = delete;
+
+    /**
+     * @brief Map the checkpoint file, the file is created if it does not exist
+     *
+     * @param path the path of the checkpoint file
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Open(std::string const& path);
+
+    /**
+     * @brief Unmap the checkpoint file after syncing it, the written records are kept
+     *
+     */
+    void Close();
+
+    /**
+     * @brief Write the FV to the older of the two records without blocking on the storage. A reservation
+     *        which differs from the synced one is synced by the background thread, retried until it succeeds,
+     *        the file is synced asynchronously otherwise
+     *
+     * @param state the current FV, its reservation and its phase
+     * @param now the current time of the checkpoint clock
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Store(FvCheckpointState const& state, FvCheckpointTime const& now);
+
+    /**
+     * @brief Sync the file including the latest record before returning, blocks on the storage
+     *
+     * @return FvmErrorCode kSuccess upon success, error code on failure, then the latest reservation is not durable
+     */
+    FvmErrorCode Sync();
+
+    /**
+     * @brief The reservation of the latest synced record, may be called from any thread
+     *
+     */
+    uint64_t DurableReservedFv() const;
+
+    /**
+     * @brief Calculate the FV to continue from, out of the latest valid record.
+     *        Within the same boot the FV and its phase are extrapolated by the time elapsed since the record
+     *        was written, otherwise the server continues from the reserved FV, which survived a power loss,
+     *        and the stored phase.
+     *        Either way the result is not lower than any FV the previous server instance could have used.
+     *
+     * @param now the current time of the checkpoint clock
+     * @return FvmResult<FvCheckpointState> the FV and phase to continue from and the stored reservation,
+     *         kGeneralError if there is no valid record
+     */
+    FvmResult<FvCheckpointState> Restore(FvCheckpointTime const& now) const;
+
+    /**
+     * @brief The current time of the checkpoint clock
+     *
+     */
+    static FvCheckpointTime Now();
+
+private:
+    void syncLoop() noexcept;
+
+private:
+    FvCheckpointFile* mFile;
+    uint64_t mSequence;
+    // the reservation of the latest record, and of the latest synced one
+    uint64_t mReservedFv;
+    std::atomic<uint64_t> mDurableReservedFv;
+    std::mutex mSyncMutex;
+    std::condition_variable mSyncCv;
+    bool mStopSync;
+    std::thread mSyncThread;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FV_CHECKPOINT_HPP
@@ -0,0 +1,88 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FV_DRIFT_ESTIMATOR_HPP
+#define FV_DRIFT_ESTIMATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief Estimates the drift of a participant's clock against the clock of the SOK time server by a
+ *        least squares line over the latest offsets measured from the unauthenticated FV broadcasts.
+ *
+ * The offsets are those of the free running clock, i.e. without the slewing applied by the participant,
+ * so that the slewing does not feed back into the estimate.
+ */
+class FvDriftEstimator
+{
+public:
+    /**
+     * @param window the number of latest samples the estimate is based on
+     * @param minSamples the number of samples required for a valid estimate, at least 2
+     */
+    FvDriftEstimator(size_t window, size_t minSamples);
+
+    /**
+     * @brief Add a measured offset
+     *
+     * @param localTimeMs the local time of the measurement
+     * @param offsetUs the server's clock minus the free running local clock, in microseconds
+     */
+    void AddSample(uint64_t localTimeMs, int64_t offsetUs);
+
+    /**
+     * @brief Drop all samples, to be called when the local clock was set
+     *
+     */
+    void Reset();
+
+    /**
+     * @brief Whether there are enough samples for an estimate
+     *
+     */
+    bool IsValid() const;
+
+    /**
+     * @brief The drift of the local clock, positive if the server's clock runs faster
+     *
+     * @return double the drift in ppm, 0 if the estimate is not valid
+     */
+    double DriftPpm() const;
+
+    /**
+     * @brief The offset of the free running local clock predicted by the estimate
+     *
+     * @param localTimeMs the local time to predict the offset for
+     * @return double the offset in microseconds, 0 if the estimate is not valid
+     */
+    double OffsetUs(uint64_t localTimeMs) const;
+
+private:
+    struct Sample {
+        uint64_t localTimeMs;
+        int64_t offsetUs;
+    };
+
+    void fit();
+
+    size_t mWindow;
+    size_t mMinSamples;
+    // ring buffer of the latest samples, mNext is the slot of the next sample
+    std::vector<Sample> mSamples;
+    size_t mNext;
+    // the fitted line, offset = mOffsetUs + mSlopeUsPerMs * (localTimeMs - mTimeOriginMs)
+    uint64_t mTimeOriginMs;
+    double mOffsetUs;
+    double mSlopeUsPerMs;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FV_DRIFT_ESTIMATOR_HPP
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FV_STATE_PAGE_HPP
+#define FV_STATE_PAGE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "FvStateSeqlock.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+struct FvStatePageLayout;
+
+/**
+ * @brief The FV state of the FVM daemon of an ECU, shared with the SecOC processes of the ECU.
+ *
+ * The daemon maps the POSIX shared memory page writable and mirrors every FV state record it publishes
+ * into it, the SecOC processes map it read-only and load the record without locking (sequence lock).
+ * Each record carries the time of its publication. A loaded record is advanced by the time elapsed since,
+ * and loaded as not valid if the daemon did not refresh it within one FV increment period plus
+ * `SOK_FM_TIME_JITTER_MAX_MS`, e.g.: after the daemon died.
+ */
+class FvStatePage
+{
+public:
+    /**
+     * @brief Create the page, or take over the page of a previous daemon. For the FVM daemon only
+     *
+     * @param name the name of the shared memory page, e.g.: "/sok_fm_fv_state"
+     * @return std::shared_ptr<FvStatePage> the writable page, nullptr on failure
+     */
+    static std::shared_ptr<FvStatePage> Create(std::string const& name);
+
+    /**
+     * @brief Open the page of the FVM daemon read-only
+     *
+     * @param name the name of the shared memory page
+     * @return std::shared_ptr<FvStatePage> the read-only page, nullptr if the daemon did not set it up
+     */
+    static std::shared_ptr<FvStatePage> Open(std::string const& name);
+
+    ~FvStatePage();
+
+    FvStatePage(FvStatePage const&) = delete;
+    FvStatePage& operator=(FvStatePage const&) = delete;
+
+    /**
+     * @brief Publish a new record to the SecOC processes, may only be called on a page created by `Create()`
+     *
+     * @param record the record to publish
+     */
+    void Publish(FvStateRecord const& record);
+
+    /**
+     * @brief Load the latest record, may be called from any thread
+     *
+     * @return FvStateRecord the record as published by the daemon advanced to now, not valid if the daemon stopped publishing
+     */
+    FvStateRecord Load() const;
+
+private:
+    FvStatePage(std::string const& name, FvStatePageLayout* layout, bool writable);
+
+    std::string mName;
+    FvStatePageLayout* mLayout;
+    bool mWritable;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FV_STATE_PAGE_HPP
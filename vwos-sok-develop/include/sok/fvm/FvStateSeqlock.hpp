@@ -0,0 +1,73 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FV_STATE_SEQLOCK_HPP
+#define FV_STATE_SEQLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief The FV of an FVM instance together with the state it is valid in, as seen by the SecOC
+ *
+ */
+struct FvStateRecord {
+    uint64_t fv;
+    bool valid;
+    uint64_t timeSinceInit;
+    // the time since the last FV increment in milliseconds
+    uint32_t subTick;
+    // incremented whenever the FV is set instead of incremented, e.g. by a resync or Deinit()
+    uint32_t epoch;
+};
+
+/**
+ * @brief Publishes the FV state record of the MainFunction to the SecOC threads.
+ *
+ * Readers load a consistent record without locking (sequence lock) and never block the MainFunction.
+ * The rare writers are serialized by a mutex, so that e.g. a Deinit() may publish from another thread.
+ */
+class FvStateSeqlock
+{
+public:
+    FvStateSeqlock();
+
+    FvStateSeqlock(FvStateSeqlock const&) = delete;
+    FvStateSeqlock& operator=(FvStateSeqlock const&) = delete;
+
+    /**
+     * @brief Publish a new record
+     *
+     * @param record the record to publish
+     * @param stampMs the time of the publication, consistent with the record, 0 if not used
+     */
+    void Publish(FvStateRecord const& record, uint64_t stampMs = 0U);
+
+    /**
+     * @brief Load the latest record, may be called from any thread
+     *
+     * @param stampMs set to the time the record was published with, if not nullptr
+     * @return FvStateRecord a record as published by a single Publish()
+     */
+    FvStateRecord Load(uint64_t* stampMs = nullptr) const;
+
+private:
+    std::mutex mWriterMutex;
+    std::atomic<uint32_t> mSequence;
+    std::atomic<uint64_t> mFv;
+    std::atomic<bool> mValid;
+    std::atomic<uint64_t> mTimeSinceInit;
+    std::atomic<uint32_t> mSubTick;
+    std::atomic<uint32_t> mEpoch;
+    std::atomic<uint64_t> mStampMs;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FV_STATE_SEQLOCK_HPP
@@ -34,9 +34,12 @@ private:
     bool fetchAuthenticBroadcastConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
     bool fetchChallengeResponseConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
     bool fetchFvDistributionSignalConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
+    bool fetchRedundantTimeServersConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
+    bool fetchFvRequestRetryPolicyConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
     bool fetchKeyConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
     bool fetchClientsConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const;
     SokFreshnessType convertStringFreshnessTypeToEnum(std::string const& freshnessType) const;
+    FvmRole convertStringEcuFunctionToEnum(std::string const& ecuFunction) const;
     bool fetchSignalConfig(rapidjson::GenericObject<true, rapidjson::Value> const& object, SignalConfig& signalConfig) const;
 private:
     std::shared_ptr<rapidjson::SchemaDocument> mSchema;
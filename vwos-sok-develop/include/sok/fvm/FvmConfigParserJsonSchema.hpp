@@ -19,6 +19,12 @@ struct SchemaGeneralAttributes {
     const std::string NETWORK_INTERFACE = "network_interface";
     const std::string ECU_NAME = "ecu_name";
     const std::string ECU_KEY_ID_AUTH_FV = "ecu_key_id_auth_fv";
+    const std::string SIGNAL_TX_BATCHING = "signal_tx_batching";
+    const std::string SIGNAL_RECORDING_FILE = "signal_recording_file";
+    const std::string FV_CHECKPOINT_FILE = "fv_checkpoint_file";
+    const std::string EVENT_DRIVEN_PROCESSING = "event_driven_processing";
+    const std::string ECU_FUNCTION = "ecu_function";
+    const std::string GATEWAY_PARTICIPANT_CONFIG_FILE = "gateway_participant_config_file";
 };
 
 struct SchemaAuthBroadcastConfig {
@@ -47,6 +53,50 @@ constexpr char ENUM_FRESHNESS_TYPE_FV_SESSION_RECEIVER[] = "FV_SESSION_RECEIVER"
 constexpr char ENUM_FRESHNESS_TYPE_CHALLENGE[] = "CHALLENGE";
 constexpr char ENUM_FRESHNESS_TYPE_RESPONSE[] = "RESPONSE";
 
+constexpr char ENUM_ECU_FUNCTION_SERVER[] = "SERVER";
+constexpr char ENUM_ECU_FUNCTION_PARTICIPANT[] = "PARTICIPANT";
+constexpr char ENUM_ECU_FUNCTION_GATEWAY[] = "GATEWAY";
+
+struct SchemaGroupFvBroadcastConfig {
+    const std::string OBJECT_NAME = "group_fv_broadcast_config";
+    const std::string KEY_ID = "key_id";
+    const std::string PERIOD_MS = "period_ms";
+    const std::string SIGNAL = "signal";
+};
+
+struct SchemaFvRequestRetryPolicy {
+    const std::string OBJECT_NAME = "fv_request_retry_policy";
+    const std::string BASE_DELAY_MS = "base_delay_ms";
+    const std::string MAX_DELAY_MS = "max_delay_ms";
+};
+
+struct SchemaFvDaemonConfig {
+    const std::string OBJECT_NAME = "fv_daemon_config";
+    const std::string MODE = "mode";
+    const std::string PAGE_NAME = "page_name";
+    const std::string SOCKET_PATH = "socket_path";
+    const std::string CLIENT_UID = "client_uid";
+    const std::string CLIENT_GID = "client_gid";
+};
+
+struct SchemaCrIndicationExecutorConfig {
+    const std::string OBJECT_NAME = "cr_indication_executor";
+    const std::string THREAD_COUNT = "thread_count";
+    const std::string QUEUE_DEPTH = "queue_depth";
+};
+
+constexpr char ENUM_FV_DAEMON_MODE_DAEMON[] = "DAEMON";
+constexpr char ENUM_FV_DAEMON_MODE_CLIENT[] = "CLIENT";
+
+struct SchemaRedundantTimeServersConfig {
+    const std::string OBJECT_NAME = "redundant_time_servers";
+    const std::string SERVER_ECU_NAME = "server_ecu_name";
+    const std::string KEY_ID = "key_id";
+    const std::string CHALLENGE_SIGNAL = "challenge_signal";
+    const std::string VALUE_SIGNAL = "response_value_signal";
+    const std::string SIGNATURE_SIGNAL = "response_signature_signal";
+};
+
 struct SchemaKeyConfig {
     const std::string OBJECT_NAME = "key_config";
     const std::string FV_ID = "fv_id";
@@ -89,6 +139,11 @@ struct SchemaSignalConfig {
 SchemaGeneralAttributes const GENERAL_ATTRIBUTES;
 SchemaAuthBroadcastConfig const AUTH_BROADCAST_CONFIG_ATTRIBUTES;
 SchemaChallengeResponseConfig const CHALLENGE_RESPONSE_CONFIG_ATTRIBUTES;
+SchemaGroupFvBroadcastConfig const GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES;
+SchemaRedundantTimeServersConfig const REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES;
+SchemaFvRequestRetryPolicy const FV_REQUEST_RETRY_POLICY_ATTRIBUTES;
+SchemaFvDaemonConfig const FV_DAEMON_CONFIG_ATTRIBUTES;
+SchemaCrIndicationExecutorConfig const CR_INDICATION_EXECUTOR_CONFIG_ATTRIBUTES;
 SchemaKeyConfig const KEY_CONFIG_ATTRIBUTES;
 SchemaClientsConfig const CLIENTS_CONFIG_ATTRIBUTES;
 SchemaFrameConfig const FRAME_CONFIG_ATTRIBUTES;
@@ -103,6 +158,12 @@ constexpr char FVM_CONFIG_SCHEMA[] =
                         "\"network_interface\":{\"type\":\"string\"},"
                         "\"ecu_name\":{\"type\":\"string\"},"
                         "\"ecu_key_id_auth_fv\":{\"type\":\"integer\", \"minimum\": 0, \"maximum\": 65535},"
+                        "\"signal_tx_batching\":{\"type\":\"boolean\"},"
+                        "\"signal_recording_file\":{\"type\":\"string\"},"
+                        "\"fv_checkpoint_file\":{\"type\":\"string\"},"
+                        "\"event_driven_processing\":{\"type\":\"boolean\"},"
+                        "\"ecu_function\":{\"enum\":[\"SERVER\", \"PARTICIPANT\", \"GATEWAY\"]},"
+                        "\"gateway_participant_config_file\":{\"type\":\"string\"},"
                         "\"auth_br_config\":{\"type\":\"array\","
                             "\"items\":{"
                                 "\"additionalProperties\": false,"
@@ -130,6 +191,55 @@ constexpr char FVM_CONFIG_SCHEMA[] =
                         "\"authenticated_fv_value_signal_config\":{ \"$ref\": \"#/$defs/complete_signal_config\"},"
                         "\"authenticated_fv_signature_signal_config\":{ \"$ref\": \"#/$defs/complete_signal_config\"},"
                         "\"authenticated_fv_value_challenge_config\":{ \"$ref\": \"#/$defs/complete_signal_config\"},"
+                        "\"group_fv_broadcast_config\":{\"type\":\"object\","
+                            "\"additionalProperties\": false,"
+                            "\"properties\":{"
+                                "\"key_id\":{\"type\":\"integer\", \"minimum\": 0, \"maximum\": 65535},"
+                                "\"period_ms\":{\"type\":\"integer\", \"minimum\": 1},"
+                                "\"signal\":{ \"$ref\": \"#/$defs/complete_signal_config\" }"
+                            "},"
+                            "\"required\": [\"key_id\", \"period_ms\", \"signal\"]"
+                        "},"
+                        "\"fv_request_retry_policy\":{\"type\":\"object\","
+                            "\"additionalProperties\": false,"
+                            "\"properties\":{"
+                                "\"base_delay_ms\":{\"type\":\"integer\", \"minimum\": 1},"
+                                "\"max_delay_ms\":{\"type\":\"integer\", \"minimum\": 1}"
+                            "},"
+                            "\"required\": [\"base_delay_ms\", \"max_delay_ms\"]"
+                        "},"
+                        "\"fv_daemon_config\":{\"type\":\"object\","
+                            "\"additionalProperties\": false,"
+                            "\"properties\":{"
+                                "\"mode\":{\"enum\":[\"DAEMON\", \"CLIENT\"]},"
+                                "\"page_name\":{\"type\":\"string\", \"pattern\": \"^/[^/]+$\"},"
+                                "\"socket_path\":{\"type\":\"string\", \"minLength\": 1},"
+                                "\"client_uid\":{\"type\":\"integer\", \"minimum\": 0, \"maximum\": 4294967294},"
+                                "\"client_gid\":{\"type\":\"integer\", \"minimum\": 0, \"maximum\": 4294967294}"
+                            "},"
+                            "\"required\": [\"mode\", \"page_name\", \"socket_path\"]"
+                        "},"
+                        "\"cr_indication_executor\":{\"type\":\"object\","
+                            "\"additionalProperties\": false,"
+                            "\"properties\":{"
+                                "\"thread_count\":{\"type\":\"integer\", \"minimum\": 1, \"maximum\": 16},"
+                                "\"queue_depth\":{\"type\":\"integer\", \"minimum\": 1, \"maximum\": 1024}"
+                            "},"
+                            "\"required\": [\"thread_count\", \"queue_depth\"]"
+                        "},"
+                        "\"redundant_time_servers\":{\"type\":\"array\","
+                            "\"items\":{"
+                                "\"additionalProperties\": false,"
+                                "\"properties\":{"
+                                    "\"server_ecu_name\":{\"type\":\"string\"},"
+                                    "\"key_id\":{\"type\":\"integer\", \"minimum\": 0, \"maximum\": 65535},"
+                                    "\"challenge_signal\":{ \"$ref\": \"#/$defs/complete_signal_config\"},"
+                                    "\"response_value_signal\":{ \"$ref\": \"#/$defs/complete_signal_config\"},"
+                                    "\"response_signature_signal\":{ \"$ref\": \"#/$defs/complete_signal_config\"}"
+                                "},"
+                                "\"required\": [\"server_ecu_name\", \"key_id\", \"challenge_signal\", \"response_value_signal\", \"response_signature_signal\"]"
+                            "}"
+                        "},"
                         "\"key_config\":{\"type\":\"array\","
                             "\"items\":{"
                                 "\"additionalProperties\": false,"
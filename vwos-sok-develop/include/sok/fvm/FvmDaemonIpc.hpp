@@ -0,0 +1,191 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FVM_DAEMON_IPC_HPP
+#define FVM_DAEMON_IPC_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <sys/types.h>
+#include "FreshnessValueManagerDefinitions.hpp"
+#include "FreshnessValueManagerError.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+constexpr uint8_t FVM_IPC_MAX_DATA_LENGTH = 32U;
+
+/**
+ * @brief The types of the messages between the FVM daemon and the SecOC processes
+ *
+ */
+enum class FvmIpcMessageType : uint8_t {
+    kGetRxFreshness = 0,
+    kGetTxFreshness,
+    kVerificationStatus,
+    kTxConfirmation,
+    kTriggerCrRequest,
+    kOfferCrRequest,
+    // the answer of the daemon to a request of the same sequence number
+    kResponse,
+    // sent by the daemon, a challenge arrived for an FV ID offered by the SecOC process
+    kChallengeIndication
+};
+
+/**
+ * @brief A message between the FVM daemon and a SecOC process, sent as a single datagram.
+ *        The data holds the truncated FV of a request or the FV of a response
+ *
+ */
+struct FvmIpcMessage {
+    FvmIpcMessageType type;
+    FvmErrorCode result;
+    uint8_t verificationSucceeded;
+    uint8_t length;
+    uint16_t authVerifyAttempts;
+    SokFreshnessValueId fvId;
+    uint32_t sequence;
+    uint8_t data[FVM_IPC_MAX_DATA_LENGTH];
+};
+
+/**
+ * @brief The IPC endpoint of the FVM daemon, serves the requests of the SecOC processes of the ECU
+ *        on a local seqpacket socket.
+ *
+ * The requests are handled one after the other on the thread of the server, the handler fills in the response.
+ * Only the processes of root, the configured client user and the configured client group are served.
+ */
+class FvmDaemonServer
+{
+public:
+    using ConnectionId = uint64_t;
+    using RequestHandler = std::function<void(ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response)>;
+
+    /**
+     * @brief Construct the IPC endpoint of the FVM daemon
+     *
+     * @param socketPath the path of the socket
+     * @param clientUid the user ID of the SecOC processes, `FV_DAEMON_OWN_ID` for the user of the daemon
+     * @param clientGid the group ID of the SecOC processes, `FV_DAEMON_OWN_ID` for the group of the daemon
+     * @param handler called for every request on the thread of the server
+     */
+    FvmDaemonServer(std::string const& socketPath, int64_t clientUid, int64_t clientGid, RequestHandler handler);
+    ~FvmDaemonServer();
+
+    FvmDaemonServer(FvmDaemonServer const&) = delete;
+    FvmDaemonServer& operator=(FvmDaemonServer const&) = delete;
+
+    /**
+     * @brief Bind the socket and start serving, a stale socket of a previous daemon is replaced
+     *
+     * @return true on success or if already started
+     */
+    bool Start() noexcept;
+
+    /**
+     * @brief Stop serving and close all connections
+     *
+     */
+    void Stop() noexcept;
+
+    /**
+     * @brief Indicate an incoming challenge to a SecOC process, may be called from any thread
+     *
+     * @param connection the connection of the SecOC process which offered the FV ID
+     * @param fvId the freshness value ID the challenge arrived for
+     * @return true if the indication was sent
+     */
+    bool SendIndication(ConnectionId connection, SokFreshnessValueId fvId) noexcept;
+
+    /**
+     * @brief Claim an FV ID for a connection, the claim is released when the connection closes
+     *
+     * @param connection the connection of the SecOC process which offers the FV ID
+     * @param fvId the freshness value ID
+     * @return true if the FV ID was not claimed by another connection
+     */
+    bool ClaimFvId(ConnectionId connection, SokFreshnessValueId fvId) noexcept;
+
+private:
+    void serve() noexcept;
+    bool isPeerAllowed(int fd) const noexcept;
+    void closeConnection(ConnectionId connection) noexcept;
+
+    std::string mSocketPath;
+    uid_t mClientUid;
+    gid_t mClientGid;
+    RequestHandler mHandler;
+    int mListenFd;
+    std::atomic_bool mRunning;
+    std::thread mThread;
+    std::mutex mConnectionsMutex;
+    std::unordered_map<ConnectionId, int> mConnections;
+    std::unordered_map<SokFreshnessValueId, ConnectionId> mFvIdClaims;
+    ConnectionId mNextConnectionId;
+};
+
+/**
+ * @brief The IPC endpoint of a SecOC process towards the FVM daemon of the ECU
+ *
+ */
+class FvmDaemonClient
+{
+public:
+    explicit FvmDaemonClient(std::string const& socketPath);
+    ~FvmDaemonClient();
+
+    FvmDaemonClient(FvmDaemonClient const&) = delete;
+    FvmDaemonClient& operator=(FvmDaemonClient const&) = delete;
+
+    /**
+     * @brief Connect to the FVM daemon
+     *
+     * @param indicationCb called on the receiver thread of the client for every challenge indication of the daemon,
+     *                    must not wait for a request since the responses arrive on the same thread
+     * @return true on success or if already connected
+     */
+    bool Connect(ChallengeReceivedIndicationCb const& indicationCb) noexcept;
+
+    /**
+     * @brief Disconnect from the FVM daemon
+     *
+     */
+    void Disconnect() noexcept;
+
+    /**
+     * @brief Send a request and wait up to `SOK_FM_DAEMON_IPC_TIMEOUT_MS` for its response, may be called from any thread
+     *
+     * @param request the request, its sequence number is set by the client
+     * @param response the response of the daemon
+     * @return FvmErrorCode kSuccess if a response arrived, error code otherwise
+     */
+    FvmErrorCode Request(FvmIpcMessage request, FvmIpcMessage& response) noexcept;
+
+private:
+    void receive() noexcept;
+
+    std::string mSocketPath;
+    int mFd;
+    std::atomic_bool mRunning;
+    std::thread mReceiverThread;
+    ChallengeReceivedIndicationCb mIndicationCb;
+    // one request at a time, the SecOC calls are short and the daemon serves them in order anyway
+    std::mutex mRequestMutex;
+    std::mutex mResponseMutex;
+    std::condition_variable mResponseCv;
+    uint32_t mSequence;
+    bool mResponseReceived;
+    FvmIpcMessage mResponse;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FVM_DAEMON_IPC_HPP
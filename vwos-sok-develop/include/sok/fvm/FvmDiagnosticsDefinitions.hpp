@@ -4,6 +4,7 @@
 #define FVM_DIAGNOSTICS_DEFINITIONS_HPP
 
 #include <cstdint>
+#include <string>
 
 namespace sok
 {
@@ -16,7 +17,10 @@ enum class FvmDiagnosticsParameter : uint16_t {
     kGeneralInfo = 0x0190U,
     kTimeInfo = 0x0191U,
     kFreshnessInfo = 0x0192U,
-    kMissingKeyList = 0x0194U
+    kClientHealthList = 0x0193U,
+    kMissingKeyList = 0x0194U,
+    kFvRequestRetryInfo = 0x0195U,
+    kCrIndicationInfo = 0x0196U
 };
 
 enum class FvmFunctionActivateDeactivateCommand : uint8_t {
@@ -29,6 +33,42 @@ enum class FvmSokEcuFunction : uint8_t {
     kFvmVwSokParticipant = 1U
 };
 
+/**
+ * @brief Health of the authentic FV distribution to a single participant, kept by the SOK time server.
+ *        Times are in milliseconds since the initialization of the server and are valid once the
+ *        corresponding counter is non-zero.
+ */
+struct FvmClientHealthRecord {
+    std::string ecuName;
+    uint64_t lastChallengeTimeMs;
+    uint64_t lastResponseTimeMs;
+    uint32_t lastResponseLatencyMs;     // from the arrival of the answered challenge to its response
+    uint32_t maxResponseLatencyMs;
+    uint32_t meanChallengeIntervalMs;   // moving average, 0 until the second challenge
+    uint32_t challenges;
+    uint32_t responses;
+    uint32_t droppedChallenges;         // expired or above the challenge rate limit
+    uint32_t macFailures;
+};
+
+/**
+ * @brief The authentic FV requests of a participant and their retries, see `FvRequestRetryPolicy`
+ */
+struct FvmFvRequestRetryInfo {
+    uint32_t requests;              // challenges sent
+    uint32_t timeouts;              // challenges left unanswered
+    uint32_t consecutiveRetries;    // timeouts since the last authentic FV, reset on its reception
+    uint32_t lastBackoffMs;         // the delay of the latest retry after the timeout of its predecessor
+};
+
+/**
+ * @brief The challenges indicated to the application, see `CrIndicationExecutorConfig`
+ */
+struct FvmCrIndicationInfo {
+    uint32_t indications;           // challenges handed to the callbacks of the application
+    uint32_t queueOverflows;        // challenges dropped because the queue of the executor was full
+};
+
 } // namespace fvm
 } // namespace sok
 
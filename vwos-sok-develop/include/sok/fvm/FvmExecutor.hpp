@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FVM_EXECUTOR_HPP
+#define FVM_EXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief Runs the work posted by the signal callbacks on its worker threads, in the order of posting.
+ *        With a single worker thread a task also completes before the next one starts.
+ *
+ * The queue is bounded, posting never blocks the signal thread: a task which does not fit is rejected
+ * and left to the caller, e.g. to the next MainFunction.
+ */
+class FvmExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param capacity the number of tasks which may wait for a worker thread
+     * @param threadCount the number of worker threads
+     */
+    explicit FvmExecutor(size_t capacity, size_t threadCount = 1U);
+    ~FvmExecutor();
+
+    FvmExecutor(FvmExecutor const&) = delete;
+    FvmExecutor& operator=(FvmExecutor const&) = delete;
+
+    /**
+     * @brief Start the worker threads
+     *
+     * @return true upon success or if already running, false otherwise
+     */
+    bool Start();
+
+    /**
+     * @brief Stop the worker threads after their running tasks, the waiting tasks are dropped.
+     *        Must not be called by a task
+     *
+     */
+    void Stop();
+
+    /**
+     * @brief Queue a task for the worker threads, may be called from any thread
+     *
+     * @param task the task to run
+     * @return true if queued, false if the executor is not running or its queue is full
+     */
+    bool Post(Task task);
+
+    /**
+     * @brief The number of tasks rejected because the queue was full
+     *
+     */
+    uint64_t GetRejectedTasks() const { return mRejectedTasks; }
+
+private:
+    void run();
+
+    size_t mCapacity;
+    size_t mThreadCount;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Task> mQueue;
+    bool mRunning;
+    std::vector<std::thread> mThreads;
+    std::atomic<uint64_t> mRejectedTasks;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FVM_EXECUTOR_HPP
@@ -0,0 +1,76 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef FVM_REPLAY_DRIVER_HPP
+#define FVM_REPLAY_DRIVER_HPP
+
+#include <chrono>
+#include <memory>
+#include "AFreshnessValueManagerImpl.hpp"
+#include "SignalManagerReplay.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief The pace at which a recording is played back
+ *
+ */
+enum class ReplaySpeed : uint8_t {
+    kRealTime = 0,          // the virtual clock follows the wall clock (1x)
+    kAsFastAsPossible = 1   // the virtual clock advances as soon as a MainFunction cycle is done
+};
+
+/**
+ * @brief Result of a replay run
+ *
+ */
+struct ReplayStatistics {
+    uint64_t mainFunctionCycles = 0;
+    uint64_t mainFunctionErrors = 0;
+    uint64_t deliveredSignals = 0;
+    uint64_t droppedSignals = 0;        // incoming signals of the recording the FVM did not subscribe to
+    uint64_t recordedPublications = 0;
+    uint64_t replayedPublications = 0;
+    std::chrono::nanoseconds signalProcessingTime{0};
+    std::chrono::nanoseconds mainFunctionTime{0};
+    std::chrono::nanoseconds maxMainFunctionTime{0};
+    std::vector<SignalRecord> publishedSignals;
+};
+
+/**
+ * @brief Plays a signal recording into an FVM instance.
+ *
+ * The FVM must be constructed with the SignalManagerReplay of the driver and initialized before the run.
+ * The driver owns the time of the FVM: a virtual clock advances by SOK_FM_MAIN_FUNCTION_PERIOD_MS per
+ * MainFunction cycle, and before every cycle the incoming signals of the recording whose timestamp has
+ * been reached are delivered. The run therefore does not depend on thread scheduling. It is repeatable
+ * if the FVM also takes its time stamps from the virtual clock (FvmDependencies::steadyClock, see
+ * GetVirtualTime), its random numbers from a seeded CSM accessor and FvmDependencies::randomSeed, and
+ * its configuration does not enable the background executors or the FV checkpoint.
+ */
+class FvmReplayDriver
+{
+public:
+    FvmReplayDriver(AFreshnessValueManagerImpl& fvm, std::shared_ptr<SignalManagerReplay> signalManager);
+    ~FvmReplayDriver() = default;
+
+    /**
+     * @brief Play the incoming signals of a recording into the FVM
+     *
+     * @param records the recording, see ReadSignalRecording
+     * @param speed the pace of the virtual clock
+     * @return ReplayStatistics counters and processing times of the run
+     */
+    ReplayStatistics Run(std::vector<SignalRecord> const& records, ReplaySpeed speed);
+
+private:
+    AFreshnessValueManagerImpl& mFvm;
+    std::shared_ptr<SignalManagerReplay> mSignalManager;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // FVM_REPLAY_DRIVER_HPP
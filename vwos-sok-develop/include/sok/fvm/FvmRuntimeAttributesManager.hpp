@@ -16,6 +16,13 @@ class FvmRuntimeAttributesManager : public IFvmRuntimeAttributesManager
 {
 public:
     FvmRuntimeAttributesManager();
+
+    /**
+     * @brief Construct an attributes manager for the FV IDs of the given configuration
+     * 
+     * @param configAccessor the configuration to be used instead of the one of the process
+     */
+    explicit FvmRuntimeAttributesManager(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor);
     bool Init() override;
     void Reset() override;
     bool IsActive(SokFreshnessValueId fvId) const override;
@@ -62,6 +62,86 @@ public:
     virtual SokKeyConfig GetSokKeyConfig() const = 0;
     virtual uint16_t GetEcuKeyIdForFvDistribution() const = 0;
 
+    /**
+     * @brief Whether outgoing signals are collected during a MainFunction cycle and transmitted at its end
+     * 
+     * @return true if transmit batching is enabled
+     */
+    virtual bool IsSignalTxBatchingEnabled() const = 0;
+
+    /**
+     * @brief The file to which the signal traffic of the FVM is recorded
+     * 
+     * @return std::string path of the recording file, empty if recording is disabled
+     */
+    virtual std::string GetSignalRecordingFile() const = 0;
+
+    /**
+     * @brief The file in which the SOK time server keeps its FV over restarts
+     * 
+     * @return std::string path of the checkpoint file, empty if the server starts from a random FV
+     */
+    virtual std::string GetFvCheckpointFile() const = 0;
+
+    /**
+     * @brief Whether a participant processes the received FV signals right away on the FVM executor,
+     *        instead of in its next MainFunction
+     * 
+     * @return true if event driven processing is enabled
+     */
+    virtual bool IsEventDrivenProcessingEnabled() const = 0;
+
+    /**
+     * @brief The role of the ECU in the SOK time protocol, the role the configuration was read for if not configured
+     * 
+     * @return FvmRole the configured role
+     */
+    virtual FvmRole GetEcuFunction() const = 0;
+
+    /**
+     * @brief for a gateway only - the configuration file of its participant role, the configuration itself
+     *        is the one of its server role
+     * 
+     * @return std::string the path of the file, relative paths are relative to the directory of this configuration
+     */
+    virtual std::string GetGatewayParticipantConfigFile() const = 0;
+
+    /**
+     * @brief The group authenticated FV broadcast, sent by the server and verified by the participants
+     * 
+     * @return GroupFvBroadcastConfig the broadcast configuration, `enabled` is false if not configured
+     */
+    virtual GroupFvBroadcastConfig GetGroupFvBroadcastConfig() const = 0;
+
+    /**
+     * @brief For a participant, the SOK time servers which are challenged in addition to the server of the
+     *        authenticated FV signals
+     * 
+     * @return TimeServerEndpoints the additional servers, empty if only a single server is configured
+     */
+    virtual TimeServerEndpoints GetRedundantTimeServers() const = 0;
+
+    /**
+     * @brief For a participant, the backoff of repeated authentic FV requests
+     * 
+     * @return FvRequestRetryPolicy the retry policy, `enabled` is false if requests are repeated right after the timeout
+     */
+    virtual FvRequestRetryPolicy GetFvRequestRetryPolicy() const = 0;
+
+    /**
+     * @brief The part of the instance in sharing the FV of the ECU among its SecOC processes
+     * 
+     * @return FvDaemonConfig the FVM daemon configuration, `mode` is kDisabled if the instance serves only its own process
+     */
+    virtual FvDaemonConfig GetFvDaemonConfig() const = 0;
+
+    /**
+     * @brief The executor of the challenge indication callbacks of the application
+     * 
+     * @return CrIndicationExecutorConfig the executor configuration, `enabled` is false if the callbacks run on the signal receive thread
+     */
+    virtual CrIndicationExecutorConfig GetCrIndicationExecutorConfig() const = 0;
+
 };
 
 } // namespace fvm
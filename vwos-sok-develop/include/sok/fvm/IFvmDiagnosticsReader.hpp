@@ -154,6 +154,55 @@ public:
      * @return the list of the missing keys data, or the read operation status error code.
      */
     virtual FvmDiagnosticsResult<std::vector<uint16_t>> ReadMissingKeyListData() const = 0;
+
+    /**
+     * @brief Read the client health list status.
+     *
+     * @return the FvmDiagnosticsErrorCode for the client health list.
+     */
+    virtual FvmDiagnosticsErrorCode ReadClientHealthListStatus() const = 0;
+
+    /**
+     * @brief Read the client health list number.
+     *
+     * @return the number of participants served by the SOK time server (uint64 object) or the read operation error code.
+     */
+    virtual FvmDiagnosticsResult<uint64_t> ReadClientHealthListNumber() const = 0;
+
+    /**
+     * @brief Read the client health list data.
+     *
+     * @return a health record per participant served by the SOK time server, or the read operation error code.
+     */
+    virtual FvmDiagnosticsResult<std::vector<FvmClientHealthRecord>> ReadClientHealthListData() const = 0;
+
+    /**
+     * @brief Read the FV request retry info status.
+     *
+     * @return the FvmDiagnosticsErrorCode for the FV request retry info.
+     */
+    virtual FvmDiagnosticsErrorCode ReadFvRequestRetryInfoStatus() const = 0;
+
+    /**
+     * @brief Read the FV request retry info data.
+     *
+     * @return the authentic FV request counters of a participant, or the read operation error code.
+     */
+    virtual FvmDiagnosticsResult<FvmFvRequestRetryInfo> ReadFvRequestRetryInfoData() const = 0;
+
+    /**
+     * @brief Read the CR indication info status.
+     *
+     * @return the FvmDiagnosticsErrorCode for the CR indication info.
+     */
+    virtual FvmDiagnosticsErrorCode ReadCrIndicationInfoStatus() const = 0;
+
+    /**
+     * @brief Read the CR indication info data.
+     *
+     * @return the challenge indication counters of the FVM, or the read operation error code.
+     */
+    virtual FvmDiagnosticsResult<FvmCrIndicationInfo> ReadCrIndicationInfoData() const = 0;
 };
 
 }  // namespace fvm
@@ -40,9 +40,44 @@ public:
      * 
      * @param signal the name of the signal to publish
      * @param value the value for the outgoing signal
-     * @return FvmErrorCode kSuccess upon success, error code on failure
+     * @return FvmErrorCode kSuccess upon success, error code on failure. While transmit batching is enabled 
+     *         kSuccess only means the update was queued, a failure to transmit it is reported by the next Flush
      */
     virtual FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) = 0;
+
+    /**
+     * @brief Publish a signal right away, also while transmit batching is enabled. For signals of which every 
+     *        value has to be transmitted, e.g. challenges, the batching transmits only the latest value of a signal
+     * 
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    virtual FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) = 0;
+
+    /**
+     * @brief Create the resources of an outgoing signal ahead of its first Publish
+     * 
+     * @param signalConfig the outgoing signal to prepare
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    virtual FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) = 0;
+
+    /**
+     * @brief Enable or disable transmit batching. While enabled, Publish only collects the signal update 
+     *        (the latest value per signal) and the collected updates are transmitted by Flush
+     * 
+     * @param enabled true to enable transmit batching
+     */
+    virtual void SetTxBatching(bool enabled) = 0;
+
+    /**
+     * @brief Transmit the signal updates collected since the last flush, frame by frame
+     * 
+     * @return FvmErrorCode kSuccess upon success (or when nothing was collected), error code if any collected 
+     *         update could not be transmitted. The failed updates are logged and dropped, not retried
+     */
+    virtual FvmErrorCode Flush() = 0;
 };
 
 } // namespace fvm
@@ -0,0 +1,87 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef SIGNAL_MANAGER_RECORDER_HPP
+#define SIGNAL_MANAGER_RECORDER_HPP
+
+#include <chrono>
+#include <memory>
+#include "ISignalManager.hpp"
+#include "SignalRecording.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief Signal manager decorator which records the signal traffic of the FVM.
+ *
+ * Every Subscribe, every incoming signal of a subscription and every Publish is forwarded to
+ * the decorated signal manager and appended to a recording file together with its monotonic
+ * time since the start of the recording. The recording can be played back with FvmReplayDriver.
+ */
+class SignalManagerRecorder : public ISignalManager
+{
+public:
+
+    /**
+     * @brief Construct a recorder
+     *
+     * @param signalManager the signal manager which does the actual signal transport
+     * @param recordingFile the path of the recording file, truncated if it exists
+     */
+    SignalManagerRecorder(std::shared_ptr<ISignalManager> signalManager, std::string const& recordingFile);
+    ~SignalManagerRecorder() = default;
+
+    /**
+     * @brief Subscribe for incoming signal, incoming signal events are recorded before the callback is called
+     *
+     * @param signal the signal name to listen to
+     * @param cb a callback to be called when the signal event occurs
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb) override;
+
+    /**
+     * @brief Publish a signal
+     *
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+
+    /**
+     * @brief Publish a signal right away, also while transmit batching is enabled
+     *
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override;
+    void SetTxBatching(bool enabled) override;
+    FvmErrorCode Flush() override;
+
+    /**
+     * @brief Whether the recording file could be created
+     *
+     * @return true if signal events are recorded
+     */
+    bool IsRecording() const;
+
+private:
+    void record(SignalRecordType type, std::string const& signalName, std::vector<uint8_t> const& payload);
+
+private:
+    std::shared_ptr<ISignalManager> mSignalManager;
+    std::chrono::steady_clock::time_point mRecordingStart;
+    SignalRecordingWriter mWriter;
+    bool mIsRecording;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // SIGNAL_MANAGER_RECORDER_HPP
@@ -0,0 +1,75 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef SIGNAL_MANAGER_REPLAY_HPP
+#define SIGNAL_MANAGER_REPLAY_HPP
+
+#include <mutex>
+#include <unordered_map>
+#include "ISignalManager.hpp"
+#include "SignalRecording.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief Signal manager without any transport, used to play a signal recording into an FVM instance.
+ *
+ * Incoming signals are injected by the replay driver with Deliver, published signals are collected
+ * together with the virtual time of their publication so that they can be compared with the recording.
+ */
+class SignalManagerReplay : public ISignalManager
+{
+public:
+    SignalManagerReplay() = default;
+    ~SignalManagerReplay() = default;
+
+    FvmErrorCode Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb) override;
+    FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override;
+    void SetTxBatching(bool enabled) override;
+    FvmErrorCode Flush() override;
+
+    /**
+     * @brief Hand an incoming signal to the callback of its subscription
+     *
+     * @param signalName the name of the incoming signal
+     * @param value the value of the incoming signal
+     * @return true if the signal is subscribed, false if it was dropped
+     */
+    bool Deliver(std::string const& signalName, std::vector<uint8_t> const& value);
+
+    /**
+     * @brief Set the virtual time which is assigned to the following published signals
+     *
+     * @param timestampNs virtual time in nanoseconds since the start of the replay
+     */
+    void SetVirtualTime(uint64_t timestampNs);
+
+    /**
+     * @brief Get the virtual time set by the replay driver
+     *
+     * @return uint64_t virtual time in nanoseconds since the start of the replay
+     */
+    uint64_t GetVirtualTime() const;
+
+    /**
+     * @brief Take the signals published since the last call
+     *
+     * @return std::vector<SignalRecord> the published signals as kPublish records
+     */
+    std::vector<SignalRecord> TakePublishedSignals();
+
+private:
+    mutable std::mutex mMutex;
+    uint64_t mVirtualTimeNs = 0;
+    std::unordered_map<std::string, SignalEventCallback> mSubscriptions;
+    std::vector<SignalRecord> mPublishedSignals;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // SIGNAL_MANAGER_REPLAY_HPP
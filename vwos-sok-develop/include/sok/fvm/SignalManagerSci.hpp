@@ -6,10 +6,12 @@
 #include <unordered_map>
 #include <atomic>
 #include <list>
+#include <mutex>
 #include "ISignalManager.hpp"
 #include <sci/api/ISignalClient.hpp>
 #include <sci/api/IEventHandlers.hpp>
 #include "IFreshnessValueManagerConfigAccessor.hpp"
+#include "sok/common/FlatStringMap.hpp"
 
 using vwg::e3p::com::sci::api::ISignalClient;
 using vwg::e3p::com::sci::api::ISignalEventHandler;
@@ -32,7 +34,7 @@ namespace sok
 namespace fvm
 {
     
-using IncomingSignalsMap = std::unordered_map<std::string, std::shared_ptr<ReceivedSignal>>;
+using IncomingSignalsMap = common::FlatStringMap<std::shared_ptr<ReceivedSignal>>;
 
 class SokSignalEventHandler;
 
@@ -41,6 +43,14 @@ class SignalManagerSci : public ISignalManager
 public:
 
     SignalManagerSci();
+
+    /**
+     * @brief Construct a signal manager reading the network interface from the given configuration,
+     *        e.g.: the one of an FVM instance created by FreshnessValueManager::Create()
+     * 
+     * @param configAccessor the configuration of the FVM instance
+     */
+    explicit SignalManagerSci(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor);
     ~SignalManagerSci();
 
     /**
@@ -61,7 +71,52 @@ public:
      */
     FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
 
+    /**
+     * @brief Publish a signal right away, also while transmit batching is enabled
+     * 
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+
+    /**
+     * @brief Create and activate the frame, PDU and signal of an outgoing signal ahead of its first Publish
+     * 
+     * @param signalConfig the outgoing signal to prepare
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override;
+
+    /**
+     * @brief Enable or disable transmit batching
+     * 
+     * @param enabled true to collect outgoing signal updates until the next Flush
+     */
+    void SetTxBatching(bool enabled) override;
+
+    /**
+     * @brief Transmit the signal updates collected since the last flush, frame by frame
+     * 
+     * @return FvmErrorCode kSuccess upon success, error code if any collected update could not be transmitted.
+     *         Those updates are logged and dropped
+     */
+    FvmErrorCode Flush() override;
+
 private:
+    /**
+     * @brief An outgoing signal update waiting for the next Flush
+     * 
+     */
+    struct PendingSignalUpdate {
+        std::string name;
+        std::shared_ptr<TransmittedSignal> signal;
+        std::vector<uint8_t> value;
+    };
+
+    FvmErrorCode publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value, bool batched);
+    std::shared_ptr<TransmittedSignal> getOutgoingSignal(SignalConfig const& signalConfig);
+    FvmErrorCode setSignalValue(std::shared_ptr<TransmittedSignal> const& signal, std::string const& name, std::vector<uint8_t> const& value) const;
     std::shared_ptr<ReceivedSignal> createIncomingSignal(SignalConfig const& signalConfig);
     std::shared_ptr<TransmittedSignal> createOutgoingSignal(SignalConfig const& signalConfig);
     Frame createSciFrameConfig(FrameConfig const& frameConfig, bool isIncoming) const;
@@ -72,13 +127,16 @@ private:
     std::atomic_bool mInitialized;
     std::shared_ptr<ISignalClient> mSignalClient;
     std::shared_ptr<IFreshnessValueManagerConfigAccessor> mConfAccessor;
-    std::unordered_map<std::string, std::shared_ptr<TransmittedSignal>> mOutSignals;
+    common::FlatStringMap<std::shared_ptr<TransmittedSignal>> mOutSignals;
     IncomingSignalsMap mInSignals;
     std::list<std::shared_ptr<SokSignalEventHandler>> mSignalEventHandlers;
-    std::unordered_map<std::string, std::shared_ptr<ReceivedFrame>> mIncomingFramesCache;
-    std::unordered_map<std::string, std::shared_ptr<ReceivedPdu>> mIncomingPdusCache;
-    std::unordered_map<std::string, std::shared_ptr<TransmittedFrame>> mOutgoingFramesCache;
-    std::unordered_map<std::string, std::shared_ptr<TransmittedPdu>> mOutgoingPdusCache;
+    common::FlatStringMap<std::shared_ptr<ReceivedFrame>> mIncomingFramesCache;
+    common::FlatStringMap<std::shared_ptr<ReceivedPdu>> mIncomingPdusCache;
+    common::FlatStringMap<std::shared_ptr<TransmittedFrame>> mOutgoingFramesCache;
+    common::FlatStringMap<std::shared_ptr<TransmittedPdu>> mOutgoingPdusCache;
+    std::atomic_bool mTxBatching;
+    std::mutex mPendingTxMutex;
+    std::unordered_map<std::string, std::vector<PendingSignalUpdate>> mPendingTxFrames;
 };
 
 class SokSignalEventHandler : public ISignalEventHandler
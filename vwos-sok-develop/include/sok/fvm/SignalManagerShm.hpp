@@ -0,0 +1,137 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef SIGNAL_MANAGER_SHM_HPP
+#define SIGNAL_MANAGER_SHM_HPP
+
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include "ISignalManager.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+struct ShmFrameRing;
+
+/**
+ * @brief Signal manager for FVM instances and SecOC processes which are located on the same SoC.
+ *
+ * Every frame is mapped to a POSIX shared memory segment holding a ring of signal updates.
+ * Publishers append to the ring of the signal's frame and wake up the readers via a process
+ * shared condition variable; every subscribed frame is served by a receiver thread which
+ * triggers the callbacks of the signals subscribed in this process. No network I/O is involved.
+ * A segment is unlinked when the last ring mapped to it is released; a leftover segment of a crashed
+ * run which was not set up completely or has an older layout is recreated.
+ */
+class SignalManagerShm : public ISignalManager
+{
+public:
+
+    SignalManagerShm();
+    ~SignalManagerShm();
+
+    /**
+     * @brief Subscribe for incoming signal
+     *
+     * @param signal the signal name to listen to
+     * @param cb a callback to be called when the signal event occurs
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb) override;
+
+    /**
+     * @brief Publish a signal
+     *
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+
+    /**
+     * @brief Publish a signal right away, also while transmit batching is enabled
+     *
+     * @param signal the name of the signal to publish
+     * @param value the value for the outgoing signal
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override;
+
+    /**
+     * @brief Map the shared memory ring of an outgoing signal's frame ahead of its first Publish
+     *
+     * @param signalConfig the outgoing signal to prepare
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override;
+
+    /**
+     * @brief Enable or disable transmit batching
+     *
+     * @param enabled true to collect outgoing signal updates until the next Flush
+     */
+    void SetTxBatching(bool enabled) override;
+
+    /**
+     * @brief Append the signal updates collected since the last flush to their rings, 
+     *        taking every ring lock and waking up its readers only once
+     *
+     * @return FvmErrorCode kSuccess upon success, error code if the updates of any frame could not be transmitted.
+     *         Those updates are logged and dropped
+     */
+    FvmErrorCode Flush() override;
+
+protected:
+    /**
+     * @brief An outgoing signal update waiting for the next Flush
+     *
+     */
+    struct PendingSignalUpdate {
+        std::string name;
+        std::vector<uint8_t> value;
+    };
+
+    /**
+     * @brief Append signal updates to the ring of their frame and wake up its readers
+     *
+     * @param ring the ring of the frame
+     * @param updates the signal updates to append
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    virtual FvmErrorCode transmit(std::shared_ptr<ShmFrameRing> const& ring, std::vector<PendingSignalUpdate> const& updates) const;
+
+private:
+    struct FrameReceiver;
+
+    /**
+     * @brief The outgoing signal updates of a single frame waiting for the next Flush
+     *
+     */
+    struct PendingFrameUpdates {
+        std::shared_ptr<ShmFrameRing> ring;
+        std::vector<PendingSignalUpdate> updates;
+    };
+
+    FvmErrorCode publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value, bool batched);
+    std::shared_ptr<ShmFrameRing> getOrOpenRing(FrameConfig const& frameConfig);
+    std::shared_ptr<ShmFrameRing> openRing(FrameConfig const& frameConfig, bool& retry) const;
+    void receiveLoop(std::shared_ptr<FrameReceiver> const& receiver) noexcept;
+
+private:
+    std::atomic_bool mStopReceiving;
+    std::atomic_bool mTxBatching;
+    std::mutex mPendingTxMutex;
+    std::unordered_map<std::string, PendingFrameUpdates> mPendingTxFrames;
+    std::mutex mRingsMutex;
+    std::unordered_map<std::string, std::shared_ptr<ShmFrameRing>> mRings;
+    std::unordered_map<std::string, std::shared_ptr<FrameReceiver>> mReceivers;
+};
+
+} // namespace fvm
+} // namespace sok
+
+#endif // SIGNAL_MANAGER_SHM_HPP
@@ -0,0 +1,84 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#ifndef SIGNAL_RECORDING_HPP
+#define SIGNAL_RECORDING_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "FreshnessValueManagerError.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+/**
+ * @brief The kind of a recorded signal event
+ *
+ */
+enum class SignalRecordType : uint8_t {
+    kSubscribe = 0,     // the FVM subscribed to a signal
+    kReceive = 1,       // a subscribed signal arrived and was handed to the FVM
+    kPublish = 2        // the FVM published a signal
+};
+
+/**
+ * @brief A single recorded signal event
+ *
+ */
+struct SignalRecord {
+    uint64_t timestampNs;           // monotonic time since the start of the recording
+    SignalRecordType type;
+    std::string signalName;
+    std::vector<uint8_t> payload;   // empty for kSubscribe
+};
+
+/**
+ * @brief Writes signal events to a recording file.
+ *
+ * File layout (all integers little endian):
+ *  header: magic "SOKSREC\0" (8 bytes), format version (uint16)
+ *  record: timestamp ns (uint64), type (uint8), name length (uint16), payload length (uint32), name, payload
+ */
+class SignalRecordingWriter
+{
+public:
+    SignalRecordingWriter() = default;
+    ~SignalRecordingWriter() = default;
+
+    /**
+     * @brief Create (or truncate) the recording file and write the file header
+     *
+     * @param path the path of the recording file
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Open(std::string const& path);
+
+    /**
+     * @brief Append a record to the recording file, may be called from any thread
+     *
+     * @param record the record to append
+     * @return FvmErrorCode kSuccess upon success, error code on failure
+     */
+    FvmErrorCode Write(SignalRecord const& record);
+
+private:
+    std::mutex mFileMutex;
+    std::ofstream mFile;
+};
+
+/**
+ * @brief Reads a recording file written by SignalRecordingWriter
+ *
+ * @param path the path of the recording file
+ * @return FvmResult<std::vector<SignalRecord>> the records in the order they were written, or error code
+ */
+FvmResult<std::vector<SignalRecord>> ReadSignalRecording(std::string const& path);
+
+} // namespace fvm
+} // namespace sok
+
+#endif // SIGNAL_RECORDING_HPP
@@ -4,6 +4,7 @@
 #define SOK_FM_INTERNAL_FACTORY_HPP
 
 #include <memory>
+#include <string>
 #include "sok/fvm/ISignalManager.hpp"
 #include "sok/fvm/IFreshnessValueManagerConfigAccessor.hpp"
 #include "sok/fvm/IFvmRuntimeAttributesManager.hpp"
@@ -19,6 +20,11 @@ public:
     static std::shared_ptr<fvm::ISignalManager>      CreateSignalManager();
     static std::shared_ptr<fvm::IFreshnessValueManagerConfigAccessor>      CreateFreshnessValueManagerConfigAccessor();
     static std::shared_ptr<fvm::IFvmRuntimeAttributesManager>      CreateFvmRuntimeAttributesManager();
+
+    // the collaborators of an FVM instance reading a configuration of its own
+    static std::shared_ptr<fvm::ISignalManager>      CreateSignalManager(std::shared_ptr<fvm::IFreshnessValueManagerConfigAccessor> configAccessor);
+    static std::shared_ptr<fvm::IFreshnessValueManagerConfigAccessor>      CreateFreshnessValueManagerConfigAccessor(FvmRole role, std::string const& configFile);
+    static std::shared_ptr<fvm::IFvmRuntimeAttributesManager>      CreateFvmRuntimeAttributesManager(std::shared_ptr<fvm::IFreshnessValueManagerConfigAccessor> configAccessor);
 };
 
 }  // namespace fvm
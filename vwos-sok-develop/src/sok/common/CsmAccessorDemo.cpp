@@ -9,15 +9,18 @@
 #include <functional>
 #include "sok/common/SokUtilities.hpp"
 
-using random_bytes_engine = std::independent_bits_engine<
-    std::default_random_engine, CHAR_BIT, unsigned char>;
-
 namespace sok {
 namespace common {
 
 CsmAccessorDemo::CsmAccessorDemo() 
+: CsmAccessorDemo(static_cast<uint32_t>(std::time(nullptr)))
+{
+}
+
+CsmAccessorDemo::CsmAccessorDemo(uint32_t seed)
+: mRandomMutex()
+, mRandom(seed)
 {
-    std::srand(static_cast<uint>(std::time(nullptr)));
 }
 
 CsmResult<std::vector<uint8_t>> 
@@ -51,10 +54,13 @@ CsmAccessorDemo::IsKeyExists(uint16_t keyId) const
 CsmResult<std::vector<uint8_t>> 
 CsmAccessorDemo::GenerateRandomBytes(uint8_t size) const
 {
-    random_bytes_engine rbe(static_cast<uint8_t>(rand() % UINT8_MAX));
     std::vector<uint8_t> randomVec(size);
+    std::uniform_int_distribution<uint32_t> byteDistribution(0U, UINT8_MAX);
 
-    std::generate(begin(randomVec), end(randomVec), std::ref(rbe));
+    std::lock_guard<std::mutex> lock(mRandomMutex);
+    std::generate(begin(randomVec), end(randomVec), [this, &byteDistribution]() {
+        return static_cast<uint8_t>(byteDistribution(mRandom));
+    });
 
     return CsmResult<std::vector<uint8_t>>(randomVec);
 }
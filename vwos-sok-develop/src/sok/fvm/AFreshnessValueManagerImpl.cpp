@@ -1,10 +1,13 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include "sok/fvm/AFreshnessValueManagerImpl.hpp"
+#include <algorithm>
+#include <chrono>
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
 #include "sok/common/SokUtilities.hpp"
 #include "sok/common/SokCommonInternalFactory.hpp"
 #include "sok/fvm/SokFmInternalFactory.hpp"
+#include "sok/fvm/SignalManagerRecorder.hpp"
 #include "sok/common/Logger.hpp"
 
 namespace sok
@@ -12,53 +15,117 @@ namespace sok
 namespace fvm
 {
 
+namespace
+{
+
+// one revolution of the wheel covers the challenge timeout, so a session is visited once before it expires
+constexpr size_t CR_SESSION_TIMER_SLOTS = (SOK_FM_CHALLENGE_TIMEOUT_MS / SOK_FM_MAIN_FUNCTION_PERIOD_MS) + 1U;
+
+bool
+endsWith(std::vector<uint8_t> const& challenge, FVContainer const& truncatedChallenge)
+{
+    return (truncatedChallenge.size() <= challenge.size()) &&
+           std::equal(truncatedChallenge.begin(), truncatedChallenge.end(), challenge.end() - truncatedChallenge.size());
+}
+
+} // namespace
+
 AFreshnessValueManagerImpl::AFreshnessValueManagerImpl()
+: AFreshnessValueManagerImpl(FvmDependencies())
+{
+}
+
+AFreshnessValueManagerImpl::AFreshnessValueManagerImpl(std::shared_ptr<ISignalManager> signalManager)
+: AFreshnessValueManagerImpl(FvmDependencies{nullptr, std::move(signalManager), nullptr, nullptr, nullptr, 0U})
+{
+}
+
+AFreshnessValueManagerImpl::AFreshnessValueManagerImpl(FvmDependencies dependencies)
 : mInitialized(false)
 , mIsFvValid(false)
 , mTimeSinceInit(0)
 , mClockCount(0)
 , mFV(0)
-, mActiveOutgoingChallenges()
-, mActiveIncomingChallenges()
+, mFvState()
+, mFvStatePage()
+, mFvEpoch(0)
+, mSteadyNow(dependencies.steadyClock ? std::move(dependencies.steadyClock) : &std::chrono::steady_clock::now)
+, mRandomSeed(dependencies.randomSeed)
+, mCrSessionsMutex()
+, mOutgoingCrSessions()
+, mIncomingCrSessions()
+, mVerifyingSessions()
+, mCrSessionTimers(SOK_FM_MAIN_FUNCTION_PERIOD_MS, CR_SESSION_TIMER_SLOTS)
+, mCrIndicationExecutor()
+, mCrIndicationInfoMutex()
+, mCrIndicationInfo()
 , mChallengeSignalToFvId()
 , mFvRxCandidates()
-, mCsmAccessor(common::SokCommonInternalFactory::CreateCsmAccessor())
-, mSignalManager(SokFmInternalFactory::CreateSignalManager())
-, mAttrMgr(SokFmInternalFactory::CreateFvmRuntimeAttributesManager())
-, mFvmConfAccessor(SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+, mFvmConfAccessor(dependencies.configAccessor ? std::move(dependencies.configAccessor) : SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+, mCsmAccessor(dependencies.csmAccessor ? std::move(dependencies.csmAccessor) : common::SokCommonInternalFactory::CreateCsmAccessor())
+, mSignalManager(dependencies.signalManager ? std::move(dependencies.signalManager) : SokFmInternalFactory::CreateSignalManager(mFvmConfAccessor))
+, mAttrMgr(dependencies.attributesManager ? std::move(dependencies.attributesManager) : SokFmInternalFactory::CreateFvmRuntimeAttributesManager(mFvmConfAccessor))
 {
 }
 
 FvmResult<FVContainer>
-AFreshnessValueManagerImpl::getChallengeForIncomingResponse(SokFreshnessValueId SecOCFreshnessValueID, FVContainer const& SecOCTruncatedFreshnessValue)
+AFreshnessValueManagerImpl::getChallengeForIncomingResponse(SokFreshnessValueId SecOCFreshnessValueID, FVContainer const& SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts)
 {
-    (void)SecOCTruncatedFreshnessValue;
-    auto activeChFindRes = mActiveOutgoingChallenges.find(SecOCFreshnessValueID);
-    if (mActiveOutgoingChallenges.end() == activeChFindRes) {
+    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+    auto sessionsFindRes = mOutgoingCrSessions.find(SecOCFreshnessValueID);
+    if (mOutgoingCrSessions.end() == sessionsFindRes) {
         LOGE("No active challenge found for freshness value ID: " << SecOCFreshnessValueID);
         return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
     }
-    //todo: check if challenge is within timeout
-    //todo: session counter for challenge
-    LOGD("Returning challenge for incoming response");
-    return FvmResult<FVContainer>(activeChFindRes->second.second);
+    // a response most likely answers the latest challenge, the older ones are tried on the further attempts.
+    // A transmitted truncated challenge narrows the sessions down to the matching ones
+    uint16_t candidate = 0;
+    auto const& sessions = sessionsFindRes->second;
+    for (auto it = sessions.rbegin(); it != sessions.rend(); ++it) {
+        if (!endsWith(it->challenge, SecOCTruncatedFreshnessValue)) {
+            continue;
+        }
+        if (SecOCAuthVerifyAttempts == candidate++) {
+            // a further attempt verifies the same response against another session
+            auto& verifying = mVerifyingSessions[SecOCFreshnessValueID];
+            if ((0U == SecOCAuthVerifyAttempts) || verifying.empty()) {
+                if (SOK_FM_MAX_CR_SESSIONS_PER_FV_ID <= verifying.size()) {
+                    // SecOC did not report the status of the oldest verification
+                    verifying.pop_front();
+                }
+                verifying.push_back(it->timerId);
+            } else {
+                verifying.back() = it->timerId;
+            }
+            LOGD("Returning challenge for incoming response");
+            return FvmResult<FVContainer>(it->challenge);
+        }
+    }
+    LOGE("No further active challenge found for freshness value ID: " << SecOCFreshnessValueID << ", verify attempts: " << SecOCAuthVerifyAttempts);
+    return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
 }
 
 FvmResult<FVContainer>
 AFreshnessValueManagerImpl::getChallengeForOutgoingResponse(SokFreshnessValueId SecOCFreshnessValueID)
 {
-    auto activeChFindRes = mActiveIncomingChallenges.find(SecOCFreshnessValueID);
-    if (mActiveIncomingChallenges.end() == activeChFindRes) {
+    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+    auto sessionsFindRes = mIncomingCrSessions.find(SecOCFreshnessValueID);
+    if ((mIncomingCrSessions.end() == sessionsFindRes) || sessionsFindRes->second.empty()) {
         LOGE("No active challenge found for freshness value ID: " << SecOCFreshnessValueID);
         return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
     }
-    auto ret = activeChFindRes->second;
-    //todo: session counter for challenge
+    // the challenges are answered in the order of their arrival
+    auto& sessions = sessionsFindRes->second;
+    auto ret = std::move(sessions.front().challenge);
+    mCrSessionTimers.Cancel(sessions.front().timerId);
 
     // challenge can now be discarded for replay protection
-    mActiveIncomingChallenges.erase(activeChFindRes);
+    sessions.pop_front();
+    if (sessions.empty()) {
+        mIncomingCrSessions.erase(sessionsFindRes);
+    }
     LOGD("Returning challenge for outgoing response");
-    return FvmResult<FVContainer>(ret.second);
+    return FvmResult<FVContainer>(ret);
 }
 
 
@@ -66,13 +133,14 @@ FvmResult<FVContainer>
 AFreshnessValueManagerImpl::getTxFv(SokFreshnessValueId SecOCFreshnessValueID, SokFreshnessType type)
 {
     FVContainer ret;
+    auto const fvState = GetFvState();
     if (!mAttrMgr->IsActive(SecOCFreshnessValueID)) {
         // this is the first occurrence for this ID
-        mAttrMgr->SetActive(SecOCFreshnessValueID, mTimeSinceInit);
+        mAttrMgr->SetActive(SecOCFreshnessValueID, fvState.timeSinceInit);
         ret = common::UintToByteVector<uint64_t>(SOK_UPSTART_TIME);
     }
-    else if (!mIsFvValid) {
-        if (mTimeSinceInit <= SOK_FM_TIME_VALID_TIMEOUT_MS) {
+    else if (!fvState.valid) {
+        if (fvState.timeSinceInit <= SOK_FM_TIME_VALID_TIMEOUT_MS) {
             ret = common::UintToByteVector<uint64_t>(SOK_UPSTART_TIME);
         }
         else {
@@ -81,8 +149,8 @@ AFreshnessValueManagerImpl::getTxFv(SokFreshnessValueId SecOCFreshnessValueID, S
         }
     }
     else {
-        ret = common::UintToByteVector<uint64_t>(mFV);
-        mAttrMgr->UpdateEvent(IFvmRuntimeAttributesManager::EventType::kSignReq, SecOCFreshnessValueID, mFV);
+        ret = common::UintToByteVector<uint64_t>(fvState.fv);
+        mAttrMgr->UpdateEvent(IFvmRuntimeAttributesManager::EventType::kSignReq, SecOCFreshnessValueID, fvState.fv);
     }
 
     if (SokFreshnessType::kVwSokFreshnessValueSessionSender == type) {
@@ -123,7 +191,9 @@ AFreshnessValueManagerImpl::getRxFv(SokFreshnessValueId SecOCFreshnessValueID, S
         }
         mAttrMgr->IncSessionCounter(SecOCFreshnessValueID);
     }
-    if (!mIsFvValid && (mTimeSinceInit > SOK_FM_TIME_VALID_TIMEOUT_MS)) {
+    // a single snapshot, so that the candidates and the validity belong to the same FV
+    auto const fvState = GetFvState();
+    if (!fvState.valid && (fvState.timeSinceInit > SOK_FM_TIME_VALID_TIMEOUT_MS)) {
         LOGE("No auth FV available");
         return FvmResult<FVContainer>(FvmErrorCode::kFVNotAvailable);
     }
@@ -132,31 +202,31 @@ AFreshnessValueManagerImpl::getRxFv(SokFreshnessValueId SecOCFreshnessValueID, S
     bool firstOccurrence = false;
     if (false == mAttrMgr->IsActive(SecOCFreshnessValueID)) {
         firstOccurrence = true;
-        mAttrMgr->SetActive(SecOCFreshnessValueID, mTimeSinceInit);
+        mAttrMgr->SetActive(SecOCFreshnessValueID, fvState.timeSinceInit);
     }
     // if we don't have valid FV and we are within the valid timeout return default FV
-    if (!mIsFvValid && (mTimeSinceInit <= SOK_FM_TIME_VALID_TIMEOUT_MS)) {
+    if (!fvState.valid && (fvState.timeSinceInit <= SOK_FM_TIME_VALID_TIMEOUT_MS)) {
         mFvRxCandidates[SecOCFreshnessValueID] = {SOK_UPSTART_TIME};
     }
-    else if (mIsFvValid) {
+    else if (fvState.valid) {
         if (firstOccurrence) {
-            mFvRxCandidates[SecOCFreshnessValueID] = {SOK_UPSTART_TIME, mFV, mFV-1, mFV+1};
+            mFvRxCandidates[SecOCFreshnessValueID] = {SOK_UPSTART_TIME, fvState.fv, fvState.fv-1, fvState.fv+1};
         }
         else {
             auto firstActivity = mAttrMgr->GetEvent(IFvmRuntimeAttributesManager::EventType::kFirstActivity, SecOCFreshnessValueID);
-            if (mFV < firstActivity) {
+            if (fvState.fv < firstActivity) {
                 return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
             }
-            if ((mTimeSinceInit - firstActivity) <= SOK_FM_TIME_VALID_TIMEOUT_MS) {
-                mFvRxCandidates[SecOCFreshnessValueID] = {SOK_UPSTART_TIME, mFV, mFV-1, mFV+1};
+            if ((fvState.timeSinceInit - firstActivity) <= SOK_FM_TIME_VALID_TIMEOUT_MS) {
+                mFvRxCandidates[SecOCFreshnessValueID] = {SOK_UPSTART_TIME, fvState.fv, fvState.fv-1, fvState.fv+1};
             }
             else {
-                mFvRxCandidates[SecOCFreshnessValueID] = {mFV, mFV-1, mFV+1};
+                mFvRxCandidates[SecOCFreshnessValueID] = {fvState.fv, fvState.fv-1, fvState.fv+1};
             }
         }
     }
     
-    mAttrMgr->UpdateEvent(IFvmRuntimeAttributesManager::EventType::kVerifyReq, SecOCFreshnessValueID, mFV);
+    mAttrMgr->UpdateEvent(IFvmRuntimeAttributesManager::EventType::kVerifyReq, SecOCFreshnessValueID, fvState.fv);
     ret = common::UintToByteVector<uint64_t>(mFvRxCandidates[SecOCFreshnessValueID][SecOCAuthVerifyAttempts]);
     ret.insert(ret.end(), SecOCTruncatedFreshnessValue.begin(), SecOCTruncatedFreshnessValue.end());
     return FvmResult<FVContainer>(ret);
@@ -179,12 +249,12 @@ AFreshnessValueManagerImpl::GetRxFreshness(SokFreshnessValueId SecOCFreshnessVal
 
         switch(getEntryTypeRes.getObject()) {
             case SokFreshnessType::kVwSokFreshnessCrChallenge:
-                if (0 != SecOCAuthVerifyAttempts) {
+                if (SOK_FM_MAX_CR_SESSIONS_PER_FV_ID <= SecOCAuthVerifyAttempts) {
                     LOGE("Invalid amount of verification attempts for FV ID of challenge type");
                     ret = FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
                     break;
                 }
-                ret = getChallengeForIncomingResponse(SecOCFreshnessValueID, SecOCTruncatedFreshnessValue);
+                ret = getChallengeForIncomingResponse(SecOCFreshnessValueID, SecOCTruncatedFreshnessValue, SecOCAuthVerifyAttempts);
                 break;
             case SokFreshnessType::kVwSokFreshnessValueSessionReceiver: // fallthrough
             case SokFreshnessType::kVwSokFreshnessValue:
@@ -253,9 +323,20 @@ AFreshnessValueManagerImpl::VerificationStatusCallout(SecOC_VerificationStatusTy
             return;
         }
         switch(getEntryTypeRes.getObject()) {
-            case SokFreshnessType::kVwSokFreshnessCrChallenge:
-                updateVerificationStatusChallenge(verificationStatus.fvId, verificationStatus.verificationSucceeded);
+            case SokFreshnessType::kVwSokFreshnessCrChallenge: {
+                CrSessionKey session = common::TimerWheel<CrSessionTimeout>::INVALID_TIMER_ID;
+                {
+                    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+                    auto verifyingFindRes = mVerifyingSessions.find(verificationStatus.fvId);
+                    if (mVerifyingSessions.end() == verifyingFindRes) {
+                        LOGW("No response is being verified for FV ID: " << verificationStatus.fvId);
+                        break;
+                    }
+                    session = verifyingFindRes->second.front();
+                }
+                updateVerificationStatusChallenge(verificationStatus.fvId, session, verificationStatus.verificationSucceeded);
                 break;
+            }
             case SokFreshnessType::kVwSokFreshnessValueSessionReceiver: // fallthrough
             case SokFreshnessType::kVwSokFreshnessValue:
                 updateVerificationStatusAuthBroadcast(verificationStatus.fvId, verificationStatus.verificationSucceeded);
@@ -295,6 +376,12 @@ AFreshnessValueManagerImpl::Init() noexcept
             return FvmErrorCode::kGeneralError;
         }
 
+        auto recordingFile = mFvmConfAccessor->GetSignalRecordingFile();
+        if (!recordingFile.empty() && (nullptr == std::dynamic_pointer_cast<SignalManagerRecorder>(mSignalManager))) {
+            // wrapped before the first subscription so that the whole signal traffic is recorded
+            mSignalManager = std::make_shared<SignalManagerRecorder>(mSignalManager, recordingFile);
+        }
+
         auto keyConfig = mFvmConfAccessor->GetSokKeyConfig();
         for (auto&& keyId : keyConfig) {
             if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(keyId.second)) {
@@ -307,6 +394,13 @@ AFreshnessValueManagerImpl::Init() noexcept
             return FvmErrorCode::kGeneralError;
         }
 
+        mSignalManager->SetTxBatching(mFvmConfAccessor->IsSignalTxBatchingEnabled());
+
+        // before the subscriptions, a challenge may arrive right after them
+        if (!startCrIndicationExecutor()) {
+            return FvmErrorCode::kGeneralError;
+        }
+
         if (!registerToSignals()) {
             return FvmErrorCode::kGeneralError;
         }
@@ -315,6 +409,9 @@ AFreshnessValueManagerImpl::Init() noexcept
             return FvmErrorCode::kGeneralError;
         }
 
+        warmUpOutgoingSignals();
+
+        publishFvState(true);
         mInitialized = true;
 
         return FvmErrorCode::kSuccess;
@@ -336,13 +433,26 @@ AFreshnessValueManagerImpl::Deinit() noexcept
             return FvmErrorCode::kSuccess;
         }
         mInitialized = false;
+        // a running callback or signal processing completes before the state is reset, the waiting ones are dropped
+        if (mCrIndicationExecutor) {
+            mCrIndicationExecutor->Stop();
+        }
+        serverOrParticipantDeinit();
         mAttrMgr->Reset();
         mIsFvValid = false;
         mTimeSinceInit = 0;
         mClockCount = 0;
         mFV = 0;
-        mChallengeSignalToFvId.clear();
+        publishFvState(true);
+        mChallengeSignalToFvId.Clear();
         mFvRxCandidates.clear();
+        {
+            std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+            mOutgoingCrSessions.clear();
+            mIncomingCrSessions.clear();
+            mVerifyingSessions.clear();
+            mCrSessionTimers.Clear();
+        }
         return FvmErrorCode::kSuccess;
     } catch (std::exception const& ex) {
         LOGE("exception, what(): " << ex.what());
@@ -356,10 +466,10 @@ AFreshnessValueManagerImpl::Deinit() noexcept
 FvmErrorCode 
 AFreshnessValueManagerImpl::TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID)
 {
-    auto activeChFindRes = mActiveOutgoingChallenges.find(SecOCFreshnessValueID);
-    if (mActiveOutgoingChallenges.end() != activeChFindRes && ((mTimeSinceInit - activeChFindRes->second.first) < SOK_FM_CHALLENGE_TIMEOUT_MS)) {
-        LOGE("Active challenge for this FvId is still undergoing, previous challenge triggered: " << (mTimeSinceInit - activeChFindRes->second.first) << " MS ago");
-        // todo: should be handled differently?
+    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+    auto sessionsFindRes = mOutgoingCrSessions.find(SecOCFreshnessValueID);
+    if ((mOutgoingCrSessions.end() != sessionsFindRes) && (SOK_FM_MAX_CR_SESSIONS_PER_FV_ID <= sessionsFindRes->second.size())) {
+        LOGE("All challenge sessions of FV ID: " << SecOCFreshnessValueID << " are still undergoing");
         return FvmErrorCode::kGeneralError;
     }
 
@@ -375,13 +485,15 @@ AFreshnessValueManagerImpl::TriggerCrRequest(SokFreshnessValueId SecOCFreshnessV
         return FvmErrorCode::kRngError;
     }
     
-    if (FvmErrorCode::kSuccess != mSignalManager->Publish(getChEntryRes.getObject().challengeSignalConfig, genRes.getObject())) {
+    // several challenges of an FV ID may be triggered within a cycle, the transmit batching would keep the latest one only
+    if (FvmErrorCode::kSuccess != mSignalManager->PublishUnbatched(getChEntryRes.getObject().challengeSignalConfig, genRes.getObject())) {
         LOGE("Failed publishing challenge signal");
         // todo: Retry?
         return FvmErrorCode::kGeneralError;
     }
     LOGI("Triggered challenge with ID: " << SecOCFreshnessValueID << " successfully, challenge: " << common::ByteVectorToUint<uint64_t>(genRes.getObject()));
-    mActiveOutgoingChallenges[SecOCFreshnessValueID] = {mTimeSinceInit, genRes.getObject()};
+    auto timerId = mCrSessionTimers.Schedule(GetFvState().timeSinceInit, SOK_FM_CHALLENGE_TIMEOUT_MS, CrSessionTimeout{SecOCFreshnessValueID, true});
+    mOutgoingCrSessions[SecOCFreshnessValueID].push_back(CrSession{genRes.getObject(), timerId});
     return FvmErrorCode::kSuccess;
 }
 
@@ -393,6 +505,7 @@ AFreshnessValueManagerImpl::OfferCrRequest(SokFreshnessValueId SecOCFreshnessVal
         LOGE("FV ID: " << SecOCFreshnessValueID << ", is not supported or not of CR response type");
         return FvmErrorCode::kFvIdNotFound;
     }
+    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
     mFvIdToNotificationCallback[SecOCFreshnessValueID] = cb;
     return FvmErrorCode::kSuccess;
 }
@@ -408,11 +521,14 @@ AFreshnessValueManagerImpl::incTimers() noexcept
         mTimeSinceInit += SOK_FM_MAIN_FUNCTION_PERIOD_MS;
         mClockCount += SOK_FM_MAIN_FUNCTION_PERIOD_MS;
         if (mIsFvValid) {
-            if (SOK_FM_TIME_INCREMENT_PERIOD_MS == mClockCount) {
-                mClockCount = 0;
+            // the phase of a participant's clock is not bound to the MainFunction period, see processAnAuthenticFv
+            if (SOK_FM_TIME_INCREMENT_PERIOD_MS <= mClockCount) {
+                mClockCount -= SOK_FM_TIME_INCREMENT_PERIOD_MS;
                 mFV++;
             }
         }
+        publishFvState(false);
+        expireCrSessions();
     } catch (std::exception const& ex) {
         LOGE("exception, what(): " << ex.what());
     } catch (...) {
@@ -420,6 +536,116 @@ AFreshnessValueManagerImpl::incTimers() noexcept
     }
 }
 
+void
+AFreshnessValueManagerImpl::expireCrSessions() noexcept
+{
+    try {
+        std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+        mCrSessionTimers.Advance(mTimeSinceInit, [this](common::TimerWheel<CrSessionTimeout>::TimerId timerId, CrSessionTimeout const& timeout) {
+            LOGW((timeout.outgoing ? "Outgoing" : "Incoming") << " challenge of FV ID: " << timeout.fvId << " timed out");
+            eraseCrSession(timeout.outgoing ? mOutgoingCrSessions : mIncomingCrSessions, timeout.fvId, timerId);
+        });
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
+
+void
+AFreshnessValueManagerImpl::eraseCrSession(CrSessions& allSessions, SokFreshnessValueId fvId, common::TimerWheel<CrSessionTimeout>::TimerId timerId)
+{
+    auto sessionsFindRes = allSessions.find(fvId);
+    if (allSessions.end() == sessionsFindRes) {
+        return;
+    }
+    auto& sessions = sessionsFindRes->second;
+    auto sessionFindRes = std::find_if(sessions.begin(), sessions.end(), [timerId](CrSession const& session) {
+        return timerId == session.timerId;
+    });
+    if (sessions.end() != sessionFindRes) {
+        mCrSessionTimers.Cancel(timerId);
+        sessions.erase(sessionFindRes);
+    }
+    if (sessions.empty()) {
+        allSessions.erase(sessionsFindRes);
+    }
+}
+
+bool
+AFreshnessValueManagerImpl::startCrIndicationExecutor() noexcept
+{
+    try {
+        auto executorConfig = mFvmConfAccessor->GetCrIndicationExecutorConfig();
+        if (!executorConfig.enabled) {
+            return true;
+        }
+        if (!mCrIndicationExecutor) {
+            mCrIndicationExecutor = std::make_unique<FvmExecutor>(executorConfig.queueDepth, executorConfig.threadCount);
+        }
+        if (!mCrIndicationExecutor->Start()) {
+            LOGE("Failed starting the executor of the challenge indications");
+            return false;
+        }
+        LOGI("Challenge indications run on " << static_cast<uint32_t>(executorConfig.threadCount) << " threads, queue depth: " << executorConfig.queueDepth);
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+    return false;
+}
+
+FvmCrIndicationInfo
+AFreshnessValueManagerImpl::GetCrIndicationInfo() const
+{
+    std::lock_guard<std::mutex> lock(mCrIndicationInfoMutex);
+    return mCrIndicationInfo;
+}
+
+void
+AFreshnessValueManagerImpl::publishFvState(bool resynced) noexcept
+{
+    try {
+        if (resynced) {
+            ++mFvEpoch;
+        }
+        FvStateRecord const record{mFV, mIsFvValid, mTimeSinceInit, mClockCount, mFvEpoch};
+        mFvState.Publish(record);
+        if (mFvStatePage) {
+            mFvStatePage->Publish(record);
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
+
+FvStateRecord
+AFreshnessValueManagerImpl::GetFvState() const noexcept
+{
+    return mFvState.Load();
+}
+
+void
+AFreshnessValueManagerImpl::SetFvStatePage(std::shared_ptr<FvStatePage> page) noexcept
+{
+    mFvStatePage = std::move(page);
+}
+
+bool
+AFreshnessValueManagerImpl::IsFreshnessValueIdConfigured(SokFreshnessValueId SecOCFreshnessValueID) const noexcept
+{
+    try {
+        return mFvmConfAccessor->GetEntryTypeByFvId(SecOCFreshnessValueID).isSucceeded();
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return false;
+    }
+}
+
 bool 
 AFreshnessValueManagerImpl::registerToSignals() noexcept
 {
@@ -435,7 +661,7 @@ AFreshnessValueManagerImpl::registerToSignals() noexcept
                     LOGE("Failed registering for signal: " << confRes.getObject().challengeSignalConfig.name);
                     continue;
                 }
-                mChallengeSignalToFvId[confRes.getObject().challengeSignalConfig.name] = id;
+                mChallengeSignalToFvId.Emplace(confRes.getObject().challengeSignalConfig.name, id);
             }
         }
         return true;
@@ -448,6 +674,40 @@ AFreshnessValueManagerImpl::registerToSignals() noexcept
     }
 }
 
+void
+AFreshnessValueManagerImpl::warmUpOutgoingSignals() noexcept
+{
+    try {
+        auto start = std::chrono::steady_clock::now();
+
+        // incoming signals are already created by their subscription, only the outgoing ones are created lazily
+        auto outgoingSignals = serverOrParticipantOutgoingSignals();
+        for (auto&& id : mFvmConfAccessor->GetAllChallengeFreshnessValueIds()) {
+            auto confRes = mFvmConfAccessor->GetChallengeConfigInstanceByFvId(id);
+            if (confRes.isSucceeded() && (SokFreshnessType::kVwSokFreshnessCrChallenge == confRes.getObject().type)) {
+                outgoingSignals.push_back(confRes.getObject().challengeSignalConfig);
+            }
+        }
+
+        size_t prepared = 0;
+        for (auto&& signalConfig : outgoingSignals) {
+            if (FvmErrorCode::kSuccess != mSignalManager->PrepareOutgoing(signalConfig)) {
+                // not fatal, the signal is created on its first publish instead
+                LOGW("Failed preparing outgoing signal: " << signalConfig.name);
+                continue;
+            }
+            prepared++;
+        }
+
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        LOGI("Prepared " << prepared << " of " << outgoingSignals.size() << " outgoing signals in " << elapsedUs << " us");
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
+
 void 
 AFreshnessValueManagerImpl::incomingChallengeSignalCb(std::string const& signal, std::vector<uint8_t> const& challenge)
 {
@@ -455,38 +715,84 @@ AFreshnessValueManagerImpl::incomingChallengeSignalCb(std::string const& signal,
         LOGE("Invalid challenge size: " << challenge.size());
         return;
     }
-    auto fvIdRes = mChallengeSignalToFvId.find(signal);
-    if (mChallengeSignalToFvId.end() == fvIdRes) {
+    auto fvIdRes = mChallengeSignalToFvId.Find(signal);
+    if (nullptr == fvIdRes) {
         LOGE("Received unregistered signal: " << signal);
         return;
     }
-    LOGI("Received challenge signal: " << signal << ", connected with FV ID: " << fvIdRes->second);
+    SokFreshnessValueId fvId = *fvIdRes;
+    LOGI("Received challenge signal: " << signal << ", connected with FV ID: " << fvId);
 
-    auto cbFindRes = mFvIdToNotificationCallback.find(fvIdRes->second);
-    if (mFvIdToNotificationCallback.end() == cbFindRes) {
-        LOGE("No app notification callback was registered for challenge signal: " << signal);
-        return;
+    ChallengeReceivedIndicationCb appCb;
+    common::TimerWheel<CrSessionTimeout>::TimerId timerId;
+    {
+        std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+        auto cbFindRes = mFvIdToNotificationCallback.find(fvId);
+        if (mFvIdToNotificationCallback.end() == cbFindRes) {
+            LOGE("No app notification callback was registered for challenge signal: " << signal);
+            return;
+        }
+        appCb = cbFindRes->second;
+        auto& sessions = mIncomingCrSessions[fvId];
+        auto duplicate = std::any_of(sessions.begin(), sessions.end(), [&challenge](CrSession const& session) {
+            return challenge == session.challenge;
+        });
+        if (duplicate) {
+            LOGE("Challenge of FV ID: " << fvId << " is already undergoing, dropping the repetition");
+            return;
+        }
+        if (SOK_FM_MAX_CR_SESSIONS_PER_FV_ID <= sessions.size()) {
+            LOGE("All challenge sessions of FV ID: " << fvId << " are still undergoing, dropping the challenge");
+            return;
+        }
+        timerId = mCrSessionTimers.Schedule(GetFvState().timeSinceInit, SOK_FM_CHALLENGE_TIMEOUT_MS, CrSessionTimeout{fvId, false});
+        sessions.push_back(CrSession{challenge, timerId});
     }
 
-    auto activeChFindRes = mActiveIncomingChallenges.find(fvIdRes->second);
-    if (mActiveIncomingChallenges.end() != activeChFindRes && ((mTimeSinceInit - activeChFindRes->second.first) < SOK_FM_CHALLENGE_TIMEOUT_MS)) {
-        LOGE("Active challenge for this FvId is still undergoing, previous challenge triggered: " << (mTimeSinceInit - activeChFindRes->second.first) << " MS ago");
-        // todo: should be handled differently?
-        return;
+    if (mCrIndicationExecutor) {
+        if (!mCrIndicationExecutor->Post([appCb, fvId]() { appCb(fvId); })) {
+            LOGE("Challenge indication queue is full, dropping the challenge of FV ID: " << fvId);
+            {
+                std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+                eraseCrSession(mIncomingCrSessions, fvId, timerId);
+            }
+            std::lock_guard<std::mutex> lock(mCrIndicationInfoMutex);
+            ++mCrIndicationInfo.queueOverflows;
+            return;
+        }
+    }
+    else {
+        // not locked, the application may answer the challenge right away
+        LOGD("Triggering user's CB for incoming challenge: " << common::ByteVectorToUint<uint64_t>(challenge));
+        appCb(fvId);
+        LOGD("User's CB execution ended");
     }
-    mActiveIncomingChallenges[fvIdRes->second] = {mTimeSinceInit, challenge};
-    LOGD("Triggering user's CB for incoming challenge: " << common::ByteVectorToUint<uint64_t>(challenge));
-    cbFindRes->second(fvIdRes->second);
-    LOGD("User's CB execution ended");
+    std::lock_guard<std::mutex> lock(mCrIndicationInfoMutex);
+    ++mCrIndicationInfo.indications;
 }
 
 void 
-AFreshnessValueManagerImpl::updateVerificationStatusChallenge(SokFreshnessValueId SecOCFreshnessValueID, bool verificationSucceeded)
+AFreshnessValueManagerImpl::updateVerificationStatusChallenge(SokFreshnessValueId SecOCFreshnessValueID, CrSessionKey session, bool verificationSucceeded)
 {
-    if (verificationSucceeded) {
-        LOGD("Received confirmation for verification of a challenge response");
-        mActiveOutgoingChallenges.erase(SecOCFreshnessValueID);
+    std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+    auto verifyingFindRes = mVerifyingSessions.find(SecOCFreshnessValueID);
+    if (mVerifyingSessions.end() != verifyingFindRes) {
+        auto& verifying = verifyingFindRes->second;
+        auto verificationFindRes = std::find(verifying.begin(), verifying.end(), session);
+        if (verifying.end() != verificationFindRes) {
+            verifying.erase(verificationFindRes);
+        }
+        if (verifying.empty()) {
+            mVerifyingSessions.erase(verifyingFindRes);
+        }
+    }
+    if (!verificationSucceeded) {
+        // the session stays pending, the response may answer another session or a later response may arrive
+        return;
     }
+    LOGD("Received confirmation for verification of a challenge response");
+    // a session which timed out meanwhile is not found
+    eraseCrSession(mOutgoingCrSessions, SecOCFreshnessValueID, session);
 }
 
 void 
@@ -0,0 +1,316 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/AuthenticFvResponder.hpp"
+#include <algorithm>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/SokUtilities.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+AuthenticFvResponder::AuthenticFvResponder(std::shared_ptr<common::ICsmAccessor> csmAccessor, std::shared_ptr<ISignalManager> signalManager)
+: mCsmAccessor(std::move(csmAccessor))
+, mSignalManager(std::move(signalManager))
+, mClientSlots()
+, mPendingChallenges()
+, mPendingClientsBitmap()
+, mPendingClientsBitmapWords(0)
+, mChallengeClockMs(0)
+, mNextResponseTimeMs()
+, mExpiredChallenges(0)
+, mRateLimitedChallenges(0)
+, mClientHealthMutex()
+, mClientHealth()
+, mCountedChallengeSequence()
+, mTakenChallengeSequence()
+{}
+
+bool
+AuthenticFvResponder::Init(FmServerClientsConfigMap const& clients, uint64_t timeSinceInitMs)
+{
+    mClientSlots.clear();
+    mClientSlots.reserve(clients.size());
+    for (auto&& client : clients) {
+        if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(client.second.keyId)) {
+            LOGE("Couldn't find key id: " << client.second.keyId << ", for authentic FV distribution with ECU: " << client.first);
+            return false;
+        }
+        mClientSlots.push_back({client.first, client.second.keyId, client.second.clientChallengeSignal, client.second.clientResponseValueSignal, client.second.clientResponseSignatureSignal});
+    }
+    // the challenge slots must be in place before the first challenge signal can arrive
+    allocatePendingChallenges();
+    UpdateClock(timeSinceInitMs);
+
+    for (size_t clientIndex = 0; clientIndex < mClientSlots.size(); ++clientIndex) {
+        auto const& slot = mClientSlots[clientIndex];
+        LOGD("Subscribing for client: "<< slot.ecuName << " incoming FV challenge signal: " << slot.challengeSignal.name);
+        // register for signals, the callback of each client carries the index of the client's slot
+        auto ret = mSignalManager->Subscribe(slot.challengeSignal, [this, clientIndex](std::string const& signal, std::vector<uint8_t> const& challenge) {
+            (void)signal;
+            this->incomingChallengeSignalCb(clientIndex, challenge);
+        });
+        if (FvmErrorCode::kSuccess != ret) {
+            LOGE("Failed subscribing for incoming challenge signal: " << slot.challengeSignal.name)
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+AuthenticFvResponder::UpdateClock(uint64_t timeSinceInitMs)
+{
+    mChallengeClockMs.store(timeSinceInitMs, std::memory_order_relaxed);
+}
+
+std::vector<SignalConfig>
+AuthenticFvResponder::OutgoingSignals() const
+{
+    std::vector<SignalConfig> ret;
+    for (auto&& slot : mClientSlots) {
+        ret.push_back(slot.responseValueSignal);
+        ret.push_back(slot.responseSignatureSignal);
+    }
+    return ret;
+}
+
+std::vector<FvmClientHealthRecord>
+AuthenticFvResponder::GetClientHealth() const
+{
+    std::lock_guard<std::mutex> lock(mClientHealthMutex);
+    return mClientHealth;
+}
+
+void
+AuthenticFvResponder::incomingChallengeSignalCb(size_t clientIndex, std::vector<uint8_t> const& challenge)
+{
+    if (clientIndex >= mClientSlots.size()) {
+        LOGE("Challenge received for unknown client index: " << clientIndex);
+        return;
+    }
+    if (challenge.size() > sizeof(uint64_t)) {
+        LOGE("Invalid challenge size: " << challenge.size() << ", from ECU: " << mClientSlots[clientIndex].ecuName);
+        return;
+    }
+    uint64_t packedChallenge = 0;
+    for (size_t i = 0; i < challenge.size(); ++i) {
+        packedChallenge |= static_cast<uint64_t>(challenge[i]) << (8U * i);
+    }
+
+    // a newer challenge of the same client replaces the pending one
+    auto& pending = mPendingChallenges[clientIndex];
+    auto sequence = pending.sequence.load(std::memory_order_relaxed);
+    pending.sequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    pending.length.store(static_cast<uint8_t>(challenge.size()), std::memory_order_relaxed);
+    pending.value.store(packedChallenge, std::memory_order_relaxed);
+    pending.arrivalTimeMs.store(mChallengeClockMs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    pending.sequence.store(sequence + 2U, std::memory_order_release);
+
+    mPendingClientsBitmap[clientIndex / 64U].fetch_or(1ULL << (clientIndex % 64U), std::memory_order_release);
+}
+
+void
+AuthenticFvResponder::allocatePendingChallenges()
+{
+    mPendingChallenges.reset(new PendingChallenge[mClientSlots.size()]);
+    for (size_t i = 0; i < mClientSlots.size(); ++i) {
+        mPendingChallenges[i].sequence.store(0U);
+        mPendingChallenges[i].length.store(0U);
+        mPendingChallenges[i].value.store(0U);
+        mPendingChallenges[i].arrivalTimeMs.store(0U);
+    }
+    mNextResponseTimeMs.assign(mClientSlots.size(), 0U);
+    mTakenChallengeSequence.assign(mClientSlots.size(), 0U);
+    {
+        std::lock_guard<std::mutex> lock(mClientHealthMutex);
+        mClientHealth.assign(mClientSlots.size(), FvmClientHealthRecord());
+        for (size_t i = 0; i < mClientSlots.size(); ++i) {
+            mClientHealth[i].ecuName = mClientSlots[i].ecuName;
+        }
+        mCountedChallengeSequence.assign(mClientSlots.size(), 0U);
+    }
+    mPendingClientsBitmapWords = (mClientSlots.size() + 63U) / 64U;
+    mPendingClientsBitmap.reset(new std::atomic<uint64_t>[mPendingClientsBitmapWords]);
+    for (size_t i = 0; i < mPendingClientsBitmapWords; ++i) {
+        mPendingClientsBitmap[i].store(0U);
+    }
+}
+
+bool
+AuthenticFvResponder::readPendingChallenge(size_t clientIndex, std::vector<uint8_t>& challenge, uint64_t& arrivalTimeMs, uint32_t& sequence) const
+{
+    auto const& pending = mPendingChallenges[clientIndex];
+    uint8_t length = 0;
+    uint64_t packedChallenge = 0;
+    uint32_t sequenceBefore = 0;
+    uint32_t sequenceAfter = 0;
+    do {
+        sequenceBefore = pending.sequence.load(std::memory_order_acquire);
+        length = pending.length.load(std::memory_order_relaxed);
+        packedChallenge = pending.value.load(std::memory_order_relaxed);
+        arrivalTimeMs = pending.arrivalTimeMs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequenceAfter = pending.sequence.load(std::memory_order_relaxed);
+    } while ((0U != (sequenceBefore & 1U)) || (sequenceBefore != sequenceAfter));
+
+    sequence = sequenceAfter;
+    challenge.clear();
+    for (size_t i = 0; i < length; ++i) {
+        challenge.push_back(static_cast<uint8_t>(packedChallenge >> (8U * i)));
+    }
+    return 0U != length;
+}
+
+void
+AuthenticFvResponder::recordChallenge(ResponseCandidate const& candidate)
+{
+    // a deferred challenge is read again in the next round but counted once
+    if (mCountedChallengeSequence[candidate.clientIndex] == candidate.sequence) {
+        return;
+    }
+    mCountedChallengeSequence[candidate.clientIndex] = candidate.sequence;
+    auto& health = mClientHealth[candidate.clientIndex];
+    if ((0U != health.challenges) && (candidate.arrivalTimeMs >= health.lastChallengeTimeMs)) {
+        auto interval = static_cast<int64_t>(candidate.arrivalTimeMs - health.lastChallengeTimeMs);
+        auto mean = static_cast<int64_t>(health.meanChallengeIntervalMs);
+        health.meanChallengeIntervalMs = static_cast<uint32_t>((0 == mean) ? interval : (mean + ((interval - mean) / 8)));
+    }
+    health.lastChallengeTimeMs = candidate.arrivalTimeMs;
+    ++health.challenges;
+}
+
+void
+AuthenticFvResponder::takeChallenge(ResponseCandidate const& candidate)
+{
+    mTakenChallengeSequence[candidate.clientIndex] = candidate.sequence;
+}
+
+std::vector<AuthenticFvResponder::ResponseCandidate>
+AuthenticFvResponder::admitPendingChallenges(uint64_t timeSinceInitMs)
+{
+    // the pending set is taken over word by word, challenges arriving meanwhile are answered in the next round.
+    std::vector<ResponseCandidate> candidates;
+    std::lock_guard<std::mutex> lock(mClientHealthMutex);
+    for (size_t word = 0; word < mPendingClientsBitmapWords; ++word) {
+        uint64_t pendingBits = mPendingClientsBitmap[word].exchange(0U, std::memory_order_acquire);
+        for (size_t bit = 0; (0U != pendingBits) && (bit < 64U); ++bit, pendingBits >>= 1U) {
+            if (0U == (pendingBits & 1U)) {
+                continue;
+            }
+            ResponseCandidate candidate{(word * 64U) + bit, 0U, 0U, {}};
+            if (!readPendingChallenge(candidate.clientIndex, candidate.challenge, candidate.arrivalTimeMs, candidate.sequence)) {
+                continue;
+            }
+            // the bit was cleared before the snapshot, a challenge written in between was snapshot by an earlier
+            // round already and set the bit again afterwards
+            if (candidate.sequence == mTakenChallengeSequence[candidate.clientIndex]) {
+                continue;
+            }
+            recordChallenge(candidate);
+            // the participant has given up on this challenge and sends a new one
+            if ((timeSinceInitMs >= candidate.arrivalTimeMs) && ((timeSinceInitMs - candidate.arrivalTimeMs) >= SOK_FM_TIME_REQUEST_TIMEOUT_MS)) {
+                LOGW("Dropping expired challenge from ECU: " << mClientSlots[candidate.clientIndex].ecuName);
+                ++mExpiredChallenges;
+                ++mClientHealth[candidate.clientIndex].droppedChallenges;
+                takeChallenge(candidate);
+                continue;
+            }
+            if (timeSinceInitMs < mNextResponseTimeMs[candidate.clientIndex]) {
+                LOGW("Dropping challenge from ECU: " << mClientSlots[candidate.clientIndex].ecuName << ", minimum challenge interval not elapsed");
+                ++mRateLimitedChallenges;
+                ++mClientHealth[candidate.clientIndex].droppedChallenges;
+                takeChallenge(candidate);
+                continue;
+            }
+            candidates.push_back(std::move(candidate));
+        }
+    }
+
+    // participants which were never answered have no valid FV at all and go first, then earliest deadline first,
+    // all challenges have the same timeout thus the earliest arrival first
+    std::stable_sort(candidates.begin(), candidates.end(), [this](ResponseCandidate const& lhs, ResponseCandidate const& rhs) {
+        bool const lhsNeverSynced = (0U == mClientHealth[lhs.clientIndex].responses);
+        bool const rhsNeverSynced = (0U == mClientHealth[rhs.clientIndex].responses);
+        if (lhsNeverSynced != rhsNeverSynced) {
+            return lhsNeverSynced;
+        }
+        return lhs.arrivalTimeMs < rhs.arrivalTimeMs;
+    });
+    return candidates;
+}
+
+bool
+AuthenticFvResponder::SendResponses(uint64_t fv, uint64_t timeSinceInitMs)
+{
+    auto serializedFv = common::UintToByteVectorTrim<uint64_t>(fv, FVM_SERVER_NUM_OF_BYTES_INITIAL_FV);
+    std::vector<uint8_t> data;
+    data.reserve(CHALLENGE_LENGTH_BYTES + serializedFv.size());
+    // MACs and publishing are done without blocking the reception of challenges.
+    auto candidates = admitPendingChallenges(timeSinceInitMs);
+
+    size_t const responses = std::min<size_t>(candidates.size(), SOK_FM_SERVER_MAX_RESPONSES_PER_CYCLE);
+    for (size_t i = 0; i < responses; ++i) {
+        takeChallenge(candidates[i]);
+        (void)sendResponse(candidates[i], serializedFv, timeSinceInitMs, data);
+    }
+
+    // the challenges beyond the budget of this round stay pending, unless replaced by a newer one meanwhile
+    for (size_t i = responses; i < candidates.size(); ++i) {
+        auto clientIndex = candidates[i].clientIndex;
+        mPendingClientsBitmap[clientIndex / 64U].fetch_or(1ULL << (clientIndex % 64U), std::memory_order_release);
+    }
+    bool const deferred = (responses < candidates.size());
+    if (deferred) {
+        LOGD("Deferring " << (candidates.size() - responses) << " authentic FV responses");
+    }
+    return deferred;
+}
+
+FvmErrorCode
+AuthenticFvResponder::sendResponse(ResponseCandidate const& candidate, std::vector<uint8_t> const& serializedFv, uint64_t timeSinceInitMs,
+                                   std::vector<uint8_t>& data)
+{
+    auto const& slot = mClientSlots[candidate.clientIndex];
+    // todo: assuming that the signature is calculated over - challenge + auth FV. needs verification!!
+    data.assign(candidate.challenge.begin(), candidate.challenge.end());
+    data.insert(data.end(), serializedFv.begin(), serializedFv.end());
+    LOGD("creating authenticator for challenge from ECU: " << slot.ecuName);
+    auto macRes = mCsmAccessor->MacCreate(slot.keyId, data, common::MacAlgorithm::kAes128Cmac);
+    if (macRes.isFailed()) {
+        LOGE("Failed creating MAC for response to FV request from ECU: " << slot.ecuName);
+        std::lock_guard<std::mutex> lock(mClientHealthMutex);
+        ++mClientHealth[candidate.clientIndex].macFailures;
+        return FvmErrorCode::kGeneralError;
+    }
+    mNextResponseTimeMs[candidate.clientIndex] = timeSinceInitMs + SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS;
+
+    std::vector<uint8_t> macRes8Byte(macRes.getObject().begin(),macRes.getObject().begin() + AUTH_FV_SIGNATURE_SIZE_BYTES);
+    LOGD("Sending FV: " << common::ByteVectorToUint<uint64_t>(serializedFv) << ", mac: " << common::ByteVectorToUint<uint64_t>(macRes8Byte))
+    auto ret = mSignalManager->Publish(slot.responseValueSignal, serializedFv);
+    if (FvmErrorCode::kSuccess != ret) {
+        LOGE("Failed sending FV signal to ECU: " << slot.ecuName);
+        return ret;
+    }
+
+    ret = mSignalManager->Publish(slot.responseSignatureSignal, macRes8Byte);
+    if (FvmErrorCode::kSuccess != ret) {
+        LOGE("Failed sending signature signal to ECU: " << slot.ecuName);
+        return ret;
+    }
+    LOGI("Sent FV and signature signals to ECU: " << slot.ecuName << " successfully");
+
+    std::lock_guard<std::mutex> lock(mClientHealthMutex);
+    auto& health = mClientHealth[candidate.clientIndex];
+    health.lastResponseTimeMs = timeSinceInitMs;
+    health.lastResponseLatencyMs = static_cast<uint32_t>((timeSinceInitMs >= candidate.arrivalTimeMs) ? (timeSinceInitMs - candidate.arrivalTimeMs) : 0U);
+    health.maxResponseLatencyMs = std::max(health.maxResponseLatencyMs, health.lastResponseLatencyMs);
+    ++health.responses;
+    return FvmErrorCode::kSuccess;
+}
+
+} // namespace fvm
+} // namespace sok
@@ -2,14 +2,55 @@
 
 #include "sok/fvm/FreshnessValueManager.hpp"
 #include "sok/fvm/AFreshnessValueManagerImpl.hpp"
+#include "sok/fvm/FreshnessValueManagerImplDaemonClient.hpp"
 #include "sok/fvm/FreshnessValueManagerImplParticipant.hpp"
 #include "sok/fvm/FreshnessValueManagerImplServer.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/FvStatePage.hpp"
+#include "sok/fvm/FvmDaemonIpc.hpp"
+#include "sok/fvm/SokFmInternalFactory.hpp"
+#include "sok/common/SokCommonInternalFactory.hpp"
+#include "sok/common/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef SOK_FVM_SERVER
+constexpr sok::fvm::FvmRole FVM_DEFAULT_ROLE = sok::fvm::FvmRole::kServer;
+#else // PARTICIPANT
+constexpr sok::fvm::FvmRole FVM_DEFAULT_ROLE = sok::fvm::FvmRole::kParticipant;
+#endif
 
 namespace sok
 {
 namespace fvm
 {
 
+namespace
+{
+
+void
+toResponse(FvmResult<FVContainer> result, FvmIpcMessage& response)
+{
+    response.result = result.getResultCode();
+    if (result.isFailed()) {
+        return;
+    }
+    auto const& fv = result.getObject();
+    if (FVM_IPC_MAX_DATA_LENGTH < fv.size()) {
+        LOGE("FV of FV ID: " << response.fvId << " is too long for a SecOC process");
+        response.result = FvmErrorCode::kGeneralError;
+        return;
+    }
+    response.length = static_cast<uint8_t>(fv.size());
+    std::copy(fv.begin(), fv.end(), response.data);
+}
+
+} // namespace
+
 std::shared_ptr<FreshnessValueManager> 
 FreshnessValueManager::GetInstance()
 {
@@ -19,69 +60,320 @@ FreshnessValueManager::GetInstance()
     return fvmSP;
 }
 
+std::shared_ptr<FreshnessValueManager>
+FreshnessValueManager::Create(FvmInstanceConfig const& config)
+{
+    return std::shared_ptr<FreshnessValueManager>(new FreshnessValueManager(
+        config, SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor(config.role, config.configFile)));
+}
+
 FreshnessValueManager::FreshnessValueManager()
+: FreshnessValueManager(FvmInstanceConfig{FVM_DEFAULT_ROLE, std::string(), nullptr, nullptr, false, -1},
+                        SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
 {
-#ifdef SOK_FVM_SERVER
-    pImpl = std::make_unique<FreshnessValueManagerImplServer>();
-#else
-    pImpl = std::make_unique<FreshnessValueManagerImplParticipant>();
-#endif
 }
 
-FreshnessValueManager::~FreshnessValueManager() = default;
+FreshnessValueManager::FreshnessValueManager(FvmInstanceConfig const& config, std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor)
+: mInstanceConfig(config)
+, mConfAccessor(std::move(configAccessor))
+, mInitMutex()
+, mImplsCreated(false)
+, pImpl()
+, pGatewayParticipantImpl()
+, mDaemonServer()
+, mMainFunctionThreadRunning(false)
+, mMainFunctionThread()
+{
+}
+
+FreshnessValueManager::~FreshnessValueManager()
+{
+    stopMainFunctionThread();
+    if (mDaemonServer) {
+        mDaemonServer->Stop();
+    }
+}
 
 FvmResult<FVContainer> 
 FreshnessValueManager::GetRxFreshness(SokFreshnessValueId SecOCFreshnessValueID, const FVContainer &SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts) noexcept
 {
-    return pImpl->GetRxFreshness(SecOCFreshnessValueID, SecOCTruncatedFreshnessValue, SecOCAuthVerifyAttempts);
+    auto impl = implOf(SecOCFreshnessValueID);
+    if (nullptr == impl) {
+        return FvmResult<FVContainer>(FvmErrorCode::kNotInitialized);
+    }
+    return impl->GetRxFreshness(SecOCFreshnessValueID, SecOCTruncatedFreshnessValue, SecOCAuthVerifyAttempts);
 }
 
 FvmResult<FVContainer>
 FreshnessValueManager::GetTxFreshness(SokFreshnessValueId SecOCFreshnessValueID) noexcept
 {
-    return pImpl->GetTxFreshness(SecOCFreshnessValueID);
+    auto impl = implOf(SecOCFreshnessValueID);
+    if (nullptr == impl) {
+        return FvmResult<FVContainer>(FvmErrorCode::kNotInitialized);
+    }
+    return impl->GetTxFreshness(SecOCFreshnessValueID);
 }
 
 void 
 FreshnessValueManager::VerificationStatusCallout(SecOC_VerificationStatusType verificationStatus) noexcept
 {
-    pImpl->VerificationStatusCallout(verificationStatus);
+    auto impl = implOf(verificationStatus.fvId);
+    if (nullptr != impl) {
+        impl->VerificationStatusCallout(verificationStatus);
+    }
 }
 
 void 
 FreshnessValueManager::SPduTxConfirmation(SokFreshnessValueId SecOCFreshnessValueID) noexcept
 {
-    pImpl->SPduTxConfirmation(SecOCFreshnessValueID);
+    auto impl = implOf(SecOCFreshnessValueID);
+    if (nullptr != impl) {
+        impl->SPduTxConfirmation(SecOCFreshnessValueID);
+    }
 }
 
 FvmErrorCode 
 FreshnessValueManager::MainFunction() noexcept
 {
-    return pImpl->MainFunction();
+    if (!mImplsCreated.load(std::memory_order_acquire)) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    auto ret = pImpl->MainFunction();
+    if (pGatewayParticipantImpl) {
+        auto participantRet = pGatewayParticipantImpl->MainFunction();
+        if (FvmErrorCode::kSuccess == ret) {
+            ret = participantRet;
+        }
+    }
+    return ret;
 }
 
 FvmErrorCode 
 FreshnessValueManager::Init() noexcept
 {
-    return pImpl->Init();
+    std::lock_guard<std::mutex> lock(mInitMutex);
+    if (!createImpls()) {
+        return FvmErrorCode::kFVInitializeFailed;
+    }
+    auto ret = pImpl->Init();
+    if ((FvmErrorCode::kSuccess == ret) && pGatewayParticipantImpl) {
+        ret = pGatewayParticipantImpl->Init();
+        if (FvmErrorCode::kSuccess != ret) {
+            pImpl->Deinit();
+        }
+    }
+    if ((FvmErrorCode::kSuccess == ret) && mDaemonServer && !mDaemonServer->Start()) {
+        Deinit();
+        return FvmErrorCode::kFVInitializeFailed;
+    }
+    if ((FvmErrorCode::kSuccess == ret) && mInstanceConfig.runMainFunctionThread && !startMainFunctionThread()) {
+        Deinit();
+        return FvmErrorCode::kFVInitializeFailed;
+    }
+    return ret;
 }
 
 FvmErrorCode 
 FreshnessValueManager::Deinit() noexcept
 {
-    return pImpl->Deinit();
+    stopMainFunctionThread();
+    if (!mImplsCreated.load(std::memory_order_acquire)) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    auto ret = pImpl->Deinit();
+    if (pGatewayParticipantImpl) {
+        auto participantRet = pGatewayParticipantImpl->Deinit();
+        if (FvmErrorCode::kSuccess == ret) {
+            ret = participantRet;
+        }
+    }
+    return ret;
 }
 
 FvmErrorCode 
 FreshnessValueManager::TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID)
 {
-    return pImpl->TriggerCrRequest(SecOCFreshnessValueID);
+    auto impl = implOf(SecOCFreshnessValueID);
+    if (nullptr == impl) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    return impl->TriggerCrRequest(SecOCFreshnessValueID);
 }
 
 FvmErrorCode 
 FreshnessValueManager::OfferCrRequest(SokFreshnessValueId SecOCFreshnessValueID, ChallengeReceivedIndicationCb const& cb)
 {
-    return pImpl->OfferCrRequest(SecOCFreshnessValueID, cb);
+    auto impl = implOf(SecOCFreshnessValueID);
+    if (nullptr == impl) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    return impl->OfferCrRequest(SecOCFreshnessValueID, cb);
+}
+
+bool
+FreshnessValueManager::createImpls() noexcept
+{
+    if (mImplsCreated.load(std::memory_order_acquire)) {
+        return true;
+    }
+    try {
+        // the role is an attribute of the configuration, so it is read before the impls exist
+        if (!mConfAccessor->Init()) {
+            LOGE("Failed reading the FVM configuration");
+            return false;
+        }
+        auto role = mConfAccessor->GetEcuFunction();
+        auto daemonConfig = mConfAccessor->GetFvDaemonConfig();
+        auto csmAccessor = mInstanceConfig.csmAccessor ? mInstanceConfig.csmAccessor : common::SokCommonInternalFactory::CreateCsmAccessor();
+        FvmDependencies dependencies{csmAccessor, mInstanceConfig.signalManager, nullptr, mConfAccessor};
+        if (FvDaemonMode::kClient == daemonConfig.mode) {
+            // the role of the configuration is taken by the FVM daemon of the ECU
+            pImpl = std::make_unique<FreshnessValueManagerImplDaemonClient>(std::move(dependencies));
+        } else if (FvmRole::kParticipant == role) {
+            pImpl = std::make_unique<FreshnessValueManagerImplParticipant>(std::move(dependencies));
+        } else {
+            pImpl = std::make_unique<FreshnessValueManagerImplServer>(std::move(dependencies));
+        }
+        if (FvDaemonMode::kDaemon == daemonConfig.mode) {
+            // the SecOC processes of a gateway's ECU share the FV of its server role
+            auto page = FvStatePage::Create(daemonConfig.pageName);
+            if (!page) {
+                pImpl.reset();
+                return false;
+            }
+            pImpl->SetFvStatePage(std::move(page));
+            mDaemonServer = std::make_unique<FvmDaemonServer>(daemonConfig.socketPath, daemonConfig.clientUid, daemonConfig.clientGid,
+                [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+                    handleDaemonRequest(connection, request, response);
+                });
+        }
+        if ((FvmRole::kGateway == role) && (FvDaemonMode::kClient != daemonConfig.mode)) {
+            // the participant role shares the crypto of the server role, the signals are bound to its own network interface
+            auto participantConfAccessor = SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor(
+                FvmRole::kParticipant, mConfAccessor->GetGatewayParticipantConfigFile());
+            pGatewayParticipantImpl = std::make_unique<FreshnessValueManagerImplParticipant>(
+                FvmDependencies{csmAccessor, mInstanceConfig.signalManager, nullptr, participantConfAccessor, nullptr, 0U});
+        }
+        LOGI("FVM instance created with the role: " << static_cast<uint32_t>(role));
+        mImplsCreated.store(true, std::memory_order_release);
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        pImpl.reset();
+        pGatewayParticipantImpl.reset();
+        mDaemonServer.reset();
+        return false;
+    }
+}
+
+AFreshnessValueManagerImpl*
+FreshnessValueManager::implOf(SokFreshnessValueId SecOCFreshnessValueID) const noexcept
+{
+    if (!mImplsCreated.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    if (pGatewayParticipantImpl && pGatewayParticipantImpl->IsFreshnessValueIdConfigured(SecOCFreshnessValueID)) {
+        return pGatewayParticipantImpl.get();
+    }
+    return pImpl.get();
+}
+
+void
+FreshnessValueManager::handleDaemonRequest(uint64_t connection, FvmIpcMessage const& request, FvmIpcMessage& response) noexcept
+{
+    try {
+        switch (request.type) {
+            case FvmIpcMessageType::kGetRxFreshness: {
+                FVContainer truncatedFv(request.data, request.data + std::min(request.length, FVM_IPC_MAX_DATA_LENGTH));
+                toResponse(GetRxFreshness(request.fvId, truncatedFv, request.authVerifyAttempts), response);
+                break;
+            }
+            case FvmIpcMessageType::kGetTxFreshness:
+                toResponse(GetTxFreshness(request.fvId), response);
+                break;
+            case FvmIpcMessageType::kVerificationStatus:
+                VerificationStatusCallout(SecOC_VerificationStatusType{request.fvId, 0U != request.verificationSucceeded});
+                response.result = FvmErrorCode::kSuccess;
+                break;
+            case FvmIpcMessageType::kTxConfirmation:
+                SPduTxConfirmation(request.fvId);
+                response.result = FvmErrorCode::kSuccess;
+                break;
+            case FvmIpcMessageType::kTriggerCrRequest:
+                response.result = TriggerCrRequest(request.fvId);
+                break;
+            case FvmIpcMessageType::kOfferCrRequest:
+                // a SecOC process may not take over the challenges of an FV ID offered by another connected process
+                if (!mDaemonServer->ClaimFvId(connection, request.fvId)) {
+                    response.result = FvmErrorCode::kGeneralError;
+                    break;
+                }
+                response.result = OfferCrRequest(request.fvId, [this, connection](SokFreshnessValueId fvId) {
+                    mDaemonServer->SendIndication(connection, fvId);
+                });
+                break;
+            default:
+                LOGE("Unsupported request from a SecOC process: " << static_cast<uint32_t>(request.type));
+                response.result = FvmErrorCode::kGeneralError;
+                break;
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        response.result = FvmErrorCode::kGeneralError;
+    }
+}
+
+bool
+FreshnessValueManager::startMainFunctionThread() noexcept
+{
+    if (mMainFunctionThread.joinable()) {
+        return true;
+    }
+    try {
+        mMainFunctionThreadRunning = true;
+        mMainFunctionThread = std::thread(&FreshnessValueManager::runMainFunction, this);
+    } catch (std::exception const& ex) {
+        mMainFunctionThreadRunning = false;
+        LOGE("Failed starting the MainFunction thread, what(): " << ex.what());
+        return false;
+    }
+#ifdef __linux__
+    auto const cpuAffinity = mInstanceConfig.cpuAffinity;
+    if (0 <= cpuAffinity) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuAffinity, &cpuSet);
+        if (0 != pthread_setaffinity_np(mMainFunctionThread.native_handle(), sizeof(cpuSet), &cpuSet)) {
+            LOGW("Failed pinning the MainFunction thread to CPU: " << cpuAffinity);
+        }
+    }
+#endif
+    return true;
+}
+
+void
+FreshnessValueManager::stopMainFunctionThread() noexcept
+{
+    mMainFunctionThreadRunning = false;
+    try {
+        if (mMainFunctionThread.joinable()) {
+            mMainFunctionThread.join();
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+void
+FreshnessValueManager::runMainFunction() noexcept
+{
+    auto const period = std::chrono::milliseconds(SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+    auto nextCall = std::chrono::steady_clock::now();
+    while (mMainFunctionThreadRunning) {
+        MainFunction();
+        nextCall += period;
+        std::this_thread::sleep_until(nextCall);
+    }
 }
 
 } // namespace fvm
@@ -7,10 +7,13 @@
 #include "integration/storagepathprovider.hpp"
 #include "sok/common/Logger.hpp"
 
+constexpr char FVM_SERVER_CONFIG_FILE[] = "/fvm/config_server_source.json";
+constexpr char FVM_PARTICIPANT_CONFIG_FILE[] = "/fvm/config_participant_sink.json";
+
 #ifdef SOK_FVM_SERVER
-constexpr char FVM_CONFIG_FILE[] = "/fvm/config_server_source.json";
+constexpr sok::fvm::FvmRole FVM_DEFAULT_ROLE = sok::fvm::FvmRole::kServer;
 #else // PARTICIPANT
-constexpr char FVM_CONFIG_FILE[] = "/fvm/config_participant_sink.json";
+constexpr sok::fvm::FvmRole FVM_DEFAULT_ROLE = sok::fvm::FvmRole::kParticipant;
 #endif
 
 namespace sok
@@ -19,7 +22,14 @@ namespace fvm
 {
 
 FreshnessValueManagerConfigAccessor::FreshnessValueManagerConfigAccessor()
-: mParser()
+: FreshnessValueManagerConfigAccessor(FVM_DEFAULT_ROLE, std::string())
+{
+}
+
+FreshnessValueManagerConfigAccessor::FreshnessValueManagerConfigAccessor(FvmRole role, std::string const& configFile)
+: mRole(role)
+, mConfigFile(configFile)
+, mParser()
 , mConfig()
 , mInitialized(false)
 {
@@ -34,19 +44,29 @@ FreshnessValueManagerConfigAccessor::GetInstance()
     return confAccessorSP;
 }
 
+std::shared_ptr<FreshnessValueManagerConfigAccessor>
+FreshnessValueManagerConfigAccessor::Create(FvmRole role, std::string const& configFile)
+{
+    return std::shared_ptr<FreshnessValueManagerConfigAccessor>(new FreshnessValueManagerConfigAccessor(role, configFile));
+}
+
 bool
 FreshnessValueManagerConfigAccessor::Init()
 {
     if (mInitialized) {
-        LOGW("Already initialized");
-        return false;
+        // the role is selected by the configuration, which is read before the FVM instance initializes
+        LOGD("Already initialized");
+        return true;
+    }
+    auto configPath = mConfigFile;
+    if (configPath.empty()) {
+        vwg::e3p::integration::StoragePathProvider pathProvider;
+        configPath = pathProvider.getStaticDataBasePath() + ((FvmRole::kParticipant == mRole) ? FVM_PARTICIPANT_CONFIG_FILE : FVM_SERVER_CONFIG_FILE);
     }
-    vwg::e3p::integration::StoragePathProvider pathProvider;
-    auto configPath = pathProvider.getStaticDataBasePath();
 
-    std::ifstream configFile(configPath + FVM_CONFIG_FILE, std::ios::in);
+    std::ifstream configFile(configPath, std::ios::in);
     if (!configFile.is_open()) {
-        LOGE("Failed to open FVM configuration file: " << FVM_CONFIG_FILE);
+        LOGE("Failed to open FVM configuration file: " << configPath);
         return false;
     }
     std::string jsonConfig;
@@ -55,9 +75,17 @@ FreshnessValueManagerConfigAccessor::Init()
     jsonConfig = strStream.str();
     configFile.close();
 
+    mConfig.mEcuFunction = mRole;
     if(!mParser.Parse(jsonConfig, mConfig)) {
         return false;
     }
+    auto& participantConfigFile = mConfig.mGatewayParticipantConfigFile;
+    if (!participantConfigFile.empty() && ('/' != participantConfigFile.front())) {
+        auto directoryEnd = configPath.find_last_of('/');
+        if (std::string::npos != directoryEnd) {
+            participantConfigFile = configPath.substr(0, directoryEnd + 1U) + participantConfigFile;
+        }
+    }
     LOGD("FreshnessValueManagerConfigAccessor::Init() DONE");
     mInitialized = true;
     return true;
@@ -237,5 +265,115 @@ FreshnessValueManagerConfigAccessor::GetEcuKeyIdForFvDistribution() const
     return mConfig.mKeyIdForAuthFvDistribution;
 }
 
+bool 
+FreshnessValueManagerConfigAccessor::IsSignalTxBatchingEnabled() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return false;
+    }
+    return mConfig.mSignalTxBatching;
+}
+
+std::string 
+FreshnessValueManagerConfigAccessor::GetSignalRecordingFile() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return {};
+    }
+    return mConfig.mSignalRecordingFile;
+}
+
+std::string 
+FreshnessValueManagerConfigAccessor::GetFvCheckpointFile() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return {};
+    }
+    return mConfig.mFvCheckpointFile;
+}
+
+bool 
+FreshnessValueManagerConfigAccessor::IsEventDrivenProcessingEnabled() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return false;
+    }
+    return mConfig.mEventDrivenProcessing;
+}
+
+FvmRole 
+FreshnessValueManagerConfigAccessor::GetEcuFunction() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return mRole;
+    }
+    return mConfig.mEcuFunction;
+}
+
+std::string 
+FreshnessValueManagerConfigAccessor::GetGatewayParticipantConfigFile() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return {};
+    }
+    return mConfig.mGatewayParticipantConfigFile;
+}
+
+GroupFvBroadcastConfig 
+FreshnessValueManagerConfigAccessor::GetGroupFvBroadcastConfig() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return GroupFvBroadcastConfig{false, 0, 0, SignalConfig()};
+    }
+    return mConfig.mGroupFvBroadcast;
+}
+
+TimeServerEndpoints 
+FreshnessValueManagerConfigAccessor::GetRedundantTimeServers() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return {};
+    }
+    return mConfig.mRedundantTimeServers;
+}
+
+FvRequestRetryPolicy 
+FreshnessValueManagerConfigAccessor::GetFvRequestRetryPolicy() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return FvRequestRetryPolicy{false, 0, 0};
+    }
+    return mConfig.mFvRequestRetryPolicy;
+}
+
+FvDaemonConfig 
+FreshnessValueManagerConfigAccessor::GetFvDaemonConfig() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return FvDaemonConfig{FvDaemonMode::kDisabled, "", "", FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID};
+    }
+    return mConfig.mFvDaemon;
+}
+
+CrIndicationExecutorConfig 
+FreshnessValueManagerConfigAccessor::GetCrIndicationExecutorConfig() const
+{
+    if (!mInitialized) {
+        LOGE("Config accessor was not initialized");
+        return CrIndicationExecutorConfig{false, 0, 0};
+    }
+    return mConfig.mCrIndicationExecutor;
+}
+
 } // namespace fvm
 } // namespace sok
\ No newline at end of file
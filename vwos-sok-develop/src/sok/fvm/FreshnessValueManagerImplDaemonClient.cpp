@@ -0,0 +1,342 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FreshnessValueManagerImplDaemonClient.hpp"
+#include <algorithm>
+#include <cstring>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+/**
+ * @brief The signals of the SecOC processes are exchanged by the FVM daemon only
+ *
+ */
+class DetachedSignalManager : public ISignalManager
+{
+public:
+    FvmErrorCode Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb) override
+    {
+        (void)signalConfig;
+        (void)cb;
+        return FvmErrorCode::kSuccess;
+    }
+
+    FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override
+    {
+        (void)value;
+        LOGE("Signal: " << signalConfig.name << " is published by the FVM daemon only");
+        return FvmErrorCode::kGeneralError;
+    }
+
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override
+    {
+        return Publish(signalConfig, value);
+    }
+
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override
+    {
+        (void)signalConfig;
+        return FvmErrorCode::kSuccess;
+    }
+
+    void SetTxBatching(bool enabled) override
+    {
+        (void)enabled;
+    }
+
+    FvmErrorCode Flush() override
+    {
+        return FvmErrorCode::kSuccess;
+    }
+};
+
+FvmDependencies
+withDetachedSignals(FvmDependencies dependencies)
+{
+    if (!dependencies.signalManager) {
+        dependencies.signalManager = std::make_shared<DetachedSignalManager>();
+    }
+    return dependencies;
+}
+
+FvmIpcMessage
+makeRequest(FvmIpcMessageType type, SokFreshnessValueId SecOCFreshnessValueID)
+{
+    FvmIpcMessage request{};
+    request.type = type;
+    request.result = FvmErrorCode::kSuccess;
+    request.fvId = SecOCFreshnessValueID;
+    return request;
+}
+
+FvmResult<FVContainer>
+fvOfResponse(FvmErrorCode ipcResult, FvmIpcMessage const& response)
+{
+    if (FvmErrorCode::kSuccess != ipcResult) {
+        return FvmResult<FVContainer>(FvmErrorCode::kFVNotAvailable);
+    }
+    if (FvmErrorCode::kSuccess != response.result) {
+        return FvmResult<FVContainer>(response.result);
+    }
+    auto const length = std::min(response.length, FVM_IPC_MAX_DATA_LENGTH);
+    return FvmResult<FVContainer>(FVContainer(response.data, response.data + length));
+}
+
+} // namespace
+
+FreshnessValueManagerImplDaemonClient::FreshnessValueManagerImplDaemonClient(FvmDependencies dependencies)
+: AFreshnessValueManagerImpl(withDetachedSignals(std::move(dependencies)))
+, mDaemonConfig()
+, mDaemonFvStatePage()
+, mDaemonClient()
+, mIndicationExecutor(SOK_FM_EXECUTOR_QUEUE_CAPACITY)
+{
+}
+
+FreshnessValueManagerImplDaemonClient::~FreshnessValueManagerImplDaemonClient()
+{
+    // no indications are posted once the client is gone
+    mDaemonClient.reset();
+    mIndicationExecutor.Stop();
+}
+
+FvmErrorCode
+FreshnessValueManagerImplDaemonClient::MainFunction() noexcept
+{
+    return mInitialized ? FvmErrorCode::kSuccess : FvmErrorCode::kNotInitialized;
+}
+
+FvmResult<FVContainer>
+FreshnessValueManagerImplDaemonClient::GetRxFreshness(SokFreshnessValueId SecOCFreshnessValueID, FVContainer const& SecOCTruncatedFreshnessValue, uint16_t SecOCAuthVerifyAttempts) noexcept
+{
+    try {
+        if (!mInitialized) {
+            return FvmResult<FVContainer>(FvmErrorCode::kNotInitialized);
+        }
+        if (isAnsweredLocally(SecOCFreshnessValueID)) {
+            return AFreshnessValueManagerImpl::GetRxFreshness(SecOCFreshnessValueID, SecOCTruncatedFreshnessValue, SecOCAuthVerifyAttempts);
+        }
+        if (FVM_IPC_MAX_DATA_LENGTH < SecOCTruncatedFreshnessValue.size()) {
+            LOGE("Truncated FV of FV ID: " << SecOCFreshnessValueID << " is too long for the FVM daemon");
+            return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
+        }
+        auto request = makeRequest(FvmIpcMessageType::kGetRxFreshness, SecOCFreshnessValueID);
+        request.authVerifyAttempts = SecOCAuthVerifyAttempts;
+        request.length = static_cast<uint8_t>(SecOCTruncatedFreshnessValue.size());
+        std::copy(SecOCTruncatedFreshnessValue.begin(), SecOCTruncatedFreshnessValue.end(), request.data);
+        FvmIpcMessage response{};
+        auto ipcResult = forward(request, response);
+        return fvOfResponse(ipcResult, response);
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
+    }
+}
+
+FvmResult<FVContainer>
+FreshnessValueManagerImplDaemonClient::GetTxFreshness(SokFreshnessValueId SecOCFreshnessValueID) noexcept
+{
+    try {
+        if (!mInitialized) {
+            return FvmResult<FVContainer>(FvmErrorCode::kNotInitialized);
+        }
+        if (isAnsweredLocally(SecOCFreshnessValueID)) {
+            return AFreshnessValueManagerImpl::GetTxFreshness(SecOCFreshnessValueID);
+        }
+        FvmIpcMessage response{};
+        auto ipcResult = forward(makeRequest(FvmIpcMessageType::kGetTxFreshness, SecOCFreshnessValueID), response);
+        return fvOfResponse(ipcResult, response);
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return FvmResult<FVContainer>(FvmErrorCode::kGeneralError);
+    }
+}
+
+void
+FreshnessValueManagerImplDaemonClient::VerificationStatusCallout(SecOC_VerificationStatusType verificationStatus) noexcept
+{
+    try {
+        if (isAnsweredLocally(verificationStatus.fvId)) {
+            AFreshnessValueManagerImpl::VerificationStatusCallout(verificationStatus);
+            return;
+        }
+        auto request = makeRequest(FvmIpcMessageType::kVerificationStatus, verificationStatus.fvId);
+        request.verificationSucceeded = verificationStatus.verificationSucceeded ? 1U : 0U;
+        FvmIpcMessage response{};
+        forward(request, response);
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+void
+FreshnessValueManagerImplDaemonClient::SPduTxConfirmation(SokFreshnessValueId SecOCFreshnessValueID) noexcept
+{
+    try {
+        if (isAnsweredLocally(SecOCFreshnessValueID)) {
+            AFreshnessValueManagerImpl::SPduTxConfirmation(SecOCFreshnessValueID);
+            return;
+        }
+        FvmIpcMessage response{};
+        forward(makeRequest(FvmIpcMessageType::kTxConfirmation, SecOCFreshnessValueID), response);
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+FvmErrorCode
+FreshnessValueManagerImplDaemonClient::TriggerCrRequest(SokFreshnessValueId SecOCFreshnessValueID)
+{
+    FvmIpcMessage response{};
+    auto ipcResult = forward(makeRequest(FvmIpcMessageType::kTriggerCrRequest, SecOCFreshnessValueID), response);
+    return (FvmErrorCode::kSuccess != ipcResult) ? ipcResult : response.result;
+}
+
+FvmErrorCode
+FreshnessValueManagerImplDaemonClient::OfferCrRequest(SokFreshnessValueId SecOCFreshnessValueID, ChallengeReceivedIndicationCb const& cb)
+{
+    FvmIpcMessage response{};
+    auto ipcResult = forward(makeRequest(FvmIpcMessageType::kOfferCrRequest, SecOCFreshnessValueID), response);
+    if (FvmErrorCode::kSuccess != ipcResult) {
+        return ipcResult;
+    }
+    if (FvmErrorCode::kSuccess == response.result) {
+        std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+        mFvIdToNotificationCallback[SecOCFreshnessValueID] = cb;
+    }
+    return response.result;
+}
+
+FvStateRecord
+FreshnessValueManagerImplDaemonClient::GetFvState() const noexcept
+{
+    if (!mDaemonFvStatePage) {
+        return FvStateRecord{0, false, 0, 0, 0};
+    }
+    return mDaemonFvStatePage->Load();
+}
+
+bool
+FreshnessValueManagerImplDaemonClient::serverOrParticipantInit() noexcept
+{
+    try {
+        mDaemonConfig = mFvmConfAccessor->GetFvDaemonConfig();
+        if (!mDaemonFvStatePage) {
+            mDaemonFvStatePage = FvStatePage::Open(mDaemonConfig.pageName);
+            if (!mDaemonFvStatePage) {
+                LOGE("FV state page of the FVM daemon is not available");
+                return false;
+            }
+        }
+        if (!mIndicationExecutor.Start()) {
+            LOGE("Failed starting the executor of the challenge indications");
+            return false;
+        }
+        if (!mDaemonClient) {
+            mDaemonClient = std::make_unique<FvmDaemonClient>(mDaemonConfig.socketPath);
+        }
+        return mDaemonClient->Connect([this](SokFreshnessValueId fvId) {
+            indicateChallenge(fvId);
+        });
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return false;
+    }
+}
+
+std::vector<SignalConfig>
+FreshnessValueManagerImplDaemonClient::serverOrParticipantOutgoingSignals() noexcept
+{
+    return {};
+}
+
+void
+FreshnessValueManagerImplDaemonClient::serverOrParticipantDeinit() noexcept
+{
+    try {
+        // restarted by the next Init(), the indications arriving meanwhile are dropped
+        mIndicationExecutor.Stop();
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+bool
+FreshnessValueManagerImplDaemonClient::registerToSignals() noexcept
+{
+    // the challenges are received by the daemon and indicated via the IPC
+    return true;
+}
+
+bool
+FreshnessValueManagerImplDaemonClient::isAnsweredLocally(SokFreshnessValueId SecOCFreshnessValueID) const
+{
+    // a plain FV depends on the FV state only, the session counters and challenges are owned by the daemon
+    auto getEntryTypeRes = mFvmConfAccessor->GetEntryTypeByFvId(SecOCFreshnessValueID);
+    return getEntryTypeRes.isSucceeded() && (SokFreshnessType::kVwSokFreshnessValue == getEntryTypeRes.getObject());
+}
+
+FvmErrorCode
+FreshnessValueManagerImplDaemonClient::forward(FvmIpcMessage const& request, FvmIpcMessage& response) noexcept
+{
+    if (!mDaemonClient) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    auto ret = mDaemonClient->Request(request, response);
+    if (FvmErrorCode::kNotInitialized != ret) {
+        return ret;
+    }
+
+    // the daemon restarted, its offers are renewed before the request is repeated
+    LOGW("Reconnecting to the FVM daemon");
+    if (!mDaemonClient->Connect([this](SokFreshnessValueId fvId) { indicateChallenge(fvId); })) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    std::vector<SokFreshnessValueId> offeredIds;
+    {
+        std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+        for (auto&& offer : mFvIdToNotificationCallback) {
+            offeredIds.push_back(offer.first);
+        }
+    }
+    for (auto&& fvId : offeredIds) {
+        FvmIpcMessage offerResponse{};
+        if ((FvmErrorCode::kSuccess != mDaemonClient->Request(makeRequest(FvmIpcMessageType::kOfferCrRequest, fvId), offerResponse))
+            || (FvmErrorCode::kSuccess != offerResponse.result)) {
+            LOGE("Failed renewing the offer of FV ID: " << fvId);
+        }
+    }
+    return mDaemonClient->Request(request, response);
+}
+
+void
+FreshnessValueManagerImplDaemonClient::indicateChallenge(SokFreshnessValueId SecOCFreshnessValueID) noexcept
+{
+    try {
+        ChallengeReceivedIndicationCb cb;
+        {
+            std::lock_guard<std::mutex> lock(mCrSessionsMutex);
+            auto cbFindRes = mFvIdToNotificationCallback.find(SecOCFreshnessValueID);
+            if (mFvIdToNotificationCallback.end() == cbFindRes) {
+                LOGE("No app notification callback was registered for FV ID: " << SecOCFreshnessValueID);
+                return;
+            }
+            cb = cbFindRes->second;
+        }
+        if (!mIndicationExecutor.Post([cb, SecOCFreshnessValueID]() { cb(SecOCFreshnessValueID); })) {
+            LOGE("Dropped the challenge indication of FV ID: " << SecOCFreshnessValueID);
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+} // namespace fvm
+} // namespace sok
@@ -1,8 +1,10 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include "sok/fvm/FreshnessValueManagerImplParticipant.hpp"
+#include <algorithm>
 #include <cmath>
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/SokFmInternalFactory.hpp"
 #include "sok/common/SokUtilities.hpp"
 #include "sok/common/Logger.hpp"
 
@@ -12,13 +14,48 @@ namespace fvm
 {
 
 FreshnessValueManagerImplParticipant::FreshnessValueManagerImplParticipant()
-: AFreshnessValueManagerImpl()
+: FreshnessValueManagerImplParticipant(FvmDependencies())
+{
+}
+
+FreshnessValueManagerImplParticipant::FreshnessValueManagerImplParticipant(std::shared_ptr<ISignalManager> signalManager)
+: FreshnessValueManagerImplParticipant(FvmDependencies{nullptr, std::move(signalManager), nullptr, nullptr, nullptr, 0U})
+{
+}
+
+FreshnessValueManagerImplParticipant::FreshnessValueManagerImplParticipant(FvmDependencies dependencies)
+: AFreshnessValueManagerImpl(std::move(dependencies))
 , mFvStateManager(std::make_shared<FreshnessValueStateManager>())
 , mTimeSinceAuthFvReq(65535)
 , mActiveFvChallenge()
 , mUnAuthFv()
 , mCrAuthFvAndMac()
 , mEcuKeyIdForFvDistribution()
+, mAuthFvValueSignalName()
+, mAuthFvSignatureSignalName()
+, mUnauthFvSignalName()
+, mRedundantTimeServers()
+, mGroupFvBroadcast()
+, mGroupFvMessage()
+, mGroupSessionKnown(false)
+, mGroupSession(0)
+, mGroupNonceFloor(0)
+, mRelay()
+, mNeedToRelayResponses(false)
+, mRetryPolicy{false, 0, 0}
+, mRetryRandom((0U != mRandomSeed) ? mRandomSeed : std::random_device()())
+, mRequestBackoffMs(0)
+, mRetryInfoMutex()
+, mRetryInfo()
+, mAuthFvRequestTime()
+, mAuthFvResponseTime()
+, mMinAuthFvRoundTrip(std::chrono::steady_clock::duration::max())
+, mDriftEstimator(SOK_FM_DRIFT_WINDOW, SOK_FM_DRIFT_MIN_SAMPLES)
+, mSlewPpm(0.0)
+, mSlewRemainderUs(0.0)
+, mSlewAppliedUs(0)
+, mProcessingMutex()
+, mExecutor()
 {
 }
 
@@ -30,9 +67,32 @@ FreshnessValueManagerImplParticipant::MainFunction() noexcept
             return FvmErrorCode::kNotInitialized;
         }
 
+        // in event driven mode the received FV signals are usually processed by the executor already,
+        // the MainFunction is left with the timeouts and with what the executor couldn't take
+        std::lock_guard<std::mutex> processingLock(mProcessingMutex);
+        uint64_t cachedFv = mFV;
         auto retValue = mFvStateManager->enter();
 
         incTimers();
+        if (mIsFvValid) {
+            slewClock();
+        }
+        if (mRelay) {
+            mRelay->UpdateClock(mTimeSinceInit);
+            // like the server, the downstream ECUs are answered right after the FV was taken over or incremented
+            if (mIsFvValid && ((mFV != cachedFv) || mNeedToRelayResponses)) {
+                auto relayRet = relayAuthenticFvResponses();
+                if (FvmErrorCode::kSuccess == retValue) {
+                    retValue = relayRet;
+                }
+            }
+        }
+
+        // transmits the signals collected during this cycle in case transmit batching is enabled
+        auto flushRet = mSignalManager->Flush();
+        if (FvmErrorCode::kSuccess == retValue) {
+            retValue = flushRet;
+        }
 
         return retValue;
 
@@ -49,6 +109,20 @@ bool
 FreshnessValueManagerImplParticipant::serverOrParticipantInit() noexcept
 {
     try {
+        mRetryPolicy = mFvmConfAccessor->GetFvRequestRetryPolicy();
+        resetClockSlew();
+        if (mFvmConfAccessor->IsEventDrivenProcessingEnabled()) {
+            if (!mExecutor) {
+                mExecutor.reset(new FvmExecutor(SOK_FM_EXECUTOR_QUEUE_CAPACITY));
+            }
+            if (!mExecutor->Start()) {
+                LOGE("Failed starting the event driven processing of the FV signals");
+                return false;
+            }
+        }
+        else {
+            mExecutor.reset();
+        }
         mEcuKeyIdForFvDistribution = mFvmConfAccessor->GetEcuKeyIdForFvDistribution();
         if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(mEcuKeyIdForFvDistribution)) {
             LOGE("Couldn't find key id: " << mEcuKeyIdForFvDistribution << ", for the authentic FV distribution");
@@ -70,11 +144,15 @@ FreshnessValueManagerImplParticipant::serverOrParticipantInit() noexcept
         auto IdleAction = [this]() -> FvmErrorCode {
             return FvmErrorCode::kSuccess;
         };
+        auto processGroupFvAction = [this]() -> FvmErrorCode {
+            return this->processGroupFv();
+        };
 
         mFvStateManager->registerState(FreshnessValueState::FVInProgress, waitForAnAuthenticFvAction);
         mFvStateManager->registerState(FreshnessValueState::RequestFV, requestFvAction);
         mFvStateManager->registerState(FreshnessValueState::ProcessFV, processAnAuthenticFvAction);
         mFvStateManager->registerState(FreshnessValueState::ProcessAnauthFV, processAnUnauthenticFvAction);
+        mFvStateManager->registerState(FreshnessValueState::ProcessGroupFV, processGroupFvAction);
         mFvStateManager->registerState(FreshnessValueState::Idle, IdleAction);
         // Set initial state to RequestFV
         mFvStateManager->transiteTo(FreshnessValueState::RequestFV);
@@ -86,12 +164,73 @@ FreshnessValueManagerImplParticipant::serverOrParticipantInit() noexcept
             this->incomingUnAuthFvSignalsCb(signal, value);
         };
 
+        // the names are kept per instance, the callbacks tell the signals apart by them
+        auto authFvValueSignal = mFvmConfAccessor->GetAuthenticatedFvValueSignalConfig();
+        auto authFvSignatureSignal = mFvmConfAccessor->GetAuthenticatedFvSignatureSignalConfig();
+        auto unauthFvSignal = mFvmConfAccessor->GetUnauthenticatedFvSignalConfig();
+        mAuthFvValueSignalName = authFvValueSignal.name;
+        mAuthFvSignatureSignalName = authFvSignatureSignal.name;
+        mUnauthFvSignalName = unauthFvSignal.name;
+
         LOGI("Subscribing to FV distribution signals");
-        auto ret1 = mSignalManager->Subscribe(mFvmConfAccessor->GetAuthenticatedFvValueSignalConfig(), AuthFvCb);
-        auto ret2 = mSignalManager->Subscribe(mFvmConfAccessor->GetAuthenticatedFvSignatureSignalConfig(), AuthFvCb);
-        auto ret3 = mSignalManager->Subscribe(mFvmConfAccessor->GetUnauthenticatedFvSignalConfig(), unAuthFvCb);
+        auto ret1 = mSignalManager->Subscribe(authFvValueSignal, AuthFvCb);
+        auto ret2 = mSignalManager->Subscribe(authFvSignatureSignal, AuthFvCb);
+        auto ret3 = mSignalManager->Subscribe(unauthFvSignal, unAuthFvCb);
+
+        if (!((FvmErrorCode::kSuccess == ret1) && (FvmErrorCode::kSuccess == ret2) && (FvmErrorCode::kSuccess == ret3))) {
+            return false;
+        }
+
+        // optional, further servers which are challenged in parallel, the first verified response is taken over
+        mRedundantTimeServers.clear();
+        for (auto&& server : mFvmConfAccessor->GetRedundantTimeServers()) {
+            if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(server.keyId)) {
+                LOGE("Couldn't find key id: " << server.keyId << ", for the authentic FV distribution of time server: " << server.serverEcuName);
+                return false;
+            }
+            mRedundantTimeServers.push_back({server, {}});
+        }
+        for (size_t serverIndex = 0; serverIndex < mRedundantTimeServers.size(); ++serverIndex) {
+            auto const& server = mRedundantTimeServers[serverIndex].config;
+            LOGI("Subscribing to FV distribution signals of time server: " << server.serverEcuName);
+            auto redundantAuthFvCb = [this, serverIndex](std::string const& signal, std::vector<uint8_t> const& value) {
+                this->incomingRedundantAuthFvSignalsCb(serverIndex, signal, value);
+            };
+            if ((FvmErrorCode::kSuccess != mSignalManager->Subscribe(server.responseValueSignal, redundantAuthFvCb))
+                || (FvmErrorCode::kSuccess != mSignalManager->Subscribe(server.responseSignatureSignal, redundantAuthFvCb))) {
+                return false;
+            }
+        }
 
-        return ((FvmErrorCode::kSuccess == ret1) && (FvmErrorCode::kSuccess == ret2) && (FvmErrorCode::kSuccess == ret3));
+        mGroupFvBroadcast = mFvmConfAccessor->GetGroupFvBroadcastConfig();
+        if (mGroupFvBroadcast.enabled) {
+            if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(mGroupFvBroadcast.keyId)) {
+                LOGE("Couldn't find key id: " << mGroupFvBroadcast.keyId << ", for the group FV broadcast");
+                return false;
+            }
+            LOGI("Subscribing to the group FV broadcast signal");
+            auto groupFvCb = [this](std::string const& signal, std::vector<uint8_t> const& value) {
+                this->incomingGroupFvSignalCb(signal, value);
+            };
+            if (FvmErrorCode::kSuccess != mSignalManager->Subscribe(mGroupFvBroadcast.signal, groupFvCb)) {
+                return false;
+            }
+        }
+
+        // a participant configured with clients of its own relays the authentic FV to them (FV distribution tree)
+        mRelay.reset();
+        mNeedToRelayResponses = false;
+        auto downstreamClients = mFvmConfAccessor->GetClientsConfigMap();
+        if (!downstreamClients.empty()) {
+            LOGI("Relaying the authentic FV to " << downstreamClients.size() << " downstream ECUs");
+            mRelay.reset(new AuthenticFvResponder(mCsmAccessor, mSignalManager));
+            if (!mRelay->Init(downstreamClients, mTimeSinceInit)) {
+                LOGE("Failed initializing the authentic FV relay");
+                mRelay.reset();
+                return false;
+            }
+        }
+        return true;
     
     } catch (std::exception const& ex) {
         LOGE("exception, what(): " << ex.what());
@@ -102,17 +241,50 @@ FreshnessValueManagerImplParticipant::serverOrParticipantInit() noexcept
     }
 }
 
-void FreshnessValueManagerImplParticipant::incomingAuthFvSignalsCb(std::string const &signal, std::vector<uint8_t> const &value)
+std::vector<SignalConfig>
+FreshnessValueManagerImplParticipant::serverOrParticipantOutgoingSignals() noexcept
+{
+    std::vector<SignalConfig> ret;
+    try {
+        ret.push_back(mFvmConfAccessor->GetAuthenticatedFvChallengeSignalConfig());
+        for (auto&& server : mRedundantTimeServers) {
+            ret.push_back(server.config.challengeSignal);
+        }
+        if (mRelay) {
+            auto relaySignals = mRelay->OutgoingSignals();
+            ret.insert(ret.end(), relaySignals.begin(), relaySignals.end());
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+    return ret;
+}
+
+void 
+FreshnessValueManagerImplParticipant::serverOrParticipantDeinit() noexcept
 {
-    static std::string const authFvSignalValueName = mFvmConfAccessor->GetAuthenticatedFvValueSignalConfig().name;
-    static std::string const authFvSignalSigName = mFvmConfAccessor->GetAuthenticatedFvSignatureSignalConfig().name;
+    try {
+        // not under mProcessingMutex, the running processing takes it. Restarted by the next Init()
+        if (mExecutor) {
+            mExecutor->Stop();
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
 
+void FreshnessValueManagerImplParticipant::incomingAuthFvSignalsCb(std::string const &signal, std::vector<uint8_t> const &value)
+{
     std::lock_guard<std::mutex> lock(mRecFVMutex);
-    if (authFvSignalValueName == signal) {
+    if (mAuthFvValueSignalName == signal) {
         LOGI("Received authenticated FV signal - with FV");
         mCrAuthFvAndMac.first = value;
     }
-    else if (authFvSignalSigName == signal) {
+    else if (mAuthFvSignatureSignalName == signal) {
         LOGI("Received authenticated FV signal - with MAC");
         mCrAuthFvAndMac.second = value;
     }
@@ -121,20 +293,45 @@ void FreshnessValueManagerImplParticipant::incomingAuthFvSignalsCb(std::string c
     }
 
     if (!mCrAuthFvAndMac.first.empty() && !mCrAuthFvAndMac.second.empty()) {
+        mAuthFvResponseTime = mSteadyNow();
         mFvStateManager->reactToFVRes();
+        postSignalProcessing();
     } 
 }
 
+void 
+FreshnessValueManagerImplParticipant::incomingRedundantAuthFvSignalsCb(size_t serverIndex, std::string const& signal, std::vector<uint8_t> const& value)
+{
+    std::lock_guard<std::mutex> lock(mRecFVMutex);
+    auto& server = mRedundantTimeServers[serverIndex];
+    if (server.config.responseValueSignal.name == signal) {
+        LOGI("Received authenticated FV signal - with FV, from time server: " << server.config.serverEcuName);
+        server.authFvAndMac.first = value;
+    }
+    else if (server.config.responseSignatureSignal.name == signal) {
+        LOGI("Received authenticated FV signal - with MAC, from time server: " << server.config.serverEcuName);
+        server.authFvAndMac.second = value;
+    }
+    else {
+        LOGE("Received an invalid signal");
+    }
+
+    if (!server.authFvAndMac.first.empty() && !server.authFvAndMac.second.empty()) {
+        mAuthFvResponseTime = mSteadyNow();
+        mFvStateManager->reactToFVRes();
+        postSignalProcessing();
+    }
+}
+
 void 
 FreshnessValueManagerImplParticipant::incomingUnAuthFvSignalsCb(std::string const& signal, std::vector<uint8_t> const& value)
 {
-    static std::string const unauthFvSignalName = mFvmConfAccessor->GetUnauthenticatedFvSignalConfig().name;
-    
     std::lock_guard<std::mutex> lock(mRecUnauthFvMutex);
-    if ((unauthFvSignalName == signal) && (value.size() == 8)) {
+    if ((mUnauthFvSignalName == signal) && (value.size() == 8)) {
         LOGD("Received an unauthentic freshness value signal, FV: " << common::ByteVectorToUint<uint64_t>(value));
         mUnAuthFv = value;
         mFvStateManager->reactToUnauthenticFVRes();
+        postSignalProcessing();
     }
 
     else {
@@ -142,9 +339,29 @@ FreshnessValueManagerImplParticipant::incomingUnAuthFvSignalsCb(std::string cons
     }
 }
 
+void 
+FreshnessValueManagerImplParticipant::incomingGroupFvSignalCb(std::string const& signal, std::vector<uint8_t> const& value)
+{
+    (void)signal;
+    std::lock_guard<std::mutex> lock(mRecGroupFvMutex);
+    if (value.size() != GROUP_FV_BROADCAST_LENGTH_BYTES) {
+        LOGE("Received an invalid group FV signal, size: " << value.size());
+        return;
+    }
+    mGroupFvMessage = value;
+    mFvStateManager->reactToGroupFVRes();
+    postSignalProcessing();
+}
+
 FvmErrorCode 
 FreshnessValueManagerImplParticipant::requestAnAuthenticFv() {
     
+    // the retry of an unanswered request is sent after its backoff, the participants do not re-challenge in lockstep
+    if (0U != mRequestBackoffMs) {
+        mRequestBackoffMs -= std::min<uint32_t>(mRequestBackoffMs, SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+        return FvmErrorCode::kSuccess;
+    }
+
     auto genRes = mCsmAccessor->GenerateRandomBytes(CHALLENGE_LENGTH_BYTES);
     
     if (genRes.isFailed()) {
@@ -154,9 +371,28 @@ FreshnessValueManagerImplParticipant::requestAnAuthenticFv() {
 
     LOGI("Requesting an authentic freshness value with a challenge");
     auto publishRes = mSignalManager->Publish(mFvmConfAccessor->GetAuthenticatedFvChallengeSignalConfig(), genRes.getObject());
+    if (!mRedundantTimeServers.empty()) {
+        std::lock_guard<std::mutex> lock(mRecFVMutex);
+        // the same challenge to every server, answers to a previous challenge are dropped
+        for (auto&& server : mRedundantTimeServers) {
+            server.authFvAndMac.first.clear();
+            server.authFvAndMac.second.clear();
+            if (FvmErrorCode::kSuccess == mSignalManager->Publish(server.config.challengeSignal, genRes.getObject())) {
+                publishRes = FvmErrorCode::kSuccess;
+            }
+            else {
+                LOGE("Failed publishing an authenticated FV request signal to time server: " << server.config.serverEcuName);
+            }
+        }
+    }
     if (FvmErrorCode::kSuccess == publishRes) {
         mActiveFvChallenge = genRes.getObject();
         mTimeSinceAuthFvReq = 0;
+        mAuthFvRequestTime = mSteadyNow();
+        {
+            std::lock_guard<std::mutex> lock(mRetryInfoMutex);
+            ++mRetryInfo.requests;
+        }
         mFvStateManager->transiteTo(FreshnessValueState::FVInProgress);
     }
     else {
@@ -166,12 +402,102 @@ FreshnessValueManagerImplParticipant::requestAnAuthenticFv() {
     return publishRes;
 }
 
+uint32_t 
+FreshnessValueManagerImplParticipant::nextRequestBackoffMs()
+{
+    std::lock_guard<std::mutex> lock(mRetryInfoMutex);
+    uint32_t backoff = 0;
+    if (mRetryPolicy.enabled && (0U != mRetryInfo.consecutiveRetries)) {
+        // exponential backoff with full jitter, the participants which lost the same server do not retry in lockstep
+        auto const exponent = std::min<uint32_t>(mRetryInfo.consecutiveRetries - 1U, 31U);
+        auto const ceiling = std::min<uint64_t>(static_cast<uint64_t>(mRetryPolicy.baseDelayMs) << exponent, mRetryPolicy.maxDelayMs);
+        backoff = std::uniform_int_distribution<uint32_t>(0U, static_cast<uint32_t>(ceiling))(mRetryRandom);
+    }
+    mRetryInfo.lastBackoffMs = backoff;
+    return backoff;
+}
+
+void 
+FreshnessValueManagerImplParticipant::adoptAuthenticFv(uint64_t fv)
+{
+    using namespace std::chrono;
+    // the server sends the FV right after incrementing it, by now the FV is older by the transmission of the
+    // response and by its wait for this MainFunction. The round trip includes the hold of the challenge until the
+    // server's next FV increment as well (up to an increment period), only a short round trip had hardly any hold
+    // and is taken as twice the transmission
+    auto const now = mSteadyNow();
+    if ((mAuthFvResponseTime >= mAuthFvRequestTime)
+        && ((mAuthFvResponseTime - mAuthFvRequestTime) <= milliseconds(SOK_FM_AUTH_FV_ROUND_TRIP_SAMPLE_MAX_MS))) {
+        mMinAuthFvRoundTrip = std::min(mMinAuthFvRoundTrip, mAuthFvResponseTime - mAuthFvRequestTime);
+    }
+    auto age = (now >= mAuthFvResponseTime) ? (now - mAuthFvResponseTime) : steady_clock::duration::zero();
+    if (steady_clock::duration::max() != mMinAuthFvRoundTrip) {
+        age += mMinAuthFvRoundTrip / 2;
+    }
+    // a response older than the request timeout would have been dropped by the server
+    auto const ageMs = std::min<uint64_t>(static_cast<uint64_t>(duration_cast<milliseconds>(age).count()), SOK_FM_TIME_REQUEST_TIMEOUT_MS);
+
+    mFV = fv + (ageMs / SOK_FM_TIME_INCREMENT_PERIOD_MS);
+    mIsFvValid = true;
+    mClockCount = static_cast<uint32_t>(ageMs % SOK_FM_TIME_INCREMENT_PERIOD_MS);
+    resetClockSlew();
+    publishFvState(true);
+    LOGD("Authentic FV adopted with a phase of " << ageMs << " ms");
+}
+
+void 
+FreshnessValueManagerImplParticipant::slewClock()
+{
+    // the clock is advanced or held back by a millisecond at a time, the server's clock is never overtaken by
+    // more than the slew rate allows
+    mSlewRemainderUs += (SOK_FM_MAIN_FUNCTION_PERIOD_MS * mSlewPpm) / 1000.0;
+    if (1000.0 <= mSlewRemainderUs) {
+        mSlewRemainderUs -= 1000.0;
+        mSlewAppliedUs += 1000;
+        ++mClockCount;
+        if (SOK_FM_TIME_INCREMENT_PERIOD_MS <= mClockCount) {
+            mClockCount -= SOK_FM_TIME_INCREMENT_PERIOD_MS;
+            mFV++;
+        }
+        publishFvState(false);
+    }
+    else if ((-1000.0 >= mSlewRemainderUs) && (0U < mClockCount)) {
+        mSlewRemainderUs += 1000.0;
+        mSlewAppliedUs -= 1000;
+        --mClockCount;
+        publishFvState(false);
+    }
+}
+
+void 
+FreshnessValueManagerImplParticipant::resetClockSlew()
+{
+    // the offsets measured so far refer to the clock before it was set
+    mDriftEstimator.Reset();
+    mSlewPpm = 0.0;
+    mSlewRemainderUs = 0.0;
+    mSlewAppliedUs = 0;
+}
+
+FvmFvRequestRetryInfo 
+FreshnessValueManagerImplParticipant::GetFvRequestRetryInfo() const
+{
+    std::lock_guard<std::mutex> lock(mRetryInfoMutex);
+    return mRetryInfo;
+}
+
 FvmErrorCode 
 FreshnessValueManagerImplParticipant::waitForAnAuthenticFv() {
    
     mTimeSinceAuthFvReq += SOK_FM_MAIN_FUNCTION_PERIOD_MS;
 
     if (mTimeSinceAuthFvReq > SOK_FM_TIME_REQUEST_TIMEOUT_MS) {
+        {
+            std::lock_guard<std::mutex> lock(mRetryInfoMutex);
+            ++mRetryInfo.timeouts;
+            ++mRetryInfo.consecutiveRetries;
+        }
+        mRequestBackoffMs = nextRequestBackoffMs();
         std::lock_guard<std::mutex> lock(mRecFVMutex);
         mFvStateManager->transiteTo(FreshnessValueState::RequestFV);
     }
@@ -183,29 +509,60 @@ FvmErrorCode
 FreshnessValueManagerImplParticipant::processAnAuthenticFv() {
     
     std::lock_guard<std::mutex> lock(mRecFVMutex);
-    LOGI("Processing an authentic FV:" << common::ByteVectorToUint<uint64_t>(mCrAuthFvAndMac.first) << ", mac: " << common::ByteVectorToUint<uint64_t>(mCrAuthFvAndMac.second));
+    // the first response which verifies is taken over, the server of the authenticated FV signals is checked first
+    bool verified = verifyAnAuthenticFv(mEcuKeyIdForFvDistribution, mCrAuthFvAndMac);
+    for (size_t i = 0; (!verified) && (i < mRedundantTimeServers.size()); ++i) {
+        auto& server = mRedundantTimeServers[i];
+        verified = verifyAnAuthenticFv(server.config.keyId, server.authFvAndMac);
+        if (verified) {
+            LOGI("The authentic freshness-value was taken over from time server: " << server.config.serverEcuName);
+        }
+    }
+
+    if (verified) {
+        {
+            std::lock_guard<std::mutex> lock(mRetryInfoMutex);
+            mRetryInfo.consecutiveRetries = 0;
+        }
+        // the late responses of the other servers answer the same challenge
+        for (auto&& server : mRedundantTimeServers) {
+            server.authFvAndMac.first.clear();
+            server.authFvAndMac.second.clear();
+        }
+        mFvStateManager->transiteTo(FreshnessValueState::Idle);
+    }
+    else {
+        mFvStateManager->transiteTo(FreshnessValueState::FVInProgress);
+    }
+    
+    return FvmErrorCode::kSuccess;
+}
+
+bool 
+FreshnessValueManagerImplParticipant::verifyAnAuthenticFv(uint16_t keyId, std::pair<std::vector<uint8_t>, std::vector<uint8_t>>& authFvAndMac)
+{
+    if (authFvAndMac.first.empty() || authFvAndMac.second.empty()) {
+        return false;
+    }
+    LOGI("Processing an authentic FV:" << common::ByteVectorToUint<uint64_t>(authFvAndMac.first) << ", mac: " << common::ByteVectorToUint<uint64_t>(authFvAndMac.second));
     // todo: assuming that the signature is calculated over - challenge + auth FV. needs verification!!
     
     auto payloadForVerification = mActiveFvChallenge;
-    payloadForVerification.insert(payloadForVerification.end(), mCrAuthFvAndMac.first.begin() + 1, mCrAuthFvAndMac.first.end());
-    auto verifyRes = mCsmAccessor->MacVerify(mEcuKeyIdForFvDistribution, payloadForVerification, mCrAuthFvAndMac.second, common::MacAlgorithm::kAes128Cmac);
+    payloadForVerification.insert(payloadForVerification.end(), authFvAndMac.first.begin() + 1, authFvAndMac.first.end());
+    auto verifyRes = mCsmAccessor->MacVerify(keyId, payloadForVerification, authFvAndMac.second, common::MacAlgorithm::kAes128Cmac);
     
-    if (common::CsmErrorCode::kSuccess == verifyRes) {
-        mFV = common::ByteVectorToUint<uint64_t>(mCrAuthFvAndMac.first);
-        mIsFvValid = true;
-        mClockCount = 0;
+    bool verified = (common::CsmErrorCode::kSuccess == verifyRes);
+    if (verified) {
+        adoptAuthenticFv(common::ByteVectorToUint<uint64_t>(authFvAndMac.first));
         LOGI("An authentic freshness-value distribution was completed successfully, The updated FV is:" << mFV);
-        mFvStateManager->transiteTo(FreshnessValueState::Idle);
     } 
     else {
         LOGE("Failed to verify the authentice freshness-value");
-        mFvStateManager->transiteTo(FreshnessValueState::FVInProgress);
     }
     
-    mCrAuthFvAndMac.first.clear();
-    mCrAuthFvAndMac.second.clear();
-    
-    return FvmErrorCode::kSuccess;
+    authFvAndMac.first.clear();
+    authFvAndMac.second.clear();
+    return verified;
 }
 
 FvmErrorCode 
@@ -223,14 +580,127 @@ FreshnessValueManagerImplParticipant::processAnUnauthenticFv() {
         LOGI("Calculated exceeded jitter from un-authenticated FV broadcast. jitter: " << std::abs(jitter));
         mIsFvValid = false;
         mUnAuthFv.clear();
+        resetClockSlew();
+        publishFvState(true);
         mFvStateManager->transiteTo(FreshnessValueState::RequestFV);
     } else {
+        // the server broadcasts right after an FV increment, a late broadcast would distort the estimate
+        int64_t const offsetMs = (static_cast<int64_t>(unauthFv - mFV) * SOK_FM_TIME_INCREMENT_PERIOD_MS) - static_cast<int64_t>(mClockCount);
+        if (SOK_FM_TIME_JITTER_MAX_MS >= std::abs(offsetMs)) {
+            mDriftEstimator.AddSample(mTimeSinceInit, (offsetMs * 1000) + mSlewAppliedUs);
+        }
+        if (mDriftEstimator.IsValid()) {
+            // the drift is followed, and the remaining offset is slewed away over SOK_FM_SLEW_HORIZON_MS
+            double const offsetUs = mDriftEstimator.OffsetUs(mTimeSinceInit) - static_cast<double>(mSlewAppliedUs);
+            double const slewPpm = mDriftEstimator.DriftPpm() + ((offsetUs * 1000.0) / SOK_FM_SLEW_HORIZON_MS);
+            mSlewPpm = std::max(-static_cast<double>(SOK_FM_MAX_SLEW_PPM), std::min(slewPpm, static_cast<double>(SOK_FM_MAX_SLEW_PPM)));
+            LOGD("Estimated clock drift: " << mDriftEstimator.DriftPpm() << " ppm, slewing at: " << mSlewPpm << " ppm");
+        }
         mFvStateManager->transiteTo(FreshnessValueState::Idle);
     }
 
     return FvmErrorCode::kSuccess;
 }
 
+FvmErrorCode 
+FreshnessValueManagerImplParticipant::processGroupFv() {
+    std::lock_guard<std::mutex> lock(mRecGroupFvMutex);
+    if (mGroupFvMessage.size() != GROUP_FV_BROADCAST_LENGTH_BYTES) {
+        mFvStateManager->transiteTo(mIsFvValid ? FreshnessValueState::Idle : FreshnessValueState::RequestFV);
+        return FvmErrorCode::kSuccess;
+    }
+    auto const macBegin = mGroupFvMessage.end() - AUTH_FV_SIGNATURE_SIZE_BYTES;
+    std::vector<uint8_t> signedData(mGroupFvMessage.begin(), macBegin);
+    std::vector<uint8_t> mac(macBegin, mGroupFvMessage.end());
+    mGroupFvMessage.clear();
+
+    auto nonce = common::ByteVectorToUint<uint64_t>(std::vector<uint8_t>(signedData.begin(), signedData.begin() + GROUP_FV_NONCE_LENGTH_BYTES));
+    auto fv = common::ByteVectorToUint<uint64_t>(std::vector<uint8_t>(signedData.begin() + GROUP_FV_NONCE_LENGTH_BYTES, signedData.end()));
+    auto session = static_cast<uint32_t>(nonce >> 32U);
+    auto counter = static_cast<uint32_t>(nonce);
+
+    if (common::CsmErrorCode::kSuccess != mCsmAccessor->MacVerify(mGroupFvBroadcast.keyId, signedData, mac, common::MacAlgorithm::kAes128Cmac)) {
+        LOGE("Failed to verify the group freshness-value, falling back to challenge-response");
+        mFvStateManager->transiteTo(FreshnessValueState::RequestFV);
+        return FvmErrorCode::kSuccess;
+    }
+
+    if (mGroupSessionKnown && (session == mGroupSession)) {
+        if (counter <= mGroupNonceFloor) {
+            LOGE("Ignoring a replayed group freshness-value, nonce counter: " << counter);
+            mFvStateManager->transiteTo(mIsFvValid ? FreshnessValueState::Idle : FreshnessValueState::RequestFV);
+            return FvmErrorCode::kSuccess;
+        }
+    }
+    // a new server session is trusted only once its FV matches the FV authenticated by challenge-response
+    else if (mIsFvValid && ((fv + 1U) >= mFV) && (fv <= (mFV + 1U))) {
+        LOGI("Adopting the group freshness-value session: " << session);
+        mGroupSessionKnown = true;
+        mGroupSession = session;
+    }
+    else {
+        LOGI("Group freshness-value of an unknown server session, requesting an authentic freshness-value");
+        mFvStateManager->transiteTo(FreshnessValueState::RequestFV);
+        return FvmErrorCode::kSuccess;
+    }
+
+    mGroupNonceFloor = counter;
+    mFV = fv;
+    mIsFvValid = true;
+    mClockCount = 0;
+    resetClockSlew();
+    publishFvState(true);
+    LOGD("A group authenticated freshness-value was accepted, The updated FV is:" << mFV);
+    mFvStateManager->transiteTo(FreshnessValueState::Idle);
+    return FvmErrorCode::kSuccess;
+}
+
+void 
+FreshnessValueManagerImplParticipant::postSignalProcessing()
+{
+    if (!mExecutor) {
+        return;
+    }
+    // a rejected task is not lost, the state is processed by the next MainFunction
+    if (!mExecutor->Post([this]() { this->processSignalsOnExecutor(); })) {
+        LOGW("FVM executor is busy, the FV signal is processed by the next MainFunction");
+    }
+}
+
+void 
+FreshnessValueManagerImplParticipant::processSignalsOnExecutor()
+{
+    std::lock_guard<std::mutex> processingLock(mProcessingMutex);
+    if (!mInitialized) {
+        return;
+    }
+    // only the processing of received signals, the time based states are left to the MainFunction
+    auto const state = mFvStateManager->currentState();
+    if ((FreshnessValueState::ProcessFV != state) && (FreshnessValueState::ProcessAnauthFV != state)
+        && (FreshnessValueState::ProcessGroupFV != state)) {
+        return;
+    }
+
+    uint64_t cachedFv = mFV;
+    if (FvmErrorCode::kSuccess != mFvStateManager->enter()) {
+        LOGE("Failed processing the received FV signal");
+    }
+    if (mRelay && mIsFvValid && (mFV != cachedFv)) {
+        relayAuthenticFvResponses();
+    }
+    if (FvmErrorCode::kSuccess != mSignalManager->Flush()) {
+        LOGE("Failed transmitting the signals of the FV signal processing");
+    }
+}
+
+FvmErrorCode 
+FreshnessValueManagerImplParticipant::relayAuthenticFvResponses()
+{
+    // only an authenticated FV is relayed, challenges arriving meanwhile wait for it or expire
+    bool const deferred = mRelay->SendResponses(mFV, mTimeSinceInit);
+    mNeedToRelayResponses = deferred && ((mClockCount + SOK_FM_MAIN_FUNCTION_PERIOD_MS) < SOK_FM_TIME_JITTER_MAX_MS);
+    return FvmErrorCode::kSuccess;
+}
 
 } // namespace fvm 
 } // namespace sok
\ No newline at end of file
@@ -1,7 +1,9 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include "sok/fvm/FreshnessValueManagerImplServer.hpp"
+#include <algorithm>
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/SokFmInternalFactory.hpp"
 #include "sok/common/SokUtilities.hpp"
 #include "sok/common/Logger.hpp"
 
@@ -10,12 +12,26 @@ namespace sok
 namespace fvm
 {
 FreshnessValueManagerImplServer::FreshnessValueManagerImplServer()
-: AFreshnessValueManagerImpl()
-, mChallengesMutex()
+: FreshnessValueManagerImplServer(FvmDependencies())
+{}
+
+FreshnessValueManagerImplServer::FreshnessValueManagerImplServer(std::shared_ptr<ISignalManager> signalManager)
+: FreshnessValueManagerImplServer(FvmDependencies{nullptr, std::move(signalManager), nullptr, nullptr, nullptr, 0U})
+{}
+
+FreshnessValueManagerImplServer::FreshnessValueManagerImplServer(FvmDependencies dependencies)
+: AFreshnessValueManagerImpl(std::move(dependencies))
 , mNeedToSendAuthFvResponses(false)
 , mNeedToBroadcastFv(true)
-, mResponsePendingChallenges()
-, mClientConfigMap()
+, mLastFvBroadcastMs(0)
+, mResponder()
+, mGroupFvBroadcast()
+, mNeedToBroadcastGroupFv(false)
+, mLastGroupBroadcastMs(0)
+, mGroupNonce(0)
+, mFvCheckpoint()
+, mLastFvCheckpointMs(0)
+, mFvReservation(0)
 {}
 
 FvmErrorCode
@@ -34,6 +50,13 @@ FreshnessValueManagerImplServer::MainFunction() noexcept
             }
         }
 
+        if (mNeedToBroadcastGroupFv) {
+            auto actionRet = groupAuthenticatedBroadcast();
+            if (FvmErrorCode::kSuccess != actionRet) {
+                ret = actionRet;
+            }
+        }
+
         if (mNeedToSendAuthFvResponses) {
             auto actionRet = sendAuthenticFvResponses();
             if (FvmErrorCode::kSuccess != actionRet) {
@@ -43,12 +66,26 @@ FreshnessValueManagerImplServer::MainFunction() noexcept
 
         uint64_t cachedFv = mFV;
         incTimers();
+        updateChallengeClock();
+        if (mFvCheckpoint && (((mTimeSinceInit - mLastFvCheckpointMs) >= SOK_FM_FV_CHECKPOINT_PERIOD_MS) || isFvReservationDue())) {
+            storeFvCheckpoint();
+        }
         if (mFV != cachedFv) {
             mNeedToSendAuthFvResponses = true;
+            // the broadcasts are sent right after an FV increment like the responses, the participants estimate
+            // their offset from the unauthenticated one and take over the FV period from the group authenticated one
+            if ((mTimeSinceInit - mLastFvBroadcastMs) >= SOK_FM_TIME_SEND_MS) {
+                mNeedToBroadcastFv = true;
+            }
+            if (mGroupFvBroadcast.enabled && ((mTimeSinceInit - mLastGroupBroadcastMs) >= mGroupFvBroadcast.periodMs)) {
+                mNeedToBroadcastGroupFv = true;
+            }
         }
 
-        if ((mTimeSinceInit % SOK_FM_TIME_SEND_MS) == 0) {
-            mNeedToBroadcastFv = true;
+        // transmits the signals collected during this cycle in case transmit batching is enabled
+        auto flushRet = mSignalManager->Flush();
+        if (FvmErrorCode::kSuccess != flushRet) {
+            ret = flushRet;
         }
         return ret;
     } catch (std::exception const& ex) {
@@ -75,27 +112,31 @@ FreshnessValueManagerImplServer::serverOrParticipantInit() noexcept
         randomBytes.insert(randomBytes.begin(), {0});
         mFV = common::ByteVectorToUint<uint64_t>(randomBytes);
         mIsFvValid = true;
+        restoreFvCheckpoint();
+        // a restored FV is in the middle of its increment period, its first broadcast waits for an FV increment
+        mNeedToBroadcastFv = (0U == mClockCount);
+        mLastFvBroadcastMs = mTimeSinceInit;
 
-        auto AuthFvChallengeCb = [this](std::string const& signal, std::vector<uint8_t> const& challenge) {
-            this->incomingAuthFvChallengeSignalsCb(signal, challenge);
-        };
-        
-        mClientConfigMap = mFvmConfAccessor->GetClientsConfigMap();
-
-        for (auto&& client : mClientConfigMap) {
-            if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(client.second.keyId)) {
-                LOGE("Couldn't find key id: " << client.second.keyId << ", for authentic FV distribution with ECU: " << client.first);
+        mGroupFvBroadcast = mFvmConfAccessor->GetGroupFvBroadcastConfig();
+        if (mGroupFvBroadcast.enabled) {
+            if (common::CsmErrorCode::kSuccess != mCsmAccessor->IsKeyExists(mGroupFvBroadcast.keyId)) {
+                LOGE("Couldn't find key id: " << mGroupFvBroadcast.keyId << ", for the group FV broadcast");
                 return false;
             }
-            LOGD("Server subscribing for participant: "<< client.first << " incoming FV challenge signal: " << client.second.clientChallengeSignal.name);
-            // register for signals
-            auto ret = mSignalManager->Subscribe(client.second.clientChallengeSignal, AuthFvChallengeCb);
-            if (FvmErrorCode::kSuccess != ret) {
-                LOGE("Failed subscribing for incoming challenge signal: " << client.second.clientChallengeSignal.name)
+            // a new session per server start, so that the participants can tell a restart from a replay
+            auto sessionRes = mCsmAccessor->GenerateRandomBytes(GROUP_FV_NONCE_LENGTH_BYTES / 2U);
+            if (sessionRes.isFailed()) {
+                LOGE("Failed generating random number for the group FV broadcast session");
                 return false;
             }
-            // store name & key ID 
-            mClientNameToKeyId[client.first] = client.second.keyId;
+            mGroupNonce = common::ByteVectorToUint<uint64_t>(sessionRes.getObject()) << 32U;
+            mLastGroupBroadcastMs = mTimeSinceInit;
+        }
+
+        mResponder.reset(new AuthenticFvResponder(mCsmAccessor, mSignalManager));
+        if (!mResponder->Init(mFvmConfAccessor->GetClientsConfigMap(), mTimeSinceInit)) {
+            LOGE("Failed initializing the authentic FV distribution to the participants");
+            return false;
         }
 
         return true;
@@ -108,22 +149,93 @@ FreshnessValueManagerImplServer::serverOrParticipantInit() noexcept
     }
 }
 
+std::vector<SignalConfig>
+FreshnessValueManagerImplServer::serverOrParticipantOutgoingSignals() noexcept
+{
+    std::vector<SignalConfig> ret;
+    try {
+        ret.push_back(mFvmConfAccessor->GetUnauthenticatedFvSignalConfig());
+        if (mGroupFvBroadcast.enabled) {
+            ret.push_back(mGroupFvBroadcast.signal);
+        }
+        if (mResponder) {
+            auto responseSignals = mResponder->OutgoingSignals();
+            ret.insert(ret.end(), responseSignals.begin(), responseSignals.end());
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+    return ret;
+}
+
+std::vector<FvmClientHealthRecord> 
+FreshnessValueManagerImplServer::GetClientHealth() const
+{
+    if (!mResponder) {
+        return std::vector<FvmClientHealthRecord>();
+    }
+    return mResponder->GetClientHealth();
+}
+
 void 
-FreshnessValueManagerImplServer::incomingAuthFvChallengeSignalsCb(std::string const& signal, std::vector<uint8_t> const& challenge)
+FreshnessValueManagerImplServer::updateChallengeClock()
 {
-    static const std::regex regex("SOK_Zeit_(\\w+)_Challenge");
-    std::smatch match;
-    if ((false == std::regex_search(signal.begin(), signal.end(), match, regex)) || (match.size() != 2)) {
-        LOGE("invalid challenge signal received");
+    if (mResponder) {
+        mResponder->UpdateClock(mTimeSinceInit);
+    }
+}
+
+void 
+FreshnessValueManagerImplServer::restoreFvCheckpoint()
+{
+    mFvCheckpoint.reset();
+    auto checkpointFile = mFvmConfAccessor->GetFvCheckpointFile();
+    if (checkpointFile.empty()) {
+        return;
+    }
+    auto checkpoint = std::unique_ptr<FvCheckpoint>(new FvCheckpoint());
+    if (FvmErrorCode::kSuccess != checkpoint->Open(checkpointFile)) {
+        LOGW("FV checkpoint is not available, starting from a random freshness value");
         return;
     }
-    if (mClientNameToKeyId.end() == mClientNameToKeyId.find(match[1])) {
-        LOGE("Challenge received from unsupported client: " << std::string(match[1]));
+    auto restoreRes = checkpoint->Restore(FvCheckpoint::Now());
+    if (!restoreRes.isFailed()) {
+        mFV = restoreRes.getObject().fv;
+        mClockCount = restoreRes.getObject().phaseMs;
+        LOGI("Continuing from the FV checkpoint, freshness value: " << mFV << ", phase: " << mClockCount << " ms");
+    }
+    mFvCheckpoint = std::move(checkpoint);
+    // a new reservation is synced right away, blocking Init only, so that a restart loop keeps the FV monotonic as well
+    mFvReservation = 0;
+    storeFvCheckpoint();
+    if (FvmErrorCode::kSuccess != mFvCheckpoint->Sync()) {
+        LOGE("Failed syncing the FV reservation, it is retried in the background");
+    }
+}
+
+bool 
+FreshnessValueManagerImplServer::isFvReservationDue() const
+{
+    // renewed ahead, half a reservation of FV increments is left for syncing it in the background
+    return (mFV + (SOK_FM_FV_CHECKPOINT_MARGIN / 2U)) >= mFvReservation;
+}
+
+void 
+FreshnessValueManagerImplServer::storeFvCheckpoint()
+{
+    mLastFvCheckpointMs = mTimeSinceInit;
+    if (mFV >= mFvCheckpoint->DurableReservedFv()) {
+        LOGE("The freshness value: " << mFV << " is not covered by a synced reservation");
+    }
+    auto reservation = isFvReservationDue() ? (mFV + SOK_FM_FV_CHECKPOINT_MARGIN) : mFvReservation;
+    if (FvmErrorCode::kSuccess != mFvCheckpoint->Store(FvCheckpointState{mFV, reservation, mClockCount}, FvCheckpoint::Now())) {
+        LOGE("Failed storing the FV checkpoint");
         return;
     }
-    std::lock_guard<std::mutex> lock(mChallengesMutex);
-    mResponsePendingChallenges[match[1]] = challenge;
-}   
+    mFvReservation = reservation;
+}
 
 FvmErrorCode 
 FreshnessValueManagerImplServer::unauthenticatedBroadcast()
@@ -135,42 +247,45 @@ FreshnessValueManagerImplServer::unauthenticatedBroadcast()
     else {
         LOGD("Published un-authenticated FV: " << mFV);
         mNeedToBroadcastFv = false;
+        mLastFvBroadcastMs = mTimeSinceInit;
     }
     return res;
 }
 
 FvmErrorCode 
-FreshnessValueManagerImplServer::sendAuthenticFvResponses()
+FreshnessValueManagerImplServer::groupAuthenticatedBroadcast()
 {
-    std::lock_guard<std::mutex> lock(mChallengesMutex);
-    for (auto&& challengeEntry : mResponsePendingChallenges) {
-        auto serializedFv = common::UintToByteVectorTrim<uint64_t>(mFV, FVM_SERVER_NUM_OF_BYTES_INITIAL_FV);
-        auto data = challengeEntry.second;
-        // todo: assuming that the signature is calculated over - challenge + auth FV. needs verification!!
-        data.insert(data.end(), serializedFv.begin(), serializedFv.end());
-        LOGD("creating authenticator for challenge from ECU: " << challengeEntry.first);
-        auto macRes = mCsmAccessor->MacCreate(mClientNameToKeyId[challengeEntry.first], data, common::MacAlgorithm::kAes128Cmac);
-        if (macRes.isFailed()) {
-            LOGE("Failed creating MAC for response to FV request from ECU: " << challengeEntry.first);
-            continue;
-        }
+    mNeedToBroadcastGroupFv = false;
+    mLastGroupBroadcastMs = mTimeSinceInit;
+    ++mGroupNonce;
 
-        std::vector<uint8_t> macRes8Byte(macRes.getObject().begin(),macRes.getObject().begin() + AUTH_FV_SIGNATURE_SIZE_BYTES);
-        LOGD("Sending FV: " << mFV << ", mac: " << common::ByteVectorToUint<uint64_t>(macRes8Byte))
-        if (FvmErrorCode::kSuccess != mSignalManager->Publish(mClientConfigMap[challengeEntry.first].clientResponseValueSignal, serializedFv)) {
-            LOGE("Failed sending FV signal to ECU: " << challengeEntry.first);
-            continue;
-        }
+    auto message = common::UintToByteVector<uint64_t>(mGroupNonce);
+    auto serializedFv = common::UintToByteVectorTrim<uint64_t>(mFV, FVM_SERVER_NUM_OF_BYTES_INITIAL_FV);
+    message.insert(message.end(), serializedFv.begin(), serializedFv.end());
+    auto macRes = mCsmAccessor->MacCreate(mGroupFvBroadcast.keyId, message, common::MacAlgorithm::kAes128Cmac);
+    if (macRes.isFailed() || (macRes.getObject().size() < static_cast<size_t>(AUTH_FV_SIGNATURE_SIZE_BYTES))) {
+        LOGE("Failed creating MAC for the group FV broadcast");
+        return FvmErrorCode::kGeneralError;
+    }
+    message.insert(message.end(), macRes.getObject().begin(), macRes.getObject().begin() + AUTH_FV_SIGNATURE_SIZE_BYTES);
 
-        std::string signatureSignal = "SOK_Zeit_" + challengeEntry.first + "_Signature";
-        if (FvmErrorCode::kSuccess != mSignalManager->Publish(mClientConfigMap[challengeEntry.first].clientResponseSignatureSignal, macRes8Byte)) {
-            LOGE("Failed sending signature signal to ECU: " << challengeEntry.first);
-            continue;
-        }
-        LOGI("Sent FV and signature signals to ECU: " << challengeEntry.first << " successfully");
+    auto res = mSignalManager->Publish(mGroupFvBroadcast.signal, message);
+    if (FvmErrorCode::kSuccess != res) {
+        LOGE("Failed broadcasting the group authenticated freshness value");
     }
-    mResponsePendingChallenges.clear();
-    mNeedToSendAuthFvResponses = false;
+    else {
+        LOGD("Published group authenticated FV: " << mFV << ", nonce: " << mGroupNonce);
+    }
+    return res;
+}
+
+FvmErrorCode 
+FreshnessValueManagerImplServer::sendAuthenticFvResponses()
+{
+    // a participant starts counting the FV period at the reception of the response, a response round is
+    // continued in the next cycles only as long as that offset stays within the allowed jitter
+    bool const deferred = mResponder->SendResponses(mFV, mTimeSinceInit);
+    mNeedToSendAuthFvResponses = deferred && ((mClockCount + SOK_FM_MAIN_FUNCTION_PERIOD_MS) < SOK_FM_TIME_JITTER_MAX_MS);
     return FvmErrorCode::kSuccess;
 }
 
@@ -8,105 +8,123 @@ namespace sok
 namespace fvm
 {
 
-FreshnessValueStateManager::FreshnessValueStateManager() : mFvActions(), mCurrentFvState(nullptr) 
+namespace
+{
+
+// the current state before the first transition
+constexpr FreshnessValueState NO_STATE = static_cast<FreshnessValueState>(0xFFU);
+
+static_assert(FRESHNESS_VALUE_STATE_COUNT < 0xFFU, "NO_STATE must not be a state");
+
+constexpr FreshnessValueState P = FreshnessValueState::ProcessFV;
+constexpr FreshnessValueState U = FreshnessValueState::ProcessAnauthFV;
+constexpr FreshnessValueState G = FreshnessValueState::ProcessGroupFV;
+// the event is ignored in this state
+constexpr FreshnessValueState X = NO_STATE;
+
+// the state a received signal moves to, per event and current state
+constexpr FreshnessValueState TRANSITIONS[FRESHNESS_VALUE_EVENT_COUNT][FRESHNESS_VALUE_STATE_COUNT] = {
+    //                     RequestFV  FVInProgress  ProcessFV  ProcessAnauthFV  ProcessGroupFV  Idle
+    /* AuthenticFv   */  { X,         P,            X,         X,               X,              X },
+    /* UnauthenticFv */  { X,         X,            X,         X,               X,              U },
+    /* GroupFv       */  { G,         X,            X,         X,               X,              G },
+};
+
+constexpr char const* STATE_NAMES[FRESHNESS_VALUE_STATE_COUNT] = {
+    "RequestFV", "FVInProgress", "ProcessFV", "ProcessAnauthFV", "ProcessGroupFV", "Idle"
+};
+
+constexpr char const* EVENT_NAMES[FRESHNESS_VALUE_EVENT_COUNT] = {
+    "authentic freshness-value", "unauthentic freshness-value", "group freshness-value"
+};
+
+} // namespace
+
+FreshnessValueStateManager::FreshnessValueStateManager() : mFvActions(), mCurrentFvState(NO_STATE), mEnteredFvState(NO_STATE) 
 {
 }
 
 FvmErrorCode FreshnessValueStateManager::enter() {
 
-    auto ret = FvmErrorCode::kGeneralError;
-
-    if (!mCurrentFvState){ 
+    auto const state = mCurrentFvState.load();
+    if (NO_STATE == state) { 
         LOGE("The current state is unitialized");
+        return FvmErrorCode::kGeneralError;
     }
-    else {
-        auto found = mFvActions.find(*mCurrentFvState);
-        if (found != mFvActions.end()) {
-            auto stateAction = found->second;
-            if (stateAction) {
-                ret = stateAction();
-            } else {
-                LOGE("The action function of this state is not valid");
-            }
-        }
-    } 
-    return ret;
+
+    auto const& stateAction = mFvActions[static_cast<size_t>(state)];
+    if (!stateAction) {
+        LOGE("The action function of this state is not valid");
+        return FvmErrorCode::kGeneralError;
+    }
+    mEnteredFvState = state;
+    auto const result = stateAction();
+    mEnteredFvState = NO_STATE;
+    return result;
 }
 
-void FreshnessValueStateManager::transiteTo(FreshnessValueState const state) {
-    if (mFvActions.find(state) != mFvActions.end()) {
-        std::atomic_store(&mCurrentFvState, std::make_shared<FreshnessValueState>(state));
-    } else {
+bool FreshnessValueStateManager::transiteTo(FreshnessValueState const state) {
+    if ((static_cast<size_t>(state) >= FRESHNESS_VALUE_STATE_COUNT) || !mFvActions[static_cast<size_t>(state)]) {
         LOGE("Unable to transit to an unregistered state"); 
+        return false;
+    }
+    if (NO_STATE == mEnteredFvState) {
+        mCurrentFvState.store(state);
+        return true;
+    }
+    auto expected = mEnteredFvState;
+    if (!mCurrentFvState.compare_exchange_strong(expected, state)) {
+        // the received signal is not overwritten, its state is processed by the next enter()
+        LOGI("The state changed from " << STATE_NAMES[static_cast<size_t>(mEnteredFvState)] << " to " << STATE_NAMES[static_cast<size_t>(expected)]
+             << ", dropping the transition to " << STATE_NAMES[static_cast<size_t>(state)]);
+        return false;
     }
+    // a further transition of the same action starts from here
+    mEnteredFvState = state;
+    return true;
 }
 
 void FreshnessValueStateManager::registerState(FreshnessValueState const state, StateAction const& action) {
-    mFvActions.emplace(std::make_pair(state, action));
+    if (static_cast<size_t>(state) < FRESHNESS_VALUE_STATE_COUNT) {
+        mFvActions[static_cast<size_t>(state)] = action;
+    }
 }
 
-void FreshnessValueStateManager::reactToFVRes() {
-   
-    if (!mCurrentFvState) {
-        LOGE("The current state is not initialized");
-        return;
-    }
+FreshnessValueState FreshnessValueStateManager::currentState() const {
+    auto const state = mCurrentFvState.load();
+    return (NO_STATE == state) ? FreshnessValueState::RequestFV : state;
+}
 
-    switch (*mCurrentFvState)
-    {
-    case FreshnessValueState::FVInProgress:
-        transiteTo(FreshnessValueState::ProcessFV);
-        break;
-
-    case FreshnessValueState::ProcessFV:
-        LOGE("An authentic freshness-value has already been received and waits to be processed");
-        break;
-
-    case FreshnessValueState::ProcessAnauthFV:
-    case FreshnessValueState::Idle:
-    case FreshnessValueState::RequestFV:
-        LOGE("An authentic freshness-value received without a request");
-        break;
-    
-    default:
-        LOGE("FATAL DEVELOPMENT ERROR: The current state is not recognized by this function. Apparently the function is not updated.")
-        break;
-    }
+void FreshnessValueStateManager::reactToFVRes() {
+    react(FreshnessValueEvent::AuthenticFvReceived);
 }
 
 void FreshnessValueStateManager::reactToUnauthenticFVRes() {
-   
-    if (!mCurrentFvState) {
-        LOGE("The current state is not initialized");
-        return;
-    }
+    react(FreshnessValueEvent::UnauthenticFvReceived);
+}
 
-    switch (*mCurrentFvState)
-    {
-    case FreshnessValueState::RequestFV:
-        LOGI("Ignore this unauthentic freshness-value because a valid authentic freshness-value does not yet exist");
-        break;
-
-    case FreshnessValueState::FVInProgress:
-        LOGI("Ignore this unauthentic freshness-value because a valid authentic freshness-value is on the way");
-        break;
-
-    case FreshnessValueState::ProcessFV:
-        LOGI("Ignore this unauthentic freshness-value because a valid authentic freshness-value is now processed");
-        break;
-
-    case FreshnessValueState::Idle:
-        transiteTo(FreshnessValueState::ProcessAnauthFV);
-        break;
-
-    case FreshnessValueState::ProcessAnauthFV:
-        LOGI("Ignore this unauthentic freshness-value because another unauthentic freshness-value is now processed");
-        break;
-    
-    default:
-        LOGE("FATAL DEVELOPMENT ERROR: The current state is not recognized by this function. Apparently the function is not updated.")
-        break;
-    }
+void FreshnessValueStateManager::reactToGroupFVRes() {
+    react(FreshnessValueEvent::GroupFvReceived);
+}
+
+void FreshnessValueStateManager::react(FreshnessValueEvent const event) {
+
+    auto state = mCurrentFvState.load();
+    do {
+        if (NO_STATE == state) {
+            LOGE("The current state is not initialized");
+            return;
+        }
+        auto const target = TRANSITIONS[static_cast<size_t>(event)][static_cast<size_t>(state)];
+        if ((X == target) || !mFvActions[static_cast<size_t>(target)]) {
+            LOGI("Ignore this " << EVENT_NAMES[static_cast<size_t>(event)] << " in state " << STATE_NAMES[static_cast<size_t>(state)]);
+            return;
+        }
+        // on failure state is reloaded, the event is judged again against the state another thread moved to
+        if (mCurrentFvState.compare_exchange_weak(state, target)) {
+            return;
+        }
+    } while (true);
 }
 
 } // namespace fvm 
@@ -0,0 +1,311 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvCheckpoint.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+constexpr char CHECKPOINT_MAGIC[8] = {'S', 'O', 'K', 'F', 'V', 'C', 'P', '\0'};
+constexpr uint32_t CHECKPOINT_FORMAT_VERSION = 3;
+constexpr size_t CHECKPOINT_NUM_OF_RECORDS = 2;
+constexpr char BOOT_ID_PATH[] = "/proc/sys/kernel/random/boot_id";
+
+} // namespace
+
+struct FvCheckpointRecord {
+    uint64_t sequence;      // 0 for a record which was never written
+    uint64_t fv;
+    uint64_t reservedFv;
+    uint64_t phaseMs;
+    uint64_t bootId;
+    uint64_t timeMs;
+    uint64_t checksum;
+};
+
+struct FvCheckpointFile {
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint32_t version;
+    uint32_t padding;
+    FvCheckpointRecord records[CHECKPOINT_NUM_OF_RECORDS];
+};
+
+namespace
+{
+
+// FNV-1a over the fields of the record, the checksum field excluded
+uint64_t
+recordChecksum(FvCheckpointRecord const& record)
+{
+    uint64_t const fields[] = {record.sequence, record.fv, record.reservedFv, record.phaseMs, record.bootId, record.timeMs};
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto field : fields) {
+        for (size_t i = 0; i < sizeof(field); ++i) {
+            hash ^= static_cast<uint8_t>(field >> (8U * i));
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+bool
+isValidRecord(FvCheckpointRecord const& record)
+{
+    return (0U != record.sequence) && (recordChecksum(record) == record.checksum);
+}
+
+// the latest valid record, nullptr if there is none
+FvCheckpointRecord const*
+latestRecord(FvCheckpointFile const& file)
+{
+    FvCheckpointRecord const* latest = nullptr;
+    for (auto const& record : file.records) {
+        if (isValidRecord(record) && ((nullptr == latest) || (record.sequence > latest->sequence))) {
+            latest = &record;
+        }
+    }
+    return latest;
+}
+
+uint64_t
+readBootId()
+{
+    std::ifstream bootIdFile(BOOT_ID_PATH);
+    std::string bootId;
+    if (!std::getline(bootIdFile, bootId) || bootId.empty()) {
+        return 0U;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : bootId) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+FvCheckpoint::FvCheckpoint()
+: mFile(nullptr)
+, mSequence(0)
+, mReservedFv(0)
+, mDurableReservedFv(0)
+, mSyncMutex()
+, mSyncCv()
+, mStopSync(false)
+, mSyncThread()
+{
+}
+
+FvCheckpoint::~FvCheckpoint()
+{
+    Close();
+}
+
+FvmErrorCode
+FvCheckpoint::Open(std::string const& path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (-1 == fd) {
+        LOGE("Failed opening FV checkpoint file: " << path << ", errno: " << errno);
+        return FvmErrorCode::kGeneralError;
+    }
+
+    struct stat fileStat {};
+    if (0 != fstat(fd, &fileStat)) {
+        LOGE("Failed reading the size of FV checkpoint file: " << path << ", errno: " << errno);
+        close(fd);
+        return FvmErrorCode::kGeneralError;
+    }
+    bool isNewFile = (static_cast<size_t>(fileStat.st_size) != sizeof(FvCheckpointFile));
+    if (isNewFile && ((0 != ftruncate(fd, static_cast<off_t>(sizeof(FvCheckpointFile)))) || (0 != fsync(fd)))) {
+        LOGE("Failed sizing FV checkpoint file: " << path << ", errno: " << errno);
+        close(fd);
+        return FvmErrorCode::kGeneralError;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(FvCheckpointFile), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapping) {
+        LOGE("Failed mapping FV checkpoint file: " << path << ", errno: " << errno);
+        return FvmErrorCode::kGeneralError;
+    }
+    auto file = static_cast<FvCheckpointFile*>(mapping);
+
+    if (isNewFile || (0 != std::memcmp(file->magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)))
+        || (CHECKPOINT_FORMAT_VERSION != file->version)) {
+        LOGW("FV checkpoint file: " << path << " has no compatible checkpoint, starting a new one");
+        std::memset(file, 0, sizeof(FvCheckpointFile));
+        std::memcpy(file->magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        file->version = CHECKPOINT_FORMAT_VERSION;
+        msync(file, sizeof(FvCheckpointFile), MS_SYNC);
+    }
+
+    mFile = file;
+    auto latest = latestRecord(*mFile);
+    mSequence = (nullptr != latest) ? latest->sequence : 0U;
+    mReservedFv = (nullptr != latest) ? latest->reservedFv : 0U;
+    mDurableReservedFv = mReservedFv;
+    mStopSync = false;
+    mSyncThread = std::thread(&FvCheckpoint::syncLoop, this);
+    return FvmErrorCode::kSuccess;
+}
+
+void
+FvCheckpoint::Close()
+{
+    if (mSyncThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mSyncMutex);
+            mStopSync = true;
+        }
+        mSyncCv.notify_all();
+        mSyncThread.join();
+    }
+    if (nullptr != mFile) {
+        msync(mFile, sizeof(FvCheckpointFile), MS_SYNC);
+        munmap(mFile, sizeof(FvCheckpointFile));
+        mFile = nullptr;
+    }
+}
+
+FvmErrorCode
+FvCheckpoint::Store(FvCheckpointState const& state, FvCheckpointTime const& now)
+{
+    if (nullptr == mFile) {
+        LOGE("FV checkpoint file is not open");
+        return FvmErrorCode::kGeneralError;
+    }
+
+    // the record of the previous Store stays intact until this one is complete
+    auto& record = mFile->records[(mSequence + 1U) % CHECKPOINT_NUM_OF_RECORDS];
+    FvCheckpointRecord update{mSequence + 1U, state.fv, state.reservedFv, state.phaseMs, now.bootId, now.timeMs, 0U};
+    update.checksum = recordChecksum(update);
+    record.checksum = 0U;
+    std::atomic_thread_fence(std::memory_order_release);
+    record = update;
+    ++mSequence;
+
+    {
+        std::lock_guard<std::mutex> lock(mSyncMutex);
+        mReservedFv = state.reservedFv;
+    }
+    if (mReservedFv != mDurableReservedFv) {
+        // the sync blocks on the storage, it is left to the background thread
+        mSyncCv.notify_one();
+        return FvmErrorCode::kSuccess;
+    }
+    // a process crash keeps the page cache, the reservation covers the records lost on a power cut
+    if (0 != msync(mFile, sizeof(FvCheckpointFile), MS_ASYNC)) {
+        LOGW("Failed syncing FV checkpoint file, errno: " << errno);
+    }
+    return FvmErrorCode::kSuccess;
+}
+
+FvmErrorCode
+FvCheckpoint::Sync()
+{
+    if (nullptr == mFile) {
+        LOGE("FV checkpoint file is not open");
+        return FvmErrorCode::kGeneralError;
+    }
+    std::lock_guard<std::mutex> lock(mSyncMutex);
+    if (0 != msync(mFile, sizeof(FvCheckpointFile), MS_SYNC)) {
+        LOGE("Failed syncing the FV reservation to the checkpoint file, errno: " << errno);
+        return FvmErrorCode::kGeneralError;
+    }
+    mDurableReservedFv = mReservedFv;
+    return FvmErrorCode::kSuccess;
+}
+
+uint64_t
+FvCheckpoint::DurableReservedFv() const
+{
+    return mDurableReservedFv;
+}
+
+void
+FvCheckpoint::syncLoop() noexcept
+{
+    try {
+        std::unique_lock<std::mutex> lock(mSyncMutex);
+        while (!mStopSync) {
+            mSyncCv.wait(lock, [this]() { return mStopSync || (mReservedFv != mDurableReservedFv); });
+            if (mStopSync) {
+                break;
+            }
+            // the records stored meanwhile are synced as well, the reservation read before the sync is durable
+            auto const reservedFv = mReservedFv;
+            lock.unlock();
+            int const syncErrno = (0 == msync(mFile, sizeof(FvCheckpointFile), MS_SYNC)) ? 0 : errno;
+            lock.lock();
+            if (0 == syncErrno) {
+                mDurableReservedFv = reservedFv;
+                LOGD("FV reservation: " << reservedFv << " synced to the checkpoint file");
+            }
+            else {
+                LOGE("Failed syncing the FV reservation to the checkpoint file, errno: " << syncErrno);
+                mSyncCv.wait_for(lock, std::chrono::milliseconds(SOK_FM_FV_CHECKPOINT_PERIOD_MS), [this]() { return mStopSync; });
+            }
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
+
+FvmResult<FvCheckpointState>
+FvCheckpoint::Restore(FvCheckpointTime const& now) const
+{
+    if (nullptr == mFile) {
+        LOGE("FV checkpoint file is not open");
+        return FvmResult<FvCheckpointState>(FvmErrorCode::kGeneralError);
+    }
+    auto latest = latestRecord(*mFile);
+    if (nullptr == latest) {
+        LOGI("FV checkpoint file holds no valid checkpoint");
+        return FvmResult<FvCheckpointState>(FvmErrorCode::kGeneralError);
+    }
+
+    if ((0U != now.bootId) && (now.bootId == latest->bootId) && (now.timeMs >= latest->timeMs)) {
+        // the server could not have incremented the FV faster than the clock, thus it continues right where it stopped
+        auto const sinceIncrementMs = (latest->phaseMs % SOK_FM_TIME_INCREMENT_PERIOD_MS) + (now.timeMs - latest->timeMs);
+        auto fv = latest->fv + (sinceIncrementMs / SOK_FM_TIME_INCREMENT_PERIOD_MS);
+        auto phaseMs = static_cast<uint32_t>(sinceIncrementMs % SOK_FM_TIME_INCREMENT_PERIOD_MS);
+        return FvmResult<FvCheckpointState>(FvCheckpointState{fv, latest->reservedFv, phaseMs});
+    }
+    // the latest record may predate a power loss, but not the latest synced reservation
+    LOGI("FV checkpoint was written before the last boot, continuing from the reserved freshness value");
+    auto phaseMs = static_cast<uint32_t>(latest->phaseMs % SOK_FM_TIME_INCREMENT_PERIOD_MS);
+    return FvmResult<FvCheckpointState>(FvCheckpointState{latest->reservedFv, latest->reservedFv, phaseMs});
+}
+
+FvCheckpointTime
+FvCheckpoint::Now()
+{
+    static uint64_t const bootId = readBootId();
+    struct timespec ts {};
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return FvCheckpointTime{bootId, (static_cast<uint64_t>(ts.tv_sec) * 1000U) + (static_cast<uint64_t>(ts.tv_nsec) / 1000000U)};
+}
+
+} // namespace fvm
+} // namespace sok
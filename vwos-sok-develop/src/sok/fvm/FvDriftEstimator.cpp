@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvDriftEstimator.hpp"
+#include <algorithm>
+
+namespace sok
+{
+namespace fvm
+{
+
+FvDriftEstimator::FvDriftEstimator(size_t window, size_t minSamples)
+: mWindow(std::max<size_t>(window, 2U))
+, mMinSamples(std::min(std::max<size_t>(minSamples, 2U), std::max<size_t>(window, 2U)))
+, mSamples()
+, mNext(0)
+, mTimeOriginMs(0)
+, mOffsetUs(0.0)
+, mSlopeUsPerMs(0.0)
+{
+    mSamples.reserve(mWindow);
+}
+
+void
+FvDriftEstimator::AddSample(uint64_t localTimeMs, int64_t offsetUs)
+{
+    if (mSamples.size() < mWindow) {
+        mSamples.push_back({localTimeMs, offsetUs});
+    }
+    else {
+        mSamples[mNext] = {localTimeMs, offsetUs};
+    }
+    mNext = (mNext + 1U) % mWindow;
+    fit();
+}
+
+void
+FvDriftEstimator::Reset()
+{
+    mSamples.clear();
+    mNext = 0;
+    mTimeOriginMs = 0;
+    mOffsetUs = 0.0;
+    mSlopeUsPerMs = 0.0;
+}
+
+bool
+FvDriftEstimator::IsValid() const
+{
+    return mSamples.size() >= mMinSamples;
+}
+
+double
+FvDriftEstimator::DriftPpm() const
+{
+    // 1 us per ms is 1000 ppm
+    return IsValid() ? (mSlopeUsPerMs * 1000.0) : 0.0;
+}
+
+double
+FvDriftEstimator::OffsetUs(uint64_t localTimeMs) const
+{
+    if (!IsValid()) {
+        return 0.0;
+    }
+    return mOffsetUs + (mSlopeUsPerMs * (static_cast<double>(localTimeMs) - static_cast<double>(mTimeOriginMs)));
+}
+
+void
+FvDriftEstimator::fit()
+{
+    if (!IsValid()) {
+        return;
+    }
+    // the times are taken relative to the oldest sample, so that the sums keep their precision over long drives
+    mTimeOriginMs = std::min_element(mSamples.begin(), mSamples.end(), [](Sample const& lhs, Sample const& rhs) {
+        return lhs.localTimeMs < rhs.localTimeMs;
+    })->localTimeMs;
+
+    double const count = static_cast<double>(mSamples.size());
+    double sumTime = 0.0;
+    double sumOffset = 0.0;
+    for (auto const& sample : mSamples) {
+        sumTime += static_cast<double>(sample.localTimeMs - mTimeOriginMs);
+        sumOffset += static_cast<double>(sample.offsetUs);
+    }
+    double const meanTime = sumTime / count;
+    double const meanOffset = sumOffset / count;
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (auto const& sample : mSamples) {
+        double const time = static_cast<double>(sample.localTimeMs - mTimeOriginMs) - meanTime;
+        covariance += time * (static_cast<double>(sample.offsetUs) - meanOffset);
+        variance += time * time;
+    }
+    // samples of the same time carry no drift
+    mSlopeUsPerMs = (0.0 < variance) ? (covariance / variance) : 0.0;
+    mOffsetUs = meanOffset - (mSlopeUsPerMs * meanTime);
+}
+
+} // namespace fvm
+} // namespace sok
@@ -0,0 +1,173 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvStatePage.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+constexpr uint32_t FV_STATE_PAGE_MAGIC = 0x534F4B50U;
+constexpr uint32_t FV_STATE_PAGE_VERSION = 2U;
+constexpr uint32_t FV_STATE_PAGE_OPEN_RETRIES = 100U;
+// a record older than this would be extrapolated beyond the next FV increment of the daemon
+constexpr uint64_t FV_STATE_PAGE_STALE_MS = SOK_FM_TIME_INCREMENT_PERIOD_MS + SOK_FM_TIME_JITTER_MAX_MS;
+
+uint64_t
+nowMs()
+{
+    // the monotonic clock is system wide, so the daemon and the SecOC processes read the same time
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+/**
+ * @brief The layout of the shared memory page, only lock free atomics are read by the SecOC processes
+ *
+ */
+struct FvStatePageLayout
+{
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    // published with the monotonic time of the publication in milliseconds, 0 before the first one
+    FvStateSeqlock state;
+};
+
+std::shared_ptr<FvStatePage>
+FvStatePage::Create(std::string const& name)
+{
+    // an existing page is taken over, the SecOC processes which still map it see the records of the new daemon
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (-1 == fd) {
+        LOGE("Failed opening the FV state page: " << name << ", errno: " << errno);
+        return nullptr;
+    }
+    if (0 != ftruncate(fd, static_cast<off_t>(sizeof(FvStatePageLayout)))) {
+        LOGE("Failed sizing the FV state page: " << name << ", errno: " << errno);
+        close(fd);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, sizeof(FvStatePageLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapped) {
+        LOGE("Failed mapping the FV state page: " << name << ", errno: " << errno);
+        return nullptr;
+    }
+
+    auto layout = static_cast<FvStatePageLayout*>(mapped);
+    layout->magic.store(0U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    new (&layout->state) FvStateSeqlock();
+    layout->version = FV_STATE_PAGE_VERSION;
+    layout->magic.store(FV_STATE_PAGE_MAGIC, std::memory_order_release);
+    LOGI("Created the FV state page: " << name);
+    return std::shared_ptr<FvStatePage>(new FvStatePage(name, layout, true));
+}
+
+std::shared_ptr<FvStatePage>
+FvStatePage::Open(std::string const& name)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (-1 == fd) {
+        LOGE("Failed opening the FV state page: " << name << ", errno: " << errno);
+        return nullptr;
+    }
+    // the daemon may still be sizing the page
+    struct stat pageStat {};
+    uint32_t retries = 0U;
+    while ((0 == fstat(fd, &pageStat)) && (static_cast<size_t>(pageStat.st_size) < sizeof(FvStatePageLayout))
+        && (retries++ < FV_STATE_PAGE_OPEN_RETRIES)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (static_cast<size_t>(pageStat.st_size) < sizeof(FvStatePageLayout)) {
+        LOGE("FV state page: " << name << " was not set up by the FVM daemon");
+        close(fd);
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, sizeof(FvStatePageLayout), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == mapped) {
+        LOGE("Failed mapping the FV state page: " << name << ", errno: " << errno);
+        return nullptr;
+    }
+
+    auto layout = static_cast<FvStatePageLayout*>(mapped);
+    retries = 0U;
+    while ((FV_STATE_PAGE_MAGIC != layout->magic.load(std::memory_order_acquire)) && (retries++ < FV_STATE_PAGE_OPEN_RETRIES)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if ((FV_STATE_PAGE_MAGIC != layout->magic.load(std::memory_order_acquire)) || (FV_STATE_PAGE_VERSION != layout->version)) {
+        LOGE("FV state page: " << name << " is not initialized or of another version");
+        munmap(mapped, sizeof(FvStatePageLayout));
+        return nullptr;
+    }
+    LOGI("Opened the FV state page: " << name);
+    return std::shared_ptr<FvStatePage>(new FvStatePage(name, layout, false));
+}
+
+FvStatePage::FvStatePage(std::string const& name, FvStatePageLayout* layout, bool writable)
+: mName(name)
+, mLayout(layout)
+, mWritable(writable)
+{
+}
+
+FvStatePage::~FvStatePage()
+{
+    // the page is not unlinked, the SecOC processes keep loading from it until the next daemon takes it over
+    munmap(mLayout, sizeof(FvStatePageLayout));
+}
+
+void
+FvStatePage::Publish(FvStateRecord const& record)
+{
+    if (!mWritable) {
+        LOGE("The FV state page: " << mName << " is mapped read-only");
+        return;
+    }
+    mLayout->state.Publish(record, nowMs());
+}
+
+FvStateRecord
+FvStatePage::Load() const
+{
+    if (FV_STATE_PAGE_MAGIC != mLayout->magic.load(std::memory_order_acquire)) {
+        // the page is being taken over by a new daemon
+        return FvStateRecord{0, false, 0, 0, 0};
+    }
+    uint64_t publishedAtMs = 0U;
+    auto record = mLayout->state.Load(&publishedAtMs);
+    auto const now = nowMs();
+    auto const ageMs = (now > publishedAtMs) ? (now - publishedAtMs) : 0U;
+    if ((0U == publishedAtMs) || (ageMs > FV_STATE_PAGE_STALE_MS)) {
+        record.valid = false;
+        return record;
+    }
+    // the daemon keeps incrementing its FV while the SecOC process is between two of its publications
+    auto const sinceIncrementMs = record.subTick + ageMs;
+    if (record.valid) {
+        record.fv += sinceIncrementMs / SOK_FM_TIME_INCREMENT_PERIOD_MS;
+    }
+    record.subTick = static_cast<uint32_t>(sinceIncrementMs % SOK_FM_TIME_INCREMENT_PERIOD_MS);
+    record.timeSinceInit += ageMs;
+    return record;
+}
+
+} // namespace fvm
+} // namespace sok
@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvStateSeqlock.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+FvStateSeqlock::FvStateSeqlock()
+: mWriterMutex()
+, mSequence(0)
+, mFv(0)
+, mValid(false)
+, mTimeSinceInit(0)
+, mSubTick(0)
+, mEpoch(0)
+, mStampMs(0)
+{
+}
+
+void
+FvStateSeqlock::Publish(FvStateRecord const& record, uint64_t stampMs)
+{
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    auto sequence = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    mFv.store(record.fv, std::memory_order_relaxed);
+    mValid.store(record.valid, std::memory_order_relaxed);
+    mTimeSinceInit.store(record.timeSinceInit, std::memory_order_relaxed);
+    mSubTick.store(record.subTick, std::memory_order_relaxed);
+    mEpoch.store(record.epoch, std::memory_order_relaxed);
+    mStampMs.store(stampMs, std::memory_order_relaxed);
+    mSequence.store(sequence + 2U, std::memory_order_release);
+}
+
+FvStateRecord
+FvStateSeqlock::Load(uint64_t* stampMs) const
+{
+    FvStateRecord record{0, false, 0, 0, 0};
+    uint64_t stamp = 0;
+    uint32_t sequenceBefore = 0;
+    uint32_t sequenceAfter = 0;
+    do {
+        sequenceBefore = mSequence.load(std::memory_order_acquire);
+        record.fv = mFv.load(std::memory_order_relaxed);
+        record.valid = mValid.load(std::memory_order_relaxed);
+        record.timeSinceInit = mTimeSinceInit.load(std::memory_order_relaxed);
+        record.subTick = mSubTick.load(std::memory_order_relaxed);
+        record.epoch = mEpoch.load(std::memory_order_relaxed);
+        stamp = mStampMs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequenceAfter = mSequence.load(std::memory_order_relaxed);
+    } while ((0U != (sequenceBefore & 1U)) || (sequenceBefore != sequenceAfter));
+    if (nullptr != stampMs) {
+        *stampMs = stamp;
+    }
+    return record;
+}
+
+} // namespace fvm
+} // namespace sok
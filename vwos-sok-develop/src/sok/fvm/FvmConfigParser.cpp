@@ -67,6 +67,10 @@ FvmConfigParser::Parse(std::string const& json, SokFmConfig& config) noexcept
             return false;
         }
 
+        if (!fetchFvRequestRetryPolicyConfigurations(doc, config)) {
+            return false;
+        }
+
         if (!fetchKeyConfigurations(doc, config)) {
             return false;
         }
@@ -91,6 +95,54 @@ FvmConfigParser::fetchGeneralConfigurations(rapidjson::Document const& doc, SokF
     config.mEcuName = doc[schema::GENERAL_ATTRIBUTES.ECU_NAME].GetString();
     config.mNetworkInterface = doc[schema::GENERAL_ATTRIBUTES.NETWORK_INTERFACE].GetString();
     config.mKeyIdForAuthFvDistribution = static_cast<uint16_t>(doc[schema::GENERAL_ATTRIBUTES.ECU_KEY_ID_AUTH_FV].GetUint());
+    // optional, transmit batching is disabled by default
+    config.mSignalTxBatching = doc.HasMember(schema::GENERAL_ATTRIBUTES.SIGNAL_TX_BATCHING)
+                               && doc[schema::GENERAL_ATTRIBUTES.SIGNAL_TX_BATCHING].GetBool();
+    config.mSignalRecordingFile = doc.HasMember(schema::GENERAL_ATTRIBUTES.SIGNAL_RECORDING_FILE)
+                                  ? doc[schema::GENERAL_ATTRIBUTES.SIGNAL_RECORDING_FILE].GetString()
+                                  : "";
+    config.mFvCheckpointFile = doc.HasMember(schema::GENERAL_ATTRIBUTES.FV_CHECKPOINT_FILE)
+                               ? doc[schema::GENERAL_ATTRIBUTES.FV_CHECKPOINT_FILE].GetString()
+                               : "";
+    // optional, the FV signals are processed by the MainFunction by default
+    config.mEventDrivenProcessing = doc.HasMember(schema::GENERAL_ATTRIBUTES.EVENT_DRIVEN_PROCESSING)
+                                    && doc[schema::GENERAL_ATTRIBUTES.EVENT_DRIVEN_PROCESSING].GetBool();
+    // optional, the role the configuration is read for is kept by default
+    if (doc.HasMember(schema::GENERAL_ATTRIBUTES.ECU_FUNCTION)) {
+        config.mEcuFunction = convertStringEcuFunctionToEnum(doc[schema::GENERAL_ATTRIBUTES.ECU_FUNCTION].GetString());
+    }
+    config.mGatewayParticipantConfigFile = doc.HasMember(schema::GENERAL_ATTRIBUTES.GATEWAY_PARTICIPANT_CONFIG_FILE)
+                                           ? doc[schema::GENERAL_ATTRIBUTES.GATEWAY_PARTICIPANT_CONFIG_FILE].GetString()
+                                           : "";
+    if ((FvmRole::kGateway == config.mEcuFunction) && config.mGatewayParticipantConfigFile.empty()) {
+        LOGE("A gateway requires the configuration of its participant role");
+        return false;
+    }
+    // optional, every SecOC process runs its own FVM by default
+    config.mFvDaemon = FvDaemonConfig{FvDaemonMode::kDisabled, "", "", FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID};
+    if (doc.HasMember(schema::FV_DAEMON_CONFIG_ATTRIBUTES.OBJECT_NAME)) {
+        auto daemonObj = doc[schema::FV_DAEMON_CONFIG_ATTRIBUTES.OBJECT_NAME].GetObject();
+        config.mFvDaemon.mode = (schema::ENUM_FV_DAEMON_MODE_CLIENT == std::string(daemonObj[schema::FV_DAEMON_CONFIG_ATTRIBUTES.MODE].GetString()))
+                                ? FvDaemonMode::kClient
+                                : FvDaemonMode::kDaemon;
+        config.mFvDaemon.pageName = daemonObj[schema::FV_DAEMON_CONFIG_ATTRIBUTES.PAGE_NAME].GetString();
+        config.mFvDaemon.socketPath = daemonObj[schema::FV_DAEMON_CONFIG_ATTRIBUTES.SOCKET_PATH].GetString();
+        // optional, only the user and group of the daemon by default
+        if (daemonObj.HasMember(schema::FV_DAEMON_CONFIG_ATTRIBUTES.CLIENT_UID)) {
+            config.mFvDaemon.clientUid = daemonObj[schema::FV_DAEMON_CONFIG_ATTRIBUTES.CLIENT_UID].GetUint();
+        }
+        if (daemonObj.HasMember(schema::FV_DAEMON_CONFIG_ATTRIBUTES.CLIENT_GID)) {
+            config.mFvDaemon.clientGid = daemonObj[schema::FV_DAEMON_CONFIG_ATTRIBUTES.CLIENT_GID].GetUint();
+        }
+    }
+    // optional, the challenge indications run on the signal receive thread by default
+    config.mCrIndicationExecutor = CrIndicationExecutorConfig{false, 0, 0};
+    if (doc.HasMember(schema::CR_INDICATION_EXECUTOR_CONFIG_ATTRIBUTES.OBJECT_NAME)) {
+        auto executorObj = doc[schema::CR_INDICATION_EXECUTOR_CONFIG_ATTRIBUTES.OBJECT_NAME].GetObject();
+        config.mCrIndicationExecutor.threadCount = static_cast<uint8_t>(executorObj[schema::CR_INDICATION_EXECUTOR_CONFIG_ATTRIBUTES.THREAD_COUNT].GetUint());
+        config.mCrIndicationExecutor.queueDepth = static_cast<uint16_t>(executorObj[schema::CR_INDICATION_EXECUTOR_CONFIG_ATTRIBUTES.QUEUE_DEPTH].GetUint());
+        config.mCrIndicationExecutor.enabled = true;
+    }
     return true;
 }
 
@@ -162,6 +214,64 @@ FvmConfigParser::fetchFvDistributionSignalConfigurations(rapidjson::Document con
         return false;
     }
 
+    // optional, group authenticated fv broadcast
+    config.mGroupFvBroadcast = GroupFvBroadcastConfig{false, 0, 0, SignalConfig()};
+    if (doc.HasMember(schema::GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES.OBJECT_NAME)) {
+        auto groupObj = doc[schema::GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES.OBJECT_NAME].GetObject();
+        auto groupSignalObj = groupObj[schema::GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES.SIGNAL].GetObject();
+        if (!fetchSignalConfig(groupSignalObj, config.mGroupFvBroadcast.signal)) {
+            LOGE("Failed to fetch the group FV broadcast signal");
+            return false;
+        }
+        config.mGroupFvBroadcast.keyId = static_cast<uint16_t>(groupObj[schema::GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES.KEY_ID].GetUint());
+        config.mGroupFvBroadcast.periodMs = groupObj[schema::GROUP_FV_BROADCAST_CONFIG_ATTRIBUTES.PERIOD_MS].GetUint();
+        config.mGroupFvBroadcast.enabled = true;
+    }
+
+    return fetchRedundantTimeServersConfigurations(doc, config);
+}
+
+bool 
+FvmConfigParser::fetchRedundantTimeServersConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const
+{
+    config.mRedundantTimeServers.clear();
+    if (!doc.HasMember(schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.OBJECT_NAME)) {
+        return true;
+    }
+    auto serversArray = doc[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.OBJECT_NAME].GetArray();
+    for (auto const& serverObject : serversArray) {
+        TimeServerEndpointConfig server;
+        server.serverEcuName = serverObject[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.SERVER_ECU_NAME].GetString();
+        server.keyId = static_cast<uint16_t>(serverObject[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.KEY_ID].GetUint());
+
+        auto challengeSignalObj = serverObject[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.CHALLENGE_SIGNAL].GetObject();
+        auto valueSignalObj = serverObject[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.VALUE_SIGNAL].GetObject();
+        auto signatureSignalObj = serverObject[schema::REDUNDANT_TIME_SERVERS_CONFIG_ATTRIBUTES.SIGNATURE_SIGNAL].GetObject();
+        if (!fetchSignalConfig(challengeSignalObj, server.challengeSignal) || !fetchSignalConfig(valueSignalObj, server.responseValueSignal)
+            || !fetchSignalConfig(signatureSignalObj, server.responseSignatureSignal)) {
+            LOGE("Failed to fetch the signals of time server with ECU name: " << server.serverEcuName);
+            return false;
+        }
+        config.mRedundantTimeServers.push_back(server);
+    }
+    return true;
+}
+
+bool 
+FvmConfigParser::fetchFvRequestRetryPolicyConfigurations(rapidjson::Document const& doc, SokFmConfig& config) const
+{
+    // optional, for participants only
+    config.mFvRequestRetryPolicy = FvRequestRetryPolicy{false, 0, 0};
+    if (doc.HasMember(schema::FV_REQUEST_RETRY_POLICY_ATTRIBUTES.OBJECT_NAME)) {
+        auto retryObj = doc[schema::FV_REQUEST_RETRY_POLICY_ATTRIBUTES.OBJECT_NAME].GetObject();
+        config.mFvRequestRetryPolicy.baseDelayMs = retryObj[schema::FV_REQUEST_RETRY_POLICY_ATTRIBUTES.BASE_DELAY_MS].GetUint();
+        config.mFvRequestRetryPolicy.maxDelayMs = retryObj[schema::FV_REQUEST_RETRY_POLICY_ATTRIBUTES.MAX_DELAY_MS].GetUint();
+        if (config.mFvRequestRetryPolicy.maxDelayMs < config.mFvRequestRetryPolicy.baseDelayMs) {
+            LOGE("The maximum delay of the FV request retry policy is below its base delay");
+            return false;
+        }
+        config.mFvRequestRetryPolicy.enabled = true;
+    }
     return true;
 }
 
@@ -249,6 +359,23 @@ FvmConfigParser::convertStringFreshnessTypeToEnum(std::string const& freshnessTy
     }
 }   
 
+FvmRole 
+FvmConfigParser::convertStringEcuFunctionToEnum(std::string const& ecuFunction) const
+{
+    if (schema::ENUM_ECU_FUNCTION_SERVER == ecuFunction) {
+        return FvmRole::kServer;
+    }
+    else if (schema::ENUM_ECU_FUNCTION_GATEWAY == ecuFunction) {
+        return FvmRole::kGateway;
+    }
+    else {
+        if (schema::ENUM_ECU_FUNCTION_PARTICIPANT != ecuFunction) {
+            LOGE("Invalid ECU function!");
+        }
+        return FvmRole::kParticipant;
+    }
+}
+
 bool 
 FvmConfigParser::fetchSignalConfig(rapidjson::GenericObject<true, rapidjson::Value> const& object, SignalConfig& signalConfig) const
 {
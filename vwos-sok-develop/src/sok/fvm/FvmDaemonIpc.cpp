@@ -0,0 +1,423 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvmDaemonIpc.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+// the threads check for a stop request at least this often
+constexpr int FVM_IPC_POLL_TIMEOUT_MS = 100;
+// the SecOC processes connect by the group permission of the socket
+constexpr mode_t FVM_IPC_SOCKET_MODE = 0660;
+
+bool
+makeSocketAddress(std::string const& socketPath, sockaddr_un& address)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        LOGE("FVM daemon socket path is too long: " << socketPath);
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.data(), socketPath.size());
+    return true;
+}
+
+bool
+sendMessage(int fd, FvmIpcMessage const& message, int flags)
+{
+    return sizeof(message) == static_cast<size_t>(send(fd, &message, sizeof(message), flags | MSG_NOSIGNAL));
+}
+
+} // namespace
+
+FvmDaemonServer::FvmDaemonServer(std::string const& socketPath, int64_t clientUid, int64_t clientGid, RequestHandler handler)
+: mSocketPath(socketPath)
+, mClientUid((FV_DAEMON_OWN_ID == clientUid) ? geteuid() : static_cast<uid_t>(clientUid))
+, mClientGid((FV_DAEMON_OWN_ID == clientGid) ? getegid() : static_cast<gid_t>(clientGid))
+, mHandler(std::move(handler))
+, mListenFd(-1)
+, mRunning(false)
+, mThread()
+, mConnectionsMutex()
+, mConnections()
+, mFvIdClaims()
+, mNextConnectionId(0)
+{
+}
+
+FvmDaemonServer::~FvmDaemonServer()
+{
+    Stop();
+}
+
+bool
+FvmDaemonServer::Start() noexcept
+{
+    try {
+        if (mRunning) {
+            return true;
+        }
+        sockaddr_un address;
+        if (!makeSocketAddress(mSocketPath, address)) {
+            return false;
+        }
+        mListenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (-1 == mListenFd) {
+            LOGE("Failed creating the FVM daemon socket, errno: " << errno);
+            return false;
+        }
+        // the socket of a previous daemon is left behind if it did not stop cleanly
+        unlink(mSocketPath.c_str());
+        if ((0 != bind(mListenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) || (0 != listen(mListenFd, SOMAXCONN))) {
+            LOGE("Failed binding the FVM daemon socket: " << mSocketPath << ", errno: " << errno);
+            close(mListenFd);
+            mListenFd = -1;
+            return false;
+        }
+        // the umask may have left the socket open to other users until now, their connections are refused by the peer check
+        if ((0 != chmod(mSocketPath.c_str(), FVM_IPC_SOCKET_MODE))
+            || ((getegid() != mClientGid) && (0 != chown(mSocketPath.c_str(), static_cast<uid_t>(-1), mClientGid)))) {
+            LOGE("Failed restricting the FVM daemon socket: " << mSocketPath << ", errno: " << errno);
+            close(mListenFd);
+            mListenFd = -1;
+            unlink(mSocketPath.c_str());
+            return false;
+        }
+        mRunning = true;
+        mThread = std::thread(&FvmDaemonServer::serve, this);
+        LOGI("FVM daemon serving on: " << mSocketPath);
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        mRunning = false;
+        return false;
+    }
+}
+
+void
+FvmDaemonServer::Stop() noexcept
+{
+    try {
+        mRunning = false;
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        std::lock_guard<std::mutex> lock(mConnectionsMutex);
+        for (auto&& connection : mConnections) {
+            close(connection.second);
+        }
+        mConnections.clear();
+        mFvIdClaims.clear();
+        if (-1 != mListenFd) {
+            close(mListenFd);
+            mListenFd = -1;
+            unlink(mSocketPath.c_str());
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+bool
+FvmDaemonServer::SendIndication(ConnectionId connection, SokFreshnessValueId fvId) noexcept
+{
+    try {
+        FvmIpcMessage indication{};
+        indication.type = FvmIpcMessageType::kChallengeIndication;
+        indication.result = FvmErrorCode::kSuccess;
+        indication.fvId = fvId;
+        std::lock_guard<std::mutex> lock(mConnectionsMutex);
+        auto connectionFindRes = mConnections.find(connection);
+        if (mConnections.end() == connectionFindRes) {
+            LOGW("SecOC process of the challenge for FV ID: " << fvId << " is not connected anymore");
+            return false;
+        }
+        // never blocks the signal thread on a SecOC process which does not read its socket
+        if (!sendMessage(connectionFindRes->second, indication, MSG_DONTWAIT)) {
+            LOGE("Failed indicating the challenge for FV ID: " << fvId << ", errno: " << errno);
+            return false;
+        }
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return false;
+    }
+}
+
+bool
+FvmDaemonServer::ClaimFvId(ConnectionId connection, SokFreshnessValueId fvId) noexcept
+{
+    try {
+        std::lock_guard<std::mutex> lock(mConnectionsMutex);
+        auto claimFindRes = mFvIdClaims.find(fvId);
+        if ((mFvIdClaims.end() != claimFindRes) && (connection != claimFindRes->second)) {
+            LOGW("FV ID: " << fvId << " is claimed by another SecOC process");
+            return false;
+        }
+        mFvIdClaims[fvId] = connection;
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return false;
+    }
+}
+
+void
+FvmDaemonServer::serve() noexcept
+{
+    try {
+        std::vector<pollfd> pollFds;
+        std::vector<ConnectionId> pollConnections;
+        while (mRunning) {
+            pollFds.assign(1U, pollfd{mListenFd, POLLIN, 0});
+            pollConnections.clear();
+            {
+                std::lock_guard<std::mutex> lock(mConnectionsMutex);
+                for (auto&& connection : mConnections) {
+                    pollFds.push_back(pollfd{connection.second, POLLIN, 0});
+                    pollConnections.push_back(connection.first);
+                }
+            }
+            if (0 >= poll(pollFds.data(), pollFds.size(), FVM_IPC_POLL_TIMEOUT_MS)) {
+                continue;
+            }
+            if (0 != (pollFds[0].revents & POLLIN)) {
+                int fd = accept4(mListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+                if ((-1 != fd) && !isPeerAllowed(fd)) {
+                    close(fd);
+                }
+                else if (-1 != fd) {
+                    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+                    mConnections[mNextConnectionId++] = fd;
+                    LOGD("SecOC process connected to the FVM daemon");
+                }
+            }
+            for (size_t i = 1U; i < pollFds.size(); ++i) {
+                if (0 == (pollFds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    continue;
+                }
+                FvmIpcMessage request{};
+                auto received = recv(pollFds[i].fd, &request, sizeof(request), 0);
+                if (sizeof(request) != static_cast<size_t>(received)) {
+                    // 0 if the SecOC process disconnected, its offers are answered with failed indications
+                    closeConnection(pollConnections[i - 1U]);
+                    continue;
+                }
+                FvmIpcMessage response{};
+                response.type = FvmIpcMessageType::kResponse;
+                response.result = FvmErrorCode::kGeneralError;
+                response.fvId = request.fvId;
+                response.sequence = request.sequence;
+                mHandler(pollConnections[i - 1U], request, response);
+                // the connections are closed on this thread only, so its fd stays valid without the lock.
+                // A SecOC process which does not read its responses is dropped instead of blocking the others
+                if (!sendMessage(pollFds[i].fd, response, MSG_DONTWAIT)) {
+                    LOGE("Failed answering a SecOC process, errno: " << errno);
+                    closeConnection(pollConnections[i - 1U]);
+                }
+            }
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+bool
+FvmDaemonServer::isPeerAllowed(int fd) const noexcept
+{
+    ucred peer{};
+    socklen_t peerLength = sizeof(peer);
+    if (0 != getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &peerLength)) {
+        LOGE("Failed reading the credentials of a SecOC process, errno: " << errno);
+        return false;
+    }
+    if ((0U == peer.uid) || (mClientUid == peer.uid) || (mClientGid == peer.gid)) {
+        return true;
+    }
+    LOGW("Refused the connection of process: " << peer.pid << ", uid: " << peer.uid << ", gid: " << peer.gid);
+    return false;
+}
+
+void
+FvmDaemonServer::closeConnection(ConnectionId connection) noexcept
+{
+    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+    auto connectionFindRes = mConnections.find(connection);
+    if (mConnections.end() != connectionFindRes) {
+        close(connectionFindRes->second);
+        mConnections.erase(connectionFindRes);
+        for (auto it = mFvIdClaims.begin(); it != mFvIdClaims.end();) {
+            it = (connection == it->second) ? mFvIdClaims.erase(it) : std::next(it);
+        }
+        LOGD("SecOC process disconnected from the FVM daemon");
+    }
+}
+
+FvmDaemonClient::FvmDaemonClient(std::string const& socketPath)
+: mSocketPath(socketPath)
+, mFd(-1)
+, mRunning(false)
+, mReceiverThread()
+, mIndicationCb()
+, mRequestMutex()
+, mResponseMutex()
+, mResponseCv()
+, mSequence(0)
+, mResponseReceived(false)
+, mResponse()
+{
+}
+
+FvmDaemonClient::~FvmDaemonClient()
+{
+    Disconnect();
+}
+
+bool
+FvmDaemonClient::Connect(ChallengeReceivedIndicationCb const& indicationCb) noexcept
+{
+    try {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        if (mRunning) {
+            return true;
+        }
+        if (mReceiverThread.joinable()) {
+            // the daemon closed the previous connection
+            mReceiverThread.join();
+            close(mFd);
+            mFd = -1;
+        }
+        sockaddr_un address;
+        if (!makeSocketAddress(mSocketPath, address)) {
+            return false;
+        }
+        mFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (-1 == mFd) {
+            LOGE("Failed creating the FVM daemon client socket, errno: " << errno);
+            return false;
+        }
+        if (0 != connect(mFd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) {
+            LOGE("Failed connecting to the FVM daemon: " << mSocketPath << ", errno: " << errno);
+            close(mFd);
+            mFd = -1;
+            return false;
+        }
+        mIndicationCb = indicationCb;
+        mRunning = true;
+        mReceiverThread = std::thread(&FvmDaemonClient::receive, this);
+        LOGI("Connected to the FVM daemon: " << mSocketPath);
+        return true;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        mRunning = false;
+        return false;
+    }
+}
+
+void
+FvmDaemonClient::Disconnect() noexcept
+{
+    try {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mRunning = false;
+        if (mReceiverThread.joinable()) {
+            mReceiverThread.join();
+        }
+        if (-1 != mFd) {
+            close(mFd);
+            mFd = -1;
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    }
+}
+
+FvmErrorCode
+FvmDaemonClient::Request(FvmIpcMessage request, FvmIpcMessage& response) noexcept
+{
+    try {
+        std::lock_guard<std::mutex> requestLock(mRequestMutex);
+        if (!mRunning) {
+            LOGE("Not connected to the FVM daemon");
+            return FvmErrorCode::kNotInitialized;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mResponseMutex);
+            request.sequence = ++mSequence;
+            mResponseReceived = false;
+        }
+        if (!sendMessage(mFd, request, 0)) {
+            LOGE("Failed sending a request to the FVM daemon, errno: " << errno);
+            return FvmErrorCode::kGeneralError;
+        }
+        std::unique_lock<std::mutex> lock(mResponseMutex);
+        if (!mResponseCv.wait_for(lock, std::chrono::milliseconds(SOK_FM_DAEMON_IPC_TIMEOUT_MS), [this]() { return mResponseReceived; })) {
+            LOGE("FVM daemon did not answer the request for FV ID: " << request.fvId);
+            return FvmErrorCode::kGeneralError;
+        }
+        response = mResponse;
+        return FvmErrorCode::kSuccess;
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        return FvmErrorCode::kGeneralError;
+    }
+}
+
+void
+FvmDaemonClient::receive() noexcept
+{
+    try {
+        pollfd pollFd{mFd, POLLIN, 0};
+        while (mRunning) {
+            pollFd.revents = 0;
+            if (0 >= poll(&pollFd, 1U, FVM_IPC_POLL_TIMEOUT_MS)) {
+                continue;
+            }
+            FvmIpcMessage message{};
+            auto received = recv(mFd, &message, sizeof(message), 0);
+            if (sizeof(message) != static_cast<size_t>(received)) {
+                LOGW("FVM daemon closed the connection");
+                mRunning = false;
+                break;
+            }
+            if (FvmIpcMessageType::kChallengeIndication == message.type) {
+                if (mIndicationCb) {
+                    mIndicationCb(message.fvId);
+                }
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mResponseMutex);
+            // a response arriving after its request timed out is dropped
+            if (message.sequence == mSequence) {
+                mResponse = message;
+                mResponseReceived = true;
+                mResponseCv.notify_all();
+            }
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+        mRunning = false;
+    }
+}
+
+} // namespace fvm
+} // namespace sok
@@ -0,0 +1,114 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvmExecutor.hpp"
+#include <algorithm>
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+FvmExecutor::FvmExecutor(size_t capacity, size_t threadCount)
+: mCapacity(std::max<size_t>(capacity, 1U))
+, mThreadCount(std::max<size_t>(threadCount, 1U))
+, mMutex()
+, mCondition()
+, mQueue()
+, mRunning(false)
+, mThreads()
+, mRejectedTasks(0)
+{
+}
+
+FvmExecutor::~FvmExecutor()
+{
+    Stop();
+}
+
+bool
+FvmExecutor::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mRunning) {
+            return true;
+        }
+        // set before the threads start, a worker returns right away otherwise
+        mRunning = true;
+        try {
+            while (mThreads.size() < mThreadCount) {
+                mThreads.emplace_back(&FvmExecutor::run, this);
+            }
+            return true;
+        } catch (std::exception const& ex) {
+            LOGE("Failed starting the FVM executor, what(): " << ex.what());
+        }
+    }
+    // the threads started so far are joined
+    Stop();
+    return false;
+}
+
+void
+FvmExecutor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+        mQueue.clear();
+    }
+    mCondition.notify_all();
+    for (auto&& thread : mThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    mThreads.clear();
+}
+
+bool
+FvmExecutor::Post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mRunning) {
+            return false;
+        }
+        if (mQueue.size() >= mCapacity) {
+            ++mRejectedTasks;
+            return false;
+        }
+        mQueue.push_back(std::move(task));
+    }
+    mCondition.notify_one();
+    return true;
+}
+
+void
+FvmExecutor::run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [this]() {
+            return !mRunning || !mQueue.empty();
+        });
+        if (!mRunning) {
+            return;
+        }
+        auto task = std::move(mQueue.front());
+        mQueue.pop_front();
+        lock.unlock();
+        try {
+            task();
+        } catch (std::exception const& ex) {
+            LOGE("exception, what(): " << ex.what());
+        } catch (...) {
+            LOGE("exception");
+        }
+        lock.lock();
+    }
+}
+
+} // namespace fvm
+} // namespace sok
@@ -0,0 +1,90 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/FvmReplayDriver.hpp"
+#include <algorithm>
+#include <thread>
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+constexpr uint64_t NS_PER_MS = 1000000U;
+
+/**
+ * @brief virtual time the replay keeps running after the last incoming signal, so that pending
+ *        challenges are answered or run into their timeout
+ */
+constexpr uint64_t REPLAY_TAIL_NS = static_cast<uint64_t>(SOK_FM_CHALLENGE_TIMEOUT_MS) * NS_PER_MS;
+
+} // namespace
+
+FvmReplayDriver::FvmReplayDriver(AFreshnessValueManagerImpl& fvm, std::shared_ptr<SignalManagerReplay> signalManager)
+: mFvm(fvm)
+, mSignalManager(std::move(signalManager))
+{
+}
+
+ReplayStatistics
+FvmReplayDriver::Run(std::vector<SignalRecord> const& records, ReplaySpeed speed)
+{
+    ReplayStatistics statistics;
+    std::vector<SignalRecord const*> incoming;
+    for (auto&& record : records) {
+        if (SignalRecordType::kReceive == record.type) {
+            incoming.push_back(&record);
+        } else if (SignalRecordType::kPublish == record.type) {
+            ++statistics.recordedPublications;
+        }
+    }
+    // records of different transport threads may be written slightly out of order
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [](SignalRecord const* a, SignalRecord const* b) { return a->timestampNs < b->timestampNs; });
+
+    uint64_t const endNs = (incoming.empty() ? 0U : incoming.back()->timestampNs) + REPLAY_TAIL_NS;
+    uint64_t const periodNs = static_cast<uint64_t>(SOK_FM_MAIN_FUNCTION_PERIOD_MS) * NS_PER_MS;
+    auto const wallClockStart = std::chrono::steady_clock::now();
+    size_t next = 0;
+
+    for (uint64_t virtualNs = 0; virtualNs <= endNs; virtualNs += periodNs) {
+        if (ReplaySpeed::kRealTime == speed) {
+            std::this_thread::sleep_until(wallClockStart + std::chrono::nanoseconds(virtualNs));
+        }
+        mSignalManager->SetVirtualTime(virtualNs);
+
+        auto const processingStart = std::chrono::steady_clock::now();
+        for (; (next < incoming.size()) && (incoming[next]->timestampNs <= virtualNs); ++next) {
+            if (mSignalManager->Deliver(incoming[next]->signalName, incoming[next]->payload)) {
+                ++statistics.deliveredSignals;
+            } else {
+                ++statistics.droppedSignals;
+            }
+        }
+        auto const mainFunctionStart = std::chrono::steady_clock::now();
+        if (FvmErrorCode::kSuccess != mFvm.MainFunction()) {
+            ++statistics.mainFunctionErrors;
+        }
+        auto const mainFunctionEnd = std::chrono::steady_clock::now();
+
+        ++statistics.mainFunctionCycles;
+        statistics.signalProcessingTime += mainFunctionStart - processingStart;
+        statistics.mainFunctionTime += mainFunctionEnd - mainFunctionStart;
+        statistics.maxMainFunctionTime = std::max(statistics.maxMainFunctionTime,
+                                                  std::chrono::duration_cast<std::chrono::nanoseconds>(mainFunctionEnd - mainFunctionStart));
+    }
+
+    statistics.publishedSignals = mSignalManager->TakePublishedSignals();
+    statistics.replayedPublications = statistics.publishedSignals.size();
+    LOGI("Replayed " << statistics.deliveredSignals << " signals (" << statistics.droppedSignals << " dropped) in "
+         << statistics.mainFunctionCycles << " cycles, published " << statistics.replayedPublications << " signals ("
+         << statistics.recordedPublications << " recorded)");
+    return statistics;
+}
+
+} // namespace fvm
+} // namespace sok
@@ -9,7 +9,13 @@ namespace fvm
 {
 
 FvmRuntimeAttributesManager::FvmRuntimeAttributesManager() 
-: mConfigAccessor(SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+: FvmRuntimeAttributesManager(SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+{
+}
+
+FvmRuntimeAttributesManager::FvmRuntimeAttributesManager(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor)
+: mConfigAccessor(std::move(configAccessor))
+, mAttributesMap()
 {
 }
     
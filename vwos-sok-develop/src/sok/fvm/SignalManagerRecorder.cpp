@@ -0,0 +1,88 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/SignalManagerRecorder.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+SignalManagerRecorder::SignalManagerRecorder(std::shared_ptr<ISignalManager> signalManager, std::string const& recordingFile)
+: mSignalManager(std::move(signalManager))
+, mRecordingStart(std::chrono::steady_clock::now())
+, mWriter()
+, mIsRecording(false)
+{
+    mIsRecording = (FvmErrorCode::kSuccess == mWriter.Open(recordingFile));
+    if (mIsRecording) {
+        LOGI("Recording signal traffic to: " << recordingFile);
+    }
+}
+
+FvmErrorCode
+SignalManagerRecorder::Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb)
+{
+    auto ret = mSignalManager->Subscribe(signalConfig, [this, cb](std::string const& signal, std::vector<uint8_t> const& value) {
+        record(SignalRecordType::kReceive, signal, value);
+        cb(signal, value);
+    });
+    if (FvmErrorCode::kSuccess == ret) {
+        record(SignalRecordType::kSubscribe, signalConfig.name, {});
+    }
+    return ret;
+}
+
+FvmErrorCode
+SignalManagerRecorder::Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    record(SignalRecordType::kPublish, signalConfig.name, value);
+    return mSignalManager->Publish(signalConfig, value);
+}
+
+FvmErrorCode
+SignalManagerRecorder::PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    record(SignalRecordType::kPublish, signalConfig.name, value);
+    return mSignalManager->PublishUnbatched(signalConfig, value);
+}
+
+FvmErrorCode
+SignalManagerRecorder::PrepareOutgoing(SignalConfig const& signalConfig)
+{
+    return mSignalManager->PrepareOutgoing(signalConfig);
+}
+
+void
+SignalManagerRecorder::SetTxBatching(bool enabled)
+{
+    mSignalManager->SetTxBatching(enabled);
+}
+
+FvmErrorCode
+SignalManagerRecorder::Flush()
+{
+    return mSignalManager->Flush();
+}
+
+bool
+SignalManagerRecorder::IsRecording() const
+{
+    return mIsRecording;
+}
+
+void
+SignalManagerRecorder::record(SignalRecordType type, std::string const& signalName, std::vector<uint8_t> const& payload)
+{
+    if (!mIsRecording) {
+        return;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - mRecordingStart;
+    SignalRecord record{static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), type, signalName, payload};
+    if (FvmErrorCode::kSuccess != mWriter.Write(record)) {
+        LOGW("Failed to record signal event of: " << signalName);
+    }
+}
+
+} // namespace fvm
+} // namespace sok
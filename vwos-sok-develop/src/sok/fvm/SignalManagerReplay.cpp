@@ -0,0 +1,97 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/SignalManagerReplay.hpp"
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+FvmErrorCode
+SignalManagerReplay::Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mSubscriptions.emplace(signalConfig.name, cb).second) {
+        LOGE("Signal " << signalConfig.name << " is already subscribed");
+        return FvmErrorCode::kAlreadyInitialized;
+    }
+    return FvmErrorCode::kSuccess;
+}
+
+FvmErrorCode
+SignalManagerReplay::Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPublishedSignals.push_back(SignalRecord{mVirtualTimeNs, SignalRecordType::kPublish, signalConfig.name, value});
+    return FvmErrorCode::kSuccess;
+}
+
+FvmErrorCode
+SignalManagerReplay::PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    return Publish(signalConfig, value);
+}
+
+FvmErrorCode
+SignalManagerReplay::PrepareOutgoing(SignalConfig const& signalConfig)
+{
+    (void)signalConfig;
+    return FvmErrorCode::kSuccess;
+}
+
+void
+SignalManagerReplay::SetTxBatching(bool enabled)
+{
+    // there is no transport to batch for, published signals are collected anyway
+    (void)enabled;
+}
+
+FvmErrorCode
+SignalManagerReplay::Flush()
+{
+    return FvmErrorCode::kSuccess;
+}
+
+bool
+SignalManagerReplay::Deliver(std::string const& signalName, std::vector<uint8_t> const& value)
+{
+    SignalEventCallback cb;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto subscription = mSubscriptions.find(signalName);
+        if (mSubscriptions.end() == subscription) {
+            return false;
+        }
+        cb = subscription->second;
+    }
+    // the callback may publish, so it is called without holding the lock
+    cb(signalName, value);
+    return true;
+}
+
+void
+SignalManagerReplay::SetVirtualTime(uint64_t timestampNs)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mVirtualTimeNs = timestampNs;
+}
+
+uint64_t
+SignalManagerReplay::GetVirtualTime() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mVirtualTimeNs;
+}
+
+std::vector<SignalRecord>
+SignalManagerReplay::TakePublishedSignals()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<SignalRecord> published;
+    published.swap(mPublishedSignals);
+    return published;
+}
+
+} // namespace fvm
+} // namespace sok
@@ -45,9 +45,14 @@ void SokSignalEventHandler::onEvent(EventType event, ReceivedSignal const& signa
 }
 
 SignalManagerSci::SignalManagerSci()
+: SignalManagerSci(SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+{
+}
+
+SignalManagerSci::SignalManagerSci(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor)
 : mInitialized(false)
 , mSignalClient()
-, mConfAccessor(SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor())
+, mConfAccessor(std::move(configAccessor))
 , mOutSignals()
 , mInSignals()
 , mSignalEventHandlers()
@@ -55,6 +60,9 @@ SignalManagerSci::SignalManagerSci()
 , mIncomingPdusCache()
 , mOutgoingFramesCache()
 , mOutgoingPdusCache()
+, mTxBatching(false)
+, mPendingTxMutex()
+, mPendingTxFrames()
 {
     auto sciApi = vwg::e3p::com::sci::api::SciApiFactory::initFactory("SOK-FM_Signals");
     if (nullptr == sciApi) {
@@ -84,8 +92,7 @@ SignalManagerSci::Subscribe(SignalConfig const& signalConfig, SignalEventCallbac
         return FvmErrorCode::kNotInitialized;
     }
 
-    auto sigFindRes = mInSignals.find(signalConfig.name);
-    if (mInSignals.end() != sigFindRes) {
+    if (mInSignals.Contains(signalConfig.name)) {
         LOGW("Already subscribed to signal with name: " << signalConfig.name);
         return FvmErrorCode::kAlreadyInitialized;
     }
@@ -101,48 +108,137 @@ SignalManagerSci::Subscribe(SignalConfig const& signalConfig, SignalEventCallbac
     }
 
     mSignalEventHandlers.push_back(eventHandler);
+    mInSignals.Emplace(signalConfig.name, signal);
 
     return FvmErrorCode::kSuccess;
 }
 
 FvmErrorCode 
 SignalManagerSci::Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    return publish(signalConfig, value, mTxBatching);
+}
+
+FvmErrorCode 
+SignalManagerSci::PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    return publish(signalConfig, value, false);
+}
+
+FvmErrorCode 
+SignalManagerSci::publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value, bool batched)
 {
     if (!mInitialized) {
         LOGE("SignalManagerSci wasn't initialized successfully");
         return FvmErrorCode::kNotInitialized;
     }
 
-    std::shared_ptr<TransmittedSignal> signal;
-    auto sigFindRes = mOutSignals.find(signalConfig.name);
-    if (mOutSignals.end() != sigFindRes) {
-        signal = sigFindRes->second;
+    auto signal = getOutgoingSignal(signalConfig);
+    if (!signal) {
+        return FvmErrorCode::kGeneralError;
     }
-    else {
-        signal = createOutgoingSignal(signalConfig);
-        if (!signal) {
-            return FvmErrorCode::kGeneralError;
+
+    if (batched) {
+        std::lock_guard<std::mutex> lock(mPendingTxMutex);
+        auto& frameUpdates = mPendingTxFrames[signalConfig.pduConfig.frameConfig.name];
+        auto updateFindRes = std::find_if(frameUpdates.begin(), frameUpdates.end(), [&signalConfig](PendingSignalUpdate const& update) {
+            return update.name == signalConfig.name;
+        });
+        // only the latest value of a signal is transmitted
+        if (frameUpdates.end() != updateFindRes) {
+            updateFindRes->value = value;
+        }
+        else {
+            frameUpdates.push_back({signalConfig.name, signal, value});
+        }
+        LOGD("Queued signal: " << signalConfig.name << " for the next flush");
+        return FvmErrorCode::kSuccess;
+    }
+
+    return setSignalValue(signal, signalConfig.name, value);
+}
+
+void 
+SignalManagerSci::SetTxBatching(bool enabled)
+{
+    LOGI("Transmit batching " << (enabled ? "enabled" : "disabled"));
+    mTxBatching = enabled;
+}
+
+FvmErrorCode 
+SignalManagerSci::Flush()
+{
+    if (!mInitialized) {
+        LOGE("SignalManagerSci wasn't initialized successfully");
+        return FvmErrorCode::kNotInitialized;
+    }
+
+    std::unordered_map<std::string, std::vector<PendingSignalUpdate>> pendingTxFrames;
+    {
+        std::lock_guard<std::mutex> lock(mPendingTxMutex);
+        pendingTxFrames.swap(mPendingTxFrames);
+    }
+
+    FvmErrorCode ret = FvmErrorCode::kSuccess;
+    for (auto&& frameUpdates : pendingTxFrames) {
+        for (auto&& update : frameUpdates.second) {
+            if (FvmErrorCode::kSuccess != setSignalValue(update.signal, update.name, update.value)) {
+                ret = FvmErrorCode::kGeneralError;
+            }
         }
-        mOutSignals[signalConfig.name] = signal;
+        LOGD("Flushed " << frameUpdates.second.size() << " signal updates of frame: " << frameUpdates.first);
     }
+    return ret;
+}
 
+FvmErrorCode 
+SignalManagerSci::setSignalValue(std::shared_ptr<TransmittedSignal> const& signal, std::string const& name, std::vector<uint8_t> const& value) const
+{
     if (value.size() > 8) {
         if (Status::kOk != signal->setValue(value)) {
-            LOGE("Failed setting signal: " << signalConfig.name);
+            LOGE("Failed setting signal: " << name);
             return FvmErrorCode::kGeneralError;
         }
     }
     else {
         if (Status::kOk != signal->setValue(common::ByteVectorToUint<uint64_t>(value))) {
-            LOGE("Failed setting signal: " << signalConfig.name);
+            LOGE("Failed setting signal: " << name);
             return FvmErrorCode::kGeneralError;
         }
     }
 
-    LOGD("Sent successfully signal: " << signalConfig.name);
+    LOGD("Sent successfully signal: " << name);
     return FvmErrorCode::kSuccess;
 }
 
+FvmErrorCode 
+SignalManagerSci::PrepareOutgoing(SignalConfig const& signalConfig)
+{
+    if (!mInitialized) {
+        LOGE("SignalManagerSci wasn't initialized successfully");
+        return FvmErrorCode::kNotInitialized;
+    }
+
+    if (!getOutgoingSignal(signalConfig)) {
+        return FvmErrorCode::kGeneralError;
+    }
+    return FvmErrorCode::kSuccess;
+}
+
+std::shared_ptr<TransmittedSignal> 
+SignalManagerSci::getOutgoingSignal(SignalConfig const& signalConfig)
+{
+    auto sigFindRes = mOutSignals.Find(signalConfig.name);
+    if (nullptr != sigFindRes) {
+        return *sigFindRes;
+    }
+    auto signal = createOutgoingSignal(signalConfig);
+    if (signal) {
+        mOutSignals.Emplace(signalConfig.name, signal);
+    }
+    return signal;
+}
+
 std::shared_ptr<ReceivedSignal> 
 SignalManagerSci::createIncomingSignal(SignalConfig const& sokSignalConfig)
 {
@@ -172,16 +268,16 @@ SignalManagerSci::createIncomingSignal(SignalConfig const& sokSignalConfig)
         return pduResult.value();
     };
 
-    auto frameCacheFindRes = mIncomingFramesCache.find(sokSignalConfig.pduConfig.frameConfig.name);
+    auto frameCacheFindRes = mIncomingFramesCache.Find(sokSignalConfig.pduConfig.frameConfig.name);
     // check if such frame was already created
-    if (mIncomingFramesCache.end() != frameCacheFindRes) {
+    if (nullptr != frameCacheFindRes) {
         // check if such pdu was already created
-        auto pduCacheFindRes = mIncomingPdusCache.find(sokSignalConfig.pduConfig.name);
-        if (mIncomingPdusCache.end() != pduCacheFindRes) {
-            return createSignal(pduCacheFindRes->second);
+        auto pduCacheFindRes = mIncomingPdusCache.Find(sokSignalConfig.pduConfig.name);
+        if (nullptr != pduCacheFindRes) {
+            return createSignal(*pduCacheFindRes);
         }
         else {
-            auto pdu = createPdu(frameCacheFindRes->second);
+            auto pdu = createPdu(*frameCacheFindRes);
             if (!pdu) {
                 return nullptr;
             }
@@ -235,16 +331,16 @@ SignalManagerSci::createOutgoingSignal(SignalConfig const& sokSignalConfig)
         return pduResult.value();
     };
 
-    auto frameCacheFindRes = mOutgoingFramesCache.find(sokSignalConfig.pduConfig.frameConfig.name);
+    auto frameCacheFindRes = mOutgoingFramesCache.Find(sokSignalConfig.pduConfig.frameConfig.name);
     // check if such frame was already created
-    if (mOutgoingFramesCache.end() != frameCacheFindRes) {
+    if (nullptr != frameCacheFindRes) {
         // check if such pdu was already created
-        auto pduCacheFindRes = mOutgoingPdusCache.find(sokSignalConfig.pduConfig.name);
-        if (mOutgoingPdusCache.end() != pduCacheFindRes) {
-            return createSignal(pduCacheFindRes->second);
+        auto pduCacheFindRes = mOutgoingPdusCache.Find(sokSignalConfig.pduConfig.name);
+        if (nullptr != pduCacheFindRes) {
+            return createSignal(*pduCacheFindRes);
         }
         else {
-            auto pdu = createPdu(frameCacheFindRes->second);
+            auto pdu = createPdu(*frameCacheFindRes);
             if (!pdu) {
                 return nullptr;
             }
@@ -0,0 +1,547 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/SignalManagerShm.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+constexpr uint32_t SHM_RING_MAGIC = 0x534F4B52U;
+constexpr uint32_t SHM_RING_VERSION = 2U;
+constexpr uint32_t SHM_RING_SLOT_COUNT = 64U;
+constexpr size_t SHM_SIGNAL_NAME_MAX_LENGTH = 64U;
+constexpr long SHM_RECEIVE_WAIT_TIMEOUT_NS = 100000000L;
+constexpr uint32_t SHM_OPEN_RETRIES = 100U;
+constexpr uint32_t SHM_OPEN_ATTEMPTS = 3U;
+constexpr char SHM_SEGMENT_PREFIX[] = "/sok_fm_";
+
+struct ShmRingHeader
+{
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotPayloadSize;
+    // the number of rings mapped to the segment, the last one unlinks it
+    uint32_t attachCount;
+    uint32_t unlinked;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint64_t writeSeq;
+};
+
+struct ShmRingSlotHeader
+{
+    char signalName[SHM_SIGNAL_NAME_MAX_LENGTH];
+    uint32_t length;
+};
+
+size_t
+slotSize(uint32_t slotPayloadSize)
+{
+    return sizeof(ShmRingSlotHeader) + slotPayloadSize;
+}
+
+size_t
+segmentSize(uint32_t slotPayloadSize)
+{
+    return sizeof(ShmRingHeader) + (SHM_RING_SLOT_COUNT * slotSize(slotPayloadSize));
+}
+
+int
+lockRing(ShmRingHeader* header)
+{
+    int res = pthread_mutex_lock(&header->mutex);
+    if (EOWNERDEAD == res) {
+        LOGW("Previous owner of a shared memory ring died while holding its lock, recovering");
+        res = pthread_mutex_consistent(&header->mutex);
+    }
+    return res;
+}
+
+bool
+initRingHeader(ShmRingHeader* header, uint32_t slotPayloadSize)
+{
+    pthread_mutexattr_t mutexAttr;
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    int mutexRes = pthread_mutex_init(&header->mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    int condRes = pthread_cond_init(&header->cond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    if ((0 != mutexRes) || (0 != condRes)) {
+        return false;
+    }
+
+    header->version = SHM_RING_VERSION;
+    header->slotCount = SHM_RING_SLOT_COUNT;
+    header->slotPayloadSize = slotPayloadSize;
+    header->attachCount = 1U;
+    header->unlinked = 0U;
+    header->writeSeq = 0U;
+    header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    return true;
+}
+
+bool
+isSameSegment(std::string const& segmentName, int fd)
+{
+    int currentFd = shm_open(segmentName.c_str(), O_RDONLY, 0);
+    if (-1 == currentFd) {
+        return false;
+    }
+    struct stat segmentStat {};
+    struct stat currentStat {};
+    bool isSame = (0 == fstat(fd, &segmentStat)) && (0 == fstat(currentFd, &currentStat))
+        && (segmentStat.st_dev == currentStat.st_dev) && (segmentStat.st_ino == currentStat.st_ino);
+    close(currentFd);
+    return isSame;
+}
+
+void
+unlinkLeftoverSegment(std::string const& segmentName, int fd)
+{
+    // another process may have replaced the leftover segment already
+    if (isSameSegment(segmentName, fd)) {
+        LOGW("Shared memory segment: " << segmentName << " was left over by a crashed run, recreating it");
+        shm_unlink(segmentName.c_str());
+    }
+}
+
+} // namespace
+
+/**
+ * @brief A shared memory ring of a single frame, mapped into this process
+ *
+ */
+struct ShmFrameRing
+{
+    ShmFrameRing(std::string const& frameName, std::string const& segmentName, ShmRingHeader* header, size_t mappedSize)
+    : mFrameName(frameName)
+    , mSegmentName(segmentName)
+    , mHeader(header)
+    , mMappedSize(mappedSize)
+    {
+    }
+
+    ~ShmFrameRing()
+    {
+        if (0 == lockRing(mHeader)) {
+            if (0U == --mHeader->attachCount) {
+                // rings which are mapped later find the flag and open the segment anew
+                mHeader->unlinked = 1U;
+                shm_unlink(mSegmentName.c_str());
+                LOGD("Unlinked shared memory segment: " << mSegmentName);
+            }
+            pthread_mutex_unlock(&mHeader->mutex);
+        }
+        munmap(mHeader, mMappedSize);
+    }
+
+    ShmRingSlotHeader*
+    slot(uint64_t seq) const
+    {
+        auto base = reinterpret_cast<uint8_t*>(mHeader) + sizeof(ShmRingHeader);
+        return reinterpret_cast<ShmRingSlotHeader*>(base + ((seq % mHeader->slotCount) * slotSize(mHeader->slotPayloadSize)));
+    }
+
+    std::string mFrameName;
+    std::string mSegmentName;
+    ShmRingHeader* mHeader;
+    size_t mMappedSize;
+};
+
+struct SignalManagerShm::FrameReceiver
+{
+    std::shared_ptr<ShmFrameRing> ring;
+    std::mutex callbacksMutex;
+    std::unordered_map<std::string, SignalEventCallback> callbacks;
+    std::thread thread;
+};
+
+SignalManagerShm::SignalManagerShm()
+: mStopReceiving(false)
+, mTxBatching(false)
+, mPendingTxMutex()
+, mPendingTxFrames()
+, mRingsMutex()
+, mRings()
+, mReceivers()
+{
+}
+
+SignalManagerShm::~SignalManagerShm()
+{
+    mStopReceiving = true;
+    for (auto& receiver : mReceivers) {
+        if (receiver.second->thread.joinable()) {
+            receiver.second->thread.join();
+        }
+    }
+}
+
+FvmErrorCode
+SignalManagerShm::Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb)
+{
+    std::lock_guard<std::mutex> lock(mRingsMutex);
+
+    auto const& frameName = signalConfig.pduConfig.frameConfig.name;
+    auto receiverFindRes = mReceivers.find(frameName);
+    if (mReceivers.end() != receiverFindRes) {
+        std::lock_guard<std::mutex> cbLock(receiverFindRes->second->callbacksMutex);
+        if (receiverFindRes->second->callbacks.end() != receiverFindRes->second->callbacks.find(signalConfig.name)) {
+            LOGW("Already subscribed to signal with name: " << signalConfig.name);
+            return FvmErrorCode::kAlreadyInitialized;
+        }
+        receiverFindRes->second->callbacks[signalConfig.name] = cb;
+        return FvmErrorCode::kSuccess;
+    }
+
+    auto ring = getOrOpenRing(signalConfig.pduConfig.frameConfig);
+    if (!ring) {
+        return FvmErrorCode::kGeneralError;
+    }
+
+    auto receiver = std::make_shared<FrameReceiver>();
+    receiver->ring = ring;
+    receiver->callbacks[signalConfig.name] = cb;
+    receiver->thread = std::thread(&SignalManagerShm::receiveLoop, this, receiver);
+    mReceivers[frameName] = receiver;
+
+    return FvmErrorCode::kSuccess;
+}
+
+FvmErrorCode
+SignalManagerShm::Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    return publish(signalConfig, value, mTxBatching);
+}
+
+FvmErrorCode
+SignalManagerShm::PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+{
+    return publish(signalConfig, value, false);
+}
+
+FvmErrorCode
+SignalManagerShm::publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value, bool batched)
+{
+    std::shared_ptr<ShmFrameRing> ring;
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        ring = getOrOpenRing(signalConfig.pduConfig.frameConfig);
+    }
+    if (!ring) {
+        return FvmErrorCode::kGeneralError;
+    }
+
+    auto header = ring->mHeader;
+    if ((value.size() > header->slotPayloadSize) || (signalConfig.name.size() >= SHM_SIGNAL_NAME_MAX_LENGTH)) {
+        LOGE("Signal: " << signalConfig.name << " doesn't fit into the shared memory ring of frame: " << ring->mFrameName);
+        return FvmErrorCode::kGeneralError;
+    }
+
+    if (batched) {
+        std::lock_guard<std::mutex> lock(mPendingTxMutex);
+        auto& frameUpdates = mPendingTxFrames[ring->mFrameName];
+        frameUpdates.ring = ring;
+        auto updateFindRes = std::find_if(frameUpdates.updates.begin(), frameUpdates.updates.end(), [&signalConfig](PendingSignalUpdate const& update) {
+            return update.name == signalConfig.name;
+        });
+        // only the latest value of a signal is transmitted
+        if (frameUpdates.updates.end() != updateFindRes) {
+            updateFindRes->value = value;
+        }
+        else {
+            frameUpdates.updates.push_back({signalConfig.name, value});
+        }
+        LOGD("Queued signal: " << signalConfig.name << " for the next flush");
+        return FvmErrorCode::kSuccess;
+    }
+
+    return transmit(ring, {{signalConfig.name, value}});
+}
+
+void
+SignalManagerShm::SetTxBatching(bool enabled)
+{
+    LOGI("Transmit batching " << (enabled ? "enabled" : "disabled"));
+    mTxBatching = enabled;
+}
+
+FvmErrorCode
+SignalManagerShm::Flush()
+{
+    std::unordered_map<std::string, PendingFrameUpdates> pendingTxFrames;
+    {
+        std::lock_guard<std::mutex> lock(mPendingTxMutex);
+        pendingTxFrames.swap(mPendingTxFrames);
+    }
+
+    FvmErrorCode ret = FvmErrorCode::kSuccess;
+    for (auto&& frameUpdates : pendingTxFrames) {
+        if (FvmErrorCode::kSuccess != transmit(frameUpdates.second.ring, frameUpdates.second.updates)) {
+            for (auto&& update : frameUpdates.second.updates) {
+                LOGE("Dropped queued signal: " << update.name << " of frame: " << frameUpdates.first);
+            }
+            ret = FvmErrorCode::kGeneralError;
+        }
+    }
+    return ret;
+}
+
+FvmErrorCode
+SignalManagerShm::transmit(std::shared_ptr<ShmFrameRing> const& ring, std::vector<PendingSignalUpdate> const& updates) const
+{
+    auto header = ring->mHeader;
+    if (0 != lockRing(header)) {
+        LOGE("Failed locking the shared memory ring of frame: " << ring->mFrameName);
+        return FvmErrorCode::kGeneralError;
+    }
+    for (auto&& update : updates) {
+        auto slot = ring->slot(header->writeSeq);
+        std::memset(slot->signalName, 0, SHM_SIGNAL_NAME_MAX_LENGTH);
+        std::memcpy(slot->signalName, update.name.data(), update.name.size());
+        slot->length = static_cast<uint32_t>(update.value.size());
+        std::memcpy(reinterpret_cast<uint8_t*>(slot) + sizeof(ShmRingSlotHeader), update.value.data(), update.value.size());
+        header->writeSeq++;
+        LOGD("Sent successfully signal: " << update.name);
+    }
+    pthread_cond_broadcast(&header->cond);
+    pthread_mutex_unlock(&header->mutex);
+    return FvmErrorCode::kSuccess;
+}
+
+FvmErrorCode
+SignalManagerShm::PrepareOutgoing(SignalConfig const& signalConfig)
+{
+    std::lock_guard<std::mutex> lock(mRingsMutex);
+    if (!getOrOpenRing(signalConfig.pduConfig.frameConfig)) {
+        return FvmErrorCode::kGeneralError;
+    }
+    return FvmErrorCode::kSuccess;
+}
+
+std::shared_ptr<ShmFrameRing>
+SignalManagerShm::getOrOpenRing(FrameConfig const& frameConfig)
+{
+    auto ringFindRes = mRings.find(frameConfig.name);
+    if (mRings.end() != ringFindRes) {
+        return ringFindRes->second;
+    }
+
+    for (uint32_t attempt = 0U; attempt < SHM_OPEN_ATTEMPTS; attempt++) {
+        bool retry = false;
+        auto ring = openRing(frameConfig, retry);
+        if (ring) {
+            mRings[frameConfig.name] = ring;
+            LOGD("Mapped shared memory ring of frame: " << frameConfig.name);
+            return ring;
+        }
+        if (!retry) {
+            return nullptr;
+        }
+    }
+    LOGE("Failed opening the shared memory ring of frame: " << frameConfig.name << " after " << SHM_OPEN_ATTEMPTS << " attempts");
+    return nullptr;
+}
+
+std::shared_ptr<ShmFrameRing>
+SignalManagerShm::openRing(FrameConfig const& frameConfig, bool& retry) const
+{
+    std::string segmentName = SHM_SEGMENT_PREFIX + frameConfig.name;
+    uint32_t slotPayloadSize = frameConfig.maxPayloadSizeBytes;
+    bool isCreator = true;
+
+    int fd = shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+    if ((-1 == fd) && (EEXIST == errno)) {
+        isCreator = false;
+        fd = shm_open(segmentName.c_str(), O_RDWR, 0);
+        if ((-1 == fd) && (ENOENT == errno)) {
+            // the segment was unlinked by its last user in the meantime
+            retry = true;
+            return nullptr;
+        }
+    }
+    if (-1 == fd) {
+        LOGE("Failed opening shared memory segment: " << segmentName << ", errno: " << errno);
+        return nullptr;
+    }
+
+    size_t mappedSize = segmentSize(slotPayloadSize);
+    if (isCreator) {
+        if (0 != ftruncate(fd, static_cast<off_t>(mappedSize))) {
+            LOGE("Failed sizing shared memory segment: " << segmentName << ", errno: " << errno);
+            close(fd);
+            shm_unlink(segmentName.c_str());
+            return nullptr;
+        }
+    }
+    else {
+        // the creator may still be sizing the segment, the size of an existing ring is decided by its creator
+        struct stat segmentStat {};
+        uint32_t retries = 0U;
+        while ((0 == fstat(fd, &segmentStat)) && (static_cast<size_t>(segmentStat.st_size) < sizeof(ShmRingHeader))
+            && (retries++ < SHM_OPEN_RETRIES)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (static_cast<size_t>(segmentStat.st_size) < sizeof(ShmRingHeader)) {
+            // the creator died before setting the segment up
+            unlinkLeftoverSegment(segmentName, fd);
+            close(fd);
+            retry = true;
+            return nullptr;
+        }
+        mappedSize = static_cast<size_t>(segmentStat.st_size);
+    }
+
+    void* mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mapping) {
+        LOGE("Failed mapping shared memory segment: " << segmentName << ", errno: " << errno);
+        close(fd);
+        return nullptr;
+    }
+
+    auto header = static_cast<ShmRingHeader*>(mapping);
+    if (isCreator) {
+        if (!initRingHeader(header, slotPayloadSize)) {
+            LOGE("Failed initializing shared memory segment: " << segmentName);
+            munmap(mapping, mappedSize);
+            close(fd);
+            shm_unlink(segmentName.c_str());
+            return nullptr;
+        }
+    }
+    else {
+        uint32_t retries = 0U;
+        while ((SHM_RING_MAGIC != header->magic.load(std::memory_order_acquire)) && (retries++ < SHM_OPEN_RETRIES)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if ((SHM_RING_MAGIC != header->magic.load(std::memory_order_acquire)) || (SHM_RING_VERSION != header->version)
+            || (mappedSize < segmentSize(header->slotPayloadSize))) {
+            // never initialized by a crashed creator or created by a previous version
+            munmap(mapping, mappedSize);
+            unlinkLeftoverSegment(segmentName, fd);
+            close(fd);
+            retry = true;
+            return nullptr;
+        }
+
+        if (0 != lockRing(header)) {
+            LOGE("Failed locking the shared memory ring of frame: " << frameConfig.name);
+            munmap(mapping, mappedSize);
+            close(fd);
+            return nullptr;
+        }
+        bool unlinked = (0U != header->unlinked);
+        if (!unlinked) {
+            header->attachCount++;
+        }
+        pthread_mutex_unlock(&header->mutex);
+        if (unlinked) {
+            munmap(mapping, mappedSize);
+            close(fd);
+            retry = true;
+            return nullptr;
+        }
+    }
+    close(fd);
+
+    return std::make_shared<ShmFrameRing>(frameConfig.name, segmentName, header, mappedSize);
+}
+
+void
+SignalManagerShm::receiveLoop(std::shared_ptr<FrameReceiver> const& receiver) noexcept
+{
+    try {
+        auto header = receiver->ring->mHeader;
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> events;
+
+        if (0 != lockRing(header)) {
+            LOGE("Failed locking the shared memory ring of frame: " << receiver->ring->mFrameName);
+            return;
+        }
+        // only updates published after the subscription are delivered
+        uint64_t readSeq = header->writeSeq;
+        pthread_mutex_unlock(&header->mutex);
+
+        while (!mStopReceiving) {
+            if (0 != lockRing(header)) {
+                LOGE("Failed locking the shared memory ring of frame: " << receiver->ring->mFrameName);
+                return;
+            }
+            if (readSeq == header->writeSeq) {
+                struct timespec deadline {};
+                clock_gettime(CLOCK_MONOTONIC, &deadline);
+                deadline.tv_nsec += SHM_RECEIVE_WAIT_TIMEOUT_NS;
+                if (deadline.tv_nsec >= 1000000000L) {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000L;
+                }
+                int waitRes = pthread_cond_timedwait(&header->cond, &header->mutex, &deadline);
+                if (EOWNERDEAD == waitRes) {
+                    pthread_mutex_consistent(&header->mutex);
+                }
+            }
+
+            if ((header->writeSeq - readSeq) > header->slotCount) {
+                LOGW("Receiver of frame: " << receiver->ring->mFrameName << " overrun, dropped "
+                     << (header->writeSeq - readSeq - header->slotCount) << " signal updates");
+                readSeq = header->writeSeq - header->slotCount;
+            }
+            events.clear();
+            for (; readSeq != header->writeSeq; readSeq++) {
+                auto slot = receiver->ring->slot(readSeq);
+                auto payload = reinterpret_cast<uint8_t const*>(slot) + sizeof(ShmRingSlotHeader);
+                auto length = std::min(slot->length, header->slotPayloadSize);
+                events.emplace_back(std::string(slot->signalName, strnlen(slot->signalName, SHM_SIGNAL_NAME_MAX_LENGTH)),
+                                    std::vector<uint8_t>(payload, payload + length));
+            }
+            pthread_mutex_unlock(&header->mutex);
+
+            // callbacks are triggered without holding the ring lock so publishers are never blocked by them
+            for (auto const& event : events) {
+                SignalEventCallback cb;
+                {
+                    std::lock_guard<std::mutex> cbLock(receiver->callbacksMutex);
+                    auto cbFindRes = receiver->callbacks.find(event.first);
+                    if (receiver->callbacks.end() == cbFindRes) {
+                        continue;
+                    }
+                    cb = cbFindRes->second;
+                }
+                LOGD("Received signal: " << event.first << ", triggering CB");
+                cb(event.first, event.second);
+            }
+        }
+    } catch (std::exception const& ex) {
+        LOGE("exception, what(): " << ex.what());
+    } catch (...) {
+        LOGE("exception");
+    }
+}
+
+} // namespace fvm
+} // namespace sok
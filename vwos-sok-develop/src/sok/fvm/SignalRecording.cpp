@@ -0,0 +1,136 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include "sok/fvm/SignalRecording.hpp"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include "sok/common/Logger.hpp"
+
+namespace sok
+{
+namespace fvm
+{
+
+namespace
+{
+
+constexpr char RECORDING_MAGIC[8] = {'S', 'O', 'K', 'S', 'R', 'E', 'C', '\0'};
+constexpr uint16_t RECORDING_FORMAT_VERSION = 1;
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+void
+appendLe(std::vector<uint8_t>& buffer, uint64_t value, size_t numOfBytes)
+{
+    for (size_t i = 0; i < numOfBytes; ++i) {
+        buffer.push_back(static_cast<uint8_t>(value >> (8U * i)));
+    }
+}
+
+uint64_t
+readLe(uint8_t const* data, size_t numOfBytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < numOfBytes; ++i) {
+        value |= static_cast<uint64_t>(data[i]) << (8U * i);
+    }
+    return value;
+}
+
+} // namespace
+
+FvmErrorCode
+SignalRecordingWriter::Open(std::string const& path)
+{
+    std::lock_guard<std::mutex> lock(mFileMutex);
+    mFile.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!mFile.is_open()) {
+        LOGE("Failed to open signal recording file: " << path);
+        return FvmErrorCode::kGeneralError;
+    }
+
+    std::vector<uint8_t> header(std::begin(RECORDING_MAGIC), std::end(RECORDING_MAGIC));
+    appendLe(header, RECORDING_FORMAT_VERSION, sizeof(uint16_t));
+    mFile.write(reinterpret_cast<char const*>(header.data()), static_cast<std::streamsize>(header.size()));
+    mFile.flush();
+    return mFile.good() ? FvmErrorCode::kSuccess : FvmErrorCode::kGeneralError;
+}
+
+FvmErrorCode
+SignalRecordingWriter::Write(SignalRecord const& record)
+{
+    if ((record.signalName.size() > std::numeric_limits<uint16_t>::max()) ||
+        (record.payload.size() > std::numeric_limits<uint32_t>::max())) {
+        LOGE("Signal record of " << record.signalName << " exceeds the recording format limits");
+        return FvmErrorCode::kGeneralError;
+    }
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve(RECORD_HEADER_SIZE + record.signalName.size() + record.payload.size());
+    appendLe(buffer, record.timestampNs, sizeof(uint64_t));
+    appendLe(buffer, static_cast<uint8_t>(record.type), sizeof(uint8_t));
+    appendLe(buffer, record.signalName.size(), sizeof(uint16_t));
+    appendLe(buffer, record.payload.size(), sizeof(uint32_t));
+    buffer.insert(buffer.end(), record.signalName.begin(), record.signalName.end());
+    buffer.insert(buffer.end(), record.payload.begin(), record.payload.end());
+
+    std::lock_guard<std::mutex> lock(mFileMutex);
+    if (!mFile.is_open()) {
+        return FvmErrorCode::kNotInitialized;
+    }
+    // records are flushed one by one so that a capture survives an abnormal termination of the process
+    mFile.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    mFile.flush();
+    return mFile.good() ? FvmErrorCode::kSuccess : FvmErrorCode::kGeneralError;
+}
+
+FvmResult<std::vector<SignalRecord>>
+ReadSignalRecording(std::string const& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        LOGE("Failed to open signal recording file: " << path);
+        return FvmResult<std::vector<SignalRecord>>(FvmErrorCode::kGeneralError);
+    }
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t const fileHeaderSize = sizeof(RECORDING_MAGIC) + sizeof(uint16_t);
+    if ((content.size() < fileHeaderSize) ||
+        !std::equal(std::begin(RECORDING_MAGIC), std::end(RECORDING_MAGIC), content.begin(),
+                    [](char a, uint8_t b) { return static_cast<uint8_t>(a) == b; })) {
+        LOGE("Not a signal recording file: " << path);
+        return FvmResult<std::vector<SignalRecord>>(FvmErrorCode::kGeneralError);
+    }
+    auto version = readLe(content.data() + sizeof(RECORDING_MAGIC), sizeof(uint16_t));
+    if (RECORDING_FORMAT_VERSION != version) {
+        LOGE("Unsupported signal recording format version: " << version);
+        return FvmResult<std::vector<SignalRecord>>(FvmErrorCode::kGeneralError);
+    }
+
+    std::vector<SignalRecord> records;
+    size_t offset = fileHeaderSize;
+    while (offset + RECORD_HEADER_SIZE <= content.size()) {
+        uint8_t const* recordHeader = content.data() + offset;
+        SignalRecord record;
+        record.timestampNs = readLe(recordHeader, sizeof(uint64_t));
+        auto type = readLe(recordHeader + 8U, sizeof(uint8_t));
+        auto nameLength = static_cast<size_t>(readLe(recordHeader + 9U, sizeof(uint16_t)));
+        auto payloadLength = static_cast<size_t>(readLe(recordHeader + 11U, sizeof(uint32_t)));
+        offset += RECORD_HEADER_SIZE;
+        if ((type > static_cast<uint8_t>(SignalRecordType::kPublish)) || (offset + nameLength + payloadLength > content.size())) {
+            // a truncated tail is expected if the recording process was terminated while writing
+            LOGW("Signal recording " << path << " is truncated or corrupt after " << records.size() << " records");
+            break;
+        }
+        record.type = static_cast<SignalRecordType>(type);
+        record.signalName.assign(content.begin() + offset, content.begin() + offset + nameLength);
+        offset += nameLength;
+        record.payload.assign(content.begin() + offset, content.begin() + offset + payloadLength);
+        offset += payloadLength;
+        records.push_back(std::move(record));
+    }
+
+    return FvmResult<std::vector<SignalRecord>>(std::move(records));
+}
+
+} // namespace fvm
+} // namespace sok
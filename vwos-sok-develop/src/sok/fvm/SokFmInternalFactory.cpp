@@ -6,7 +6,11 @@
 #include "MockFreshnessValueManagerConfigAccessor.hpp"
 #include "MockFvmRuntimeAttributesManager.hpp"
 #else
+#ifdef SOK_FM_SHM_SIGNAL_TRANSPORT
+#include "sok/fvm/SignalManagerShm.hpp"
+#else
 #include "sok/fvm/SignalManagerSci.hpp"
+#endif  // SOK_FM_SHM_SIGNAL_TRANSPORT
 #include "sok/fvm/FreshnessValueManagerConfigAccessor.hpp"
 #include "sok/fvm/FvmRuntimeAttributesManager.hpp"
 #endif  // UNIT_TESTS
@@ -21,6 +25,8 @@ SokFmInternalFactory::CreateSignalManager()
 {
 #ifdef UNIT_TESTS
     return std::make_shared<UTSignalManager>();
+#elif defined(SOK_FM_SHM_SIGNAL_TRANSPORT)
+    return std::make_shared<SignalManagerShm>();
 #else
     return std::make_shared<SignalManagerSci>();
 #endif  // UNIT_TESTS
@@ -46,5 +52,42 @@ SokFmInternalFactory::CreateFvmRuntimeAttributesManager()
 #endif  // UNIT_TESTS
 }
 
+std::shared_ptr<ISignalManager>
+SokFmInternalFactory::CreateSignalManager(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor)
+{
+#ifdef UNIT_TESTS
+    (void)configAccessor;
+    return std::make_shared<UTSignalManager>();
+#elif defined(SOK_FM_SHM_SIGNAL_TRANSPORT)
+    (void)configAccessor;
+    return std::make_shared<SignalManagerShm>();
+#else
+    return std::make_shared<SignalManagerSci>(std::move(configAccessor));
+#endif  // UNIT_TESTS
+}
+
+std::shared_ptr<IFreshnessValueManagerConfigAccessor>
+SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor(FvmRole role, std::string const& configFile)
+{
+#ifdef UNIT_TESTS
+    (void)role;
+    (void)configFile;
+    return std::make_shared<UTFreshnessValueManagerConfigAccessor>();
+#else
+    return FreshnessValueManagerConfigAccessor::Create(role, configFile);
+#endif  // UNIT_TESTS
+}
+
+std::shared_ptr<IFvmRuntimeAttributesManager>
+SokFmInternalFactory::CreateFvmRuntimeAttributesManager(std::shared_ptr<IFreshnessValueManagerConfigAccessor> configAccessor)
+{
+#ifdef UNIT_TESTS
+    (void)configAccessor;
+    return std::make_shared<UTFvmRuntimeAttributesManager>();
+#else
+    return std::make_shared<FvmRuntimeAttributesManager>(std::move(configAccessor));
+#endif  // UNIT_TESTS
+}
+
 }  // namespace fvm
 }  // namespace sok
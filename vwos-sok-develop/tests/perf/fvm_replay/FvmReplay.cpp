@@ -0,0 +1,151 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+// Plays a signal recording (see "signal_recording_file" of the FVM configuration) into an FVM
+// instance and reports its processing times.
+//
+// usage: sok_fm_replay_<role> <config file> <recording file> [--fast] [--seed <n>] [--output <file>]
+//   --fast    run the virtual clock as fast as possible instead of 1x
+//   --seed    seed of the random numbers of the FVM and of its CSM accessor, default 1
+//   --output  write the published signals as a recording, runs with the same configuration,
+//             recording and seed write identical files
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include "sok/common/CsmAccessorDemo.hpp"
+#include "sok/fvm/FvmReplayDriver.hpp"
+#include "sok/fvm/SignalRecording.hpp"
+#include "sok/fvm/SokFmInternalFactory.hpp"
+#ifdef SOK_FVM_SERVER
+#include "sok/fvm/FreshnessValueManagerImplServer.hpp"
+#else
+#include "sok/fvm/FreshnessValueManagerImplParticipant.hpp"
+#endif
+
+using namespace sok::fvm;
+
+namespace
+{
+
+std::map<std::string, uint64_t>
+countPublications(std::vector<SignalRecord> const& records)
+{
+    std::map<std::string, uint64_t> publications;
+    for (auto&& record : records) {
+        if (SignalRecordType::kPublish == record.type) {
+            ++publications[record.signalName];
+        }
+    }
+    return publications;
+}
+
+bool
+writePublications(std::string const& path, std::vector<SignalRecord> const& published)
+{
+    SignalRecordingWriter writer;
+    if (FvmErrorCode::kSuccess != writer.Open(path)) {
+        return false;
+    }
+    for (auto&& record : published) {
+        if (FvmErrorCode::kSuccess != writer.Write(record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <config file> <recording file> [--fast] [--seed <n>] [--output <file>]" << std::endl;
+        return 1;
+    }
+    auto speed = ReplaySpeed::kRealTime;
+    uint32_t seed = 1U;
+    std::string outputFile;
+    for (int i = 3; i < argc; ++i) {
+        if (0 == std::strcmp(argv[i], "--fast")) {
+            speed = ReplaySpeed::kAsFastAsPossible;
+        }
+        else if ((0 == std::strcmp(argv[i], "--seed")) && ((i + 1) < argc)) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if ((0 == std::strcmp(argv[i], "--output")) && ((i + 1) < argc)) {
+            outputFile = argv[++i];
+        }
+        else {
+            std::cerr << "unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    auto readRes = ReadSignalRecording(argv[2]);
+    if (readRes.isFailed()) {
+        return 1;
+    }
+    auto records = readRes.getObject();
+
+    // the configuration of the replay is read from the given file instead of the process wide one
+#ifdef SOK_FVM_SERVER
+    auto configAccessor = SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor(FvmRole::kServer, argv[1]);
+#else
+    auto configAccessor = SokFmInternalFactory::CreateFreshnessValueManagerConfigAccessor(FvmRole::kParticipant, argv[1]);
+#endif
+    if (nullptr == configAccessor) {
+        std::cerr << "reading the configuration failed" << std::endl;
+        return 1;
+    }
+
+    // the FVM takes its time stamps from the virtual clock of the replay and its random numbers from the seed
+    auto signalManager = std::make_shared<SignalManagerReplay>();
+    std::weak_ptr<SignalManagerReplay> virtualClock = signalManager;
+    FvmDependencies dependencies{std::make_shared<sok::common::CsmAccessorDemo>(seed), signalManager, nullptr, configAccessor,
+        [virtualClock]() {
+            auto signalManager = virtualClock.lock();
+            auto virtualNs = (nullptr != signalManager) ? signalManager->GetVirtualTime() : 0U;
+            return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(virtualNs));
+        },
+        seed};
+#ifdef SOK_FVM_SERVER
+    FreshnessValueManagerImplServer fvm(std::move(dependencies));
+#else
+    FreshnessValueManagerImplParticipant fvm(std::move(dependencies));
+#endif
+    if (FvmErrorCode::kSuccess != fvm.Init()) {
+        std::cerr << "FVM initialization failed" << std::endl;
+        return 1;
+    }
+
+    FvmReplayDriver driver(fvm, signalManager);
+    auto statistics = driver.Run(records, speed);
+
+    auto cycles = (0U == statistics.mainFunctionCycles) ? 1U : statistics.mainFunctionCycles;
+    std::cout << "MainFunction cycles:       " << statistics.mainFunctionCycles << " (" << statistics.mainFunctionErrors << " failed)" << std::endl;
+    std::cout << "incoming signals:          " << statistics.deliveredSignals << " delivered, " << statistics.droppedSignals << " not subscribed" << std::endl;
+    std::cout << "signal processing:         " << statistics.signalProcessingTime.count() / 1000 << " us total" << std::endl;
+    std::cout << "MainFunction:              " << statistics.mainFunctionTime.count() / 1000 << " us total, "
+              << statistics.mainFunctionTime.count() / cycles << " ns avg, " << statistics.maxMainFunctionTime.count() << " ns max" << std::endl;
+
+    auto recorded = countPublications(records);
+    auto replayed = countPublications(statistics.publishedSignals);
+    for (auto&& signal : replayed) {
+        recorded.emplace(signal.first, 0U);
+    }
+    std::cout << "published signals (recorded / replayed):" << std::endl;
+    for (auto&& signal : recorded) {
+        std::cout << "  " << signal.first << ": " << signal.second << " / " << replayed[signal.first] << std::endl;
+    }
+
+    if (!outputFile.empty() && !writePublications(outputFile, statistics.publishedSignals)) {
+        std::cerr << "writing the published signals failed" << std::endl;
+        fvm.Deinit();
+        return 1;
+    }
+
+    fvm.Deinit();
+    return 0;
+}
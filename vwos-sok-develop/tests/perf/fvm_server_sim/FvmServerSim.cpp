@@ -0,0 +1,616 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+// Runs one FVM server and N FVM participants in one process, connected by an in-memory signal bus
+// and driven by a virtual clock of SOK_FM_MAIN_FUNCTION_PERIOD_MS steps, and reports how fast the
+// server answers the authentic FV requests of its participants.
+//
+// usage: sok_fm_server_sim [--participants <n>] [--pattern cold|storm|steady] [--duration-ms <ms>]
+//                          [--resync-ms <ms>] [--mac-cost-us <us>] [--seed <n>] [--retry-base-ms <ms>]
+//                          [--retry-max-ms <ms>]
+//   --participants  number of virtual participants, 100 by default
+//   --pattern       challenge arrival pattern, cold by default
+//                     cold:   server and participants start together
+//                     storm:  all participants wake up within STORM_WINDOW_MS while the server is running
+//                     steady: every participant re-synchronizes once per --resync-ms at a random phase
+//   --duration-ms   simulated time, 5000 ms by default
+//   --resync-ms     re-synchronization period of the steady pattern, 2000 ms by default
+//   --mac-cost-us   busy time added to every MAC created by the server, to emulate the crypto hardware
+//   --seed          seed of the wake up times and of the challenges, 1 by default
+//   --retry-base-ms --retry-max-ms
+//                   FV request retry policy of the participants, disabled by default
+//
+// The server's MainFunction runs in wall-clock time: a cycle which takes longer than
+// SOK_FM_MAIN_FUNCTION_PERIOD_MS makes the server skip the cycles it overran, like on the target.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sok/common/CsmAccessorDemo.hpp"
+#include "sok/common/FlatStringMap.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/FreshnessValueManagerImplParticipant.hpp"
+#include "sok/fvm/FreshnessValueManagerImplServer.hpp"
+#include "sok/fvm/FvmRuntimeAttributesManager.hpp"
+
+using namespace sok::fvm;
+using namespace sok::common;
+
+namespace
+{
+
+constexpr uint64_t STORM_START_MS = 1000;
+constexpr uint64_t STORM_WINDOW_MS = 50;
+constexpr uint32_t SIGNAL_LENGTH_BITS = 64;
+
+enum class ArrivalPattern : uint8_t {
+    kColdStart,
+    kWakeUpStorm,
+    kSteadyState
+};
+
+struct SimOptions {
+    size_t participants = 100;
+    ArrivalPattern pattern = ArrivalPattern::kColdStart;
+    uint64_t durationMs = 5000;
+    uint64_t resyncMs = 2000;
+    uint32_t macCostUs = 0;
+    uint32_t seed = 1;
+    uint32_t retryBaseMs = 0;
+    uint32_t retryMaxMs = 0;
+};
+
+class SimSignalPort;
+
+/**
+ * @brief Delivers every published signal synchronously to all subscribers of its name.
+ *
+ * Signals are delivered with their configured length, shorter values are zero extended at the front
+ * like an unsigned integer signal in its PDU. Subscriptions end with the port of the subscriber.
+ */
+class SimSignalBus
+{
+public:
+    using PublishObserver = std::function<void(std::string const& signalName)>;
+
+    void SetObserver(PublishObserver observer) { mObserver = std::move(observer); }
+
+    void Subscribe(std::weak_ptr<SimSignalPort> port, std::string const& signalName, ISignalManager::SignalEventCallback const& cb)
+    {
+        mSubscriptions[signalName].push_back({std::move(port), cb});
+    }
+
+    void Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value)
+    {
+        if (mObserver) {
+            mObserver(signalConfig.name);
+        }
+        auto subscribers = mSubscriptions.Find(signalConfig.name);
+        if (nullptr == subscribers) {
+            return;
+        }
+        std::vector<uint8_t> framed(value);
+        size_t const lengthBytes = signalConfig.lengthInBits / 8U;
+        if (framed.size() < lengthBytes) {
+            framed.insert(framed.begin(), lengthBytes - framed.size(), 0U);
+        }
+        auto expired = std::remove_if(subscribers->begin(), subscribers->end(), [](Subscription const& subscription) {
+            return subscription.port.expired();
+        });
+        subscribers->erase(expired, subscribers->end());
+        // the callbacks may subscribe, thus the subscribers are copied
+        auto const receivers = *subscribers;
+        for (auto&& receiver : receivers) {
+            if (!receiver.port.expired()) {
+                receiver.cb(signalConfig.name, framed);
+            }
+        }
+    }
+
+private:
+    struct Subscription {
+        std::weak_ptr<SimSignalPort> port;
+        ISignalManager::SignalEventCallback cb;
+    };
+
+    FlatStringMap<std::vector<Subscription>> mSubscriptions;
+    PublishObserver mObserver;
+};
+
+/**
+ * @brief The signal manager of one simulated FVM instance, its subscriptions are dropped with it
+ */
+class SimSignalPort : public ISignalManager, public std::enable_shared_from_this<SimSignalPort>
+{
+public:
+    explicit SimSignalPort(SimSignalBus& bus) : mBus(bus) {}
+
+    FvmErrorCode Subscribe(SignalConfig const& signalConfig, SignalEventCallback const& cb) override
+    {
+        mBus.Subscribe(shared_from_this(), signalConfig.name, cb);
+        return FvmErrorCode::kSuccess;
+    }
+
+    FvmErrorCode Publish(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override
+    {
+        mBus.Publish(signalConfig, value);
+        return FvmErrorCode::kSuccess;
+    }
+
+    FvmErrorCode PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override
+    {
+        return Publish(signalConfig, value);
+    }
+
+    FvmErrorCode PrepareOutgoing(SignalConfig const& signalConfig) override
+    {
+        (void)signalConfig;
+        return FvmErrorCode::kSuccess;
+    }
+
+    // the bus has no transmit buffer, thus there is nothing to batch
+    void SetTxBatching(bool enabled) override { (void)enabled; }
+    FvmErrorCode Flush() override { return FvmErrorCode::kSuccess; }
+
+private:
+    SimSignalBus& mBus;
+};
+
+/**
+ * @brief Configuration of one simulated FVM instance, without any FV IDs of its own
+ */
+class SimConfigAccessor : public IFreshnessValueManagerConfigAccessor
+{
+public:
+    explicit SimConfigAccessor(SokFmConfig config) : mConfig(std::move(config)) {}
+
+    bool Init() override { return true; }
+
+    FvmResult<SokFvConfigInstance> GetSokFvConfigInstanceByFvId(SokFreshnessValueId id) const override
+    {
+        (void)id;
+        return FvmResult<SokFvConfigInstance>(FvmErrorCode::kGeneralError);
+    }
+    FvmResult<ChallengeConfigInstance> GetChallengeConfigInstanceByFvId(SokFreshnessValueId id) const override
+    {
+        (void)id;
+        return FvmResult<ChallengeConfigInstance>(FvmErrorCode::kGeneralError);
+    }
+    FvmResult<SokFreshnessType> GetEntryTypeByFvId(SokFreshnessValueId id) const override
+    {
+        (void)id;
+        return FvmResult<SokFreshnessType>(FvmErrorCode::kGeneralError);
+    }
+
+    std::vector<SokFreshnessValueId> GetAllFreshnessValueIds() const override { return {}; }
+    std::vector<SokFreshnessValueId> GetAllAuthBroadcastFreshnessValueIds() const override { return {}; }
+    std::vector<SokFreshnessValueId> GetAllChallengeFreshnessValueIds() const override { return {}; }
+    FmServerClientsConfigMap GetClientsConfigMap() const override { return mConfig.mFmServerClientsConfig; }
+    std::string GetEcuName() const override { return mConfig.mEcuName; }
+    std::string GetNetworkInterface() const override { return mConfig.mNetworkInterface; }
+    SignalConfig GetUnauthenticatedFvSignalConfig() const override { return mConfig.mUnAuthFvDistributionSignal; }
+    SignalConfig GetAuthenticatedFvValueSignalConfig() const override { return mConfig.mAuthFvValueSignal; }
+    SignalConfig GetAuthenticatedFvSignatureSignalConfig() const override { return mConfig.mAuthFvSignatureSignal; }
+    SignalConfig GetAuthenticatedFvChallengeSignalConfig() const override { return mConfig.mAuthFvChallengeSignal; }
+    SokKeyConfig GetSokKeyConfig() const override { return mConfig.mKeyConfig; }
+    uint16_t GetEcuKeyIdForFvDistribution() const override { return mConfig.mKeyIdForAuthFvDistribution; }
+    bool IsSignalTxBatchingEnabled() const override { return false; }
+    std::string GetSignalRecordingFile() const override { return {}; }
+    std::string GetFvCheckpointFile() const override { return {}; }
+    bool IsEventDrivenProcessingEnabled() const override { return false; }
+    FvmRole GetEcuFunction() const override { return mConfig.mEcuFunction; }
+    std::string GetGatewayParticipantConfigFile() const override { return {}; }
+    GroupFvBroadcastConfig GetGroupFvBroadcastConfig() const override { return mConfig.mGroupFvBroadcast; }
+    TimeServerEndpoints GetRedundantTimeServers() const override { return mConfig.mRedundantTimeServers; }
+    FvRequestRetryPolicy GetFvRequestRetryPolicy() const override { return mConfig.mFvRequestRetryPolicy; }
+    FvDaemonConfig GetFvDaemonConfig() const override { return mConfig.mFvDaemon; }
+    CrIndicationExecutorConfig GetCrIndicationExecutorConfig() const override { return mConfig.mCrIndicationExecutor; }
+
+private:
+    SokFmConfig mConfig;
+};
+
+/**
+ * @brief Demo CSM of the server, counts the created MACs and optionally spends a fixed time on each
+ */
+class SimServerCsmAccessor : public CsmAccessorDemo
+{
+public:
+    explicit SimServerCsmAccessor(uint32_t macCostUs) : mMacCost(std::chrono::microseconds(macCostUs)) {}
+
+    CsmResult<std::vector<uint8_t>> MacCreate(uint16_t keyId, std::vector<uint8_t> const& data, MacAlgorithm alg) const override
+    {
+        auto const busyUntil = std::chrono::steady_clock::now() + mMacCost;
+        auto ret = CsmAccessorDemo::MacCreate(keyId, data, alg);
+        while (std::chrono::steady_clock::now() < busyUntil) {
+        }
+        ++mMacCount;
+        return ret;
+    }
+
+    uint64_t GetMacCount() const { return mMacCount; }
+
+private:
+    std::chrono::nanoseconds mMacCost;
+    mutable uint64_t mMacCount = 0;
+};
+
+class SimParticipant : public FreshnessValueManagerImplParticipant
+{
+public:
+    using FreshnessValueManagerImplParticipant::FreshnessValueManagerImplParticipant;
+
+    bool IsFvValid() const { return mIsFvValid; }
+};
+
+SignalConfig
+simSignal(std::string name)
+{
+    SignalConfig signal{};
+    signal.name = std::move(name);
+    signal.lengthInBits = SIGNAL_LENGTH_BITS;
+    return signal;
+}
+
+std::string
+ecuName(size_t index)
+{
+    return "SIM_ECU" + std::to_string(index);
+}
+
+uint16_t
+ecuKeyId(size_t index)
+{
+    return static_cast<uint16_t>(1000U + (index % 60000U));
+}
+
+SokFmConfig
+participantConfig(size_t index)
+{
+    SokFmConfig config{};
+    config.mEcuName = ecuName(index);
+    config.mEcuFunction = FvmRole::kParticipant;
+    config.mKeyIdForAuthFvDistribution = ecuKeyId(index);
+    config.mUnAuthFvDistributionSignal = simSignal("SIM_Zeit_Unauth");
+    config.mAuthFvChallengeSignal = simSignal(config.mEcuName + "_Challenge");
+    config.mAuthFvValueSignal = simSignal(config.mEcuName + "_Zeit");
+    config.mAuthFvSignatureSignal = simSignal(config.mEcuName + "_Signature");
+    return config;
+}
+
+SokFmConfig
+serverConfig(size_t participants)
+{
+    SokFmConfig config{};
+    config.mEcuName = "SIM_SERVER";
+    config.mEcuFunction = FvmRole::kServer;
+    config.mUnAuthFvDistributionSignal = simSignal("SIM_Zeit_Unauth");
+    for (size_t i = 0; i < participants; ++i) {
+        auto client = participantConfig(i);
+        config.mFmServerClientsConfig[client.mEcuName] = SokFvClientConfigArrayInstance{
+            client.mAuthFvChallengeSignal, client.mAuthFvValueSignal, client.mAuthFvSignatureSignal, client.mKeyIdForAuthFvDistribution};
+    }
+    return config;
+}
+
+/**
+ * @brief Percentiles of a set of samples, in the unit of the samples
+ */
+void
+printPercentiles(std::string const& title, std::vector<uint64_t> samples)
+{
+    std::cout << title;
+    if (samples.empty()) {
+        std::cout << "n/a" << std::endl;
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](size_t p) {
+        return samples[(p * (samples.size() - 1U)) / 100U];
+    };
+    std::cout << "p50 " << percentile(50) << ", p90 " << percentile(90) << ", p99 " << percentile(99)
+              << ", max " << samples.back() << " (" << samples.size() << " samples)" << std::endl;
+}
+
+class ServerSimulation
+{
+public:
+    explicit ServerSimulation(SimOptions const& options)
+    : mOptions(options)
+    , mRandom(options.seed)
+    , mBus()
+    , mServerCsm(std::make_shared<SimServerCsmAccessor>(options.macCostUs))
+    , mParticipantCsm(std::make_shared<CsmAccessorDemo>())
+    , mServer()
+    , mParticipants(options.participants)
+    , mSignalRoutes()
+    {
+        // the demo CSM draws its challenges from rand(), seeded here for reproducible runs
+        std::srand(options.seed);
+    }
+
+    bool Run()
+    {
+        auto serverConf = std::make_shared<SimConfigAccessor>(serverConfig(mOptions.participants));
+        mServer.reset(new FreshnessValueManagerImplServer(FvmDependencies{
+            mServerCsm, std::make_shared<SimSignalPort>(mBus), std::make_shared<FvmRuntimeAttributesManager>(serverConf), serverConf, nullptr, 0U}));
+        if (FvmErrorCode::kSuccess != mServer->Init()) {
+            std::cerr << "FVM server initialization failed" << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < mParticipants.size(); ++i) {
+            auto& participant = mParticipants[i];
+            auto config = participantConfig(i);
+            config.mFvRequestRetryPolicy = FvRequestRetryPolicy{0U != mOptions.retryBaseMs, mOptions.retryBaseMs,
+                                                                std::max(mOptions.retryBaseMs, mOptions.retryMaxMs)};
+            participant.config = std::make_shared<SimConfigAccessor>(config);
+            participant.wakeUpMs = firstWakeUp();
+            mSignalRoutes[participant.config->GetAuthenticatedFvChallengeSignalConfig().name] = {i, SignalRole::kChallenge};
+            mSignalRoutes[participant.config->GetAuthenticatedFvSignatureSignalConfig().name] = {i, SignalRole::kResponse};
+        }
+        mBus.SetObserver([this](std::string const& signalName) {
+            this->onPublish(signalName);
+        });
+
+        for (mNowMs = 0; mNowMs < mOptions.durationMs; mNowMs += SOK_FM_MAIN_FUNCTION_PERIOD_MS) {
+            wakeUpParticipants();
+            runServerCycle();
+            for (auto&& participant : mParticipants) {
+                if (participant.fvm) {
+                    participant.fvm->MainFunction();
+                }
+            }
+            collectValidFvs();
+        }
+        report();
+        return true;
+    }
+
+private:
+    enum class SignalRole : uint8_t {
+        kChallenge,
+        kResponse
+    };
+
+    struct SignalRoute {
+        size_t participant;
+        SignalRole role;
+    };
+
+    struct ParticipantState {
+        std::shared_ptr<SimConfigAccessor> config;
+        std::unique_ptr<SimParticipant> fvm;
+        uint64_t wakeUpMs = 0;
+        uint64_t startMs = 0;
+        uint64_t challengeMs = 0;
+        bool challengePending = false;
+        bool validReported = false;
+    };
+
+    uint64_t firstWakeUp()
+    {
+        switch (mOptions.pattern) {
+            case ArrivalPattern::kWakeUpStorm:
+                return STORM_START_MS + std::uniform_int_distribution<uint64_t>(0, STORM_WINDOW_MS - 1U)(mRandom);
+            case ArrivalPattern::kSteadyState:
+                return std::uniform_int_distribution<uint64_t>(0, mOptions.resyncMs - 1U)(mRandom);
+            case ArrivalPattern::kColdStart:
+            default:
+                return 0;
+        }
+    }
+
+    // a participant wakes up as a new instance, like after a sleep phase of its ECU
+    void wakeUpParticipants()
+    {
+        for (auto&& participant : mParticipants) {
+            if (participant.wakeUpMs > mNowMs) {
+                continue;
+            }
+            participant.fvm.reset(new SimParticipant(FvmDependencies{
+                mParticipantCsm, std::make_shared<SimSignalPort>(mBus),
+                std::make_shared<FvmRuntimeAttributesManager>(participant.config), participant.config, nullptr, 0U}));
+            if (FvmErrorCode::kSuccess != participant.fvm->Init()) {
+                ++mParticipantInitErrors;
+            }
+            participant.startMs = mNowMs;
+            participant.challengePending = false;
+            participant.validReported = false;
+            participant.wakeUpMs = (ArrivalPattern::kSteadyState == mOptions.pattern) ? (mNowMs + mOptions.resyncMs) : UINT64_MAX;
+            ++mWakeUps;
+        }
+    }
+
+    void runServerCycle()
+    {
+        if (mNowMs < mServerBusyUntilMs) {
+            ++mServerSkippedCycles;
+            return;
+        }
+        auto const start = std::chrono::steady_clock::now();
+        mServer->MainFunction();
+        auto const duration = std::chrono::steady_clock::now() - start;
+        mServerTime += duration;
+        mServerMaxCycleTime = std::max(mServerMaxCycleTime, std::chrono::duration_cast<std::chrono::nanoseconds>(duration));
+
+        auto const durationMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+        if (durationMs >= SOK_FM_MAIN_FUNCTION_PERIOD_MS) {
+            ++mServerOverruns;
+            mServerBusyUntilMs = mNowMs + (durationMs / SOK_FM_MAIN_FUNCTION_PERIOD_MS + 1U) * SOK_FM_MAIN_FUNCTION_PERIOD_MS;
+        }
+    }
+
+    void onPublish(std::string const& signalName)
+    {
+        auto route = mSignalRoutes.Find(signalName);
+        if (nullptr == route) {
+            return;
+        }
+        auto& participant = mParticipants[route->participant];
+        if (SignalRole::kChallenge == route->role) {
+            ++mChallenges;
+            if (participant.challengePending) {
+                ++mRepeatedChallenges;
+            }
+            participant.challengeMs = mNowMs;
+            participant.challengePending = true;
+        }
+        else {
+            ++mResponses;
+            if (participant.challengePending) {
+                mResponseLatenciesMs.push_back(mNowMs - participant.challengeMs);
+                participant.challengePending = false;
+            }
+        }
+    }
+
+    void collectValidFvs()
+    {
+        for (auto&& participant : mParticipants) {
+            if (participant.fvm && !participant.validReported && participant.fvm->IsFvValid()) {
+                mTimesToValidFvMs.push_back(mNowMs - participant.startMs);
+                participant.validReported = true;
+            }
+        }
+    }
+
+    void report() const
+    {
+        static char const* const patternNames[] = {"cold start", "wake-up storm", "steady state"};
+        size_t neverValid = 0;
+        for (auto&& participant : mParticipants) {
+            if (participant.fvm && !participant.validReported) {
+                ++neverValid;
+            }
+        }
+        auto withinTimeout = std::count_if(mResponseLatenciesMs.begin(), mResponseLatenciesMs.end(), [](uint64_t latency) {
+            return latency <= SOK_FM_TIME_REQUEST_TIMEOUT_MS;
+        });
+        auto serverTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(mServerTime).count();
+        auto macs = mServerCsm->GetMacCount();
+
+        std::cout << "participants:              " << mParticipants.size() << ", " << patternNames[static_cast<size_t>(mOptions.pattern)]
+                  << ", " << mOptions.durationMs << " ms simulated" << std::endl;
+        std::cout << "participant wake-ups:      " << mWakeUps << " (" << mParticipantInitErrors << " failed)" << std::endl;
+        std::cout << "challenges:                " << mChallenges << " (" << mRepeatedChallenges << " repeated without response)" << std::endl;
+        std::cout << "responses:                 " << mResponses << ", " << withinTimeout << " of " << mResponseLatenciesMs.size()
+                  << " answered challenges within SOK_FM_TIME_REQUEST_TIMEOUT_MS (" << static_cast<uint32_t>(SOK_FM_TIME_REQUEST_TIMEOUT_MS) << " ms)" << std::endl;
+        printPercentiles("response latency [ms]:     ", mResponseLatenciesMs);
+        printPercentiles("time to valid FV [ms]:     ", mTimesToValidFvMs);
+        std::cout << "  running without valid FV: " << neverValid << std::endl;
+        std::cout << "server MainFunction:       " << serverTimeNs / 1000 << " us total, " << mServerMaxCycleTime.count() / 1000 << " us max, "
+                  << mServerOverruns << " overruns, " << mServerSkippedCycles << " cycles skipped" << std::endl;
+        std::cout << "server MACs:               " << macs << ", "
+                  << ((0 == serverTimeNs) ? 0U : static_cast<uint64_t>((macs * 1000000000.0) / static_cast<double>(serverTimeNs)))
+                  << " per second of MainFunction time" << std::endl;
+
+        // the server's own view, as read through the client health list diagnostics
+        size_t neverAnswered = 0;
+        uint32_t maxLatencyMs = 0;
+        uint64_t dropped = 0;
+        for (auto&& health : mServer->GetClientHealth()) {
+            neverAnswered += (0U == health.responses) ? 1U : 0U;
+            maxLatencyMs = std::max(maxLatencyMs, health.maxResponseLatencyMs);
+            dropped += health.droppedChallenges;
+        }
+        std::cout << "server client health:      " << neverAnswered << " never answered, " << dropped << " challenges dropped, "
+                  << maxLatencyMs << " ms max response latency" << std::endl;
+    }
+
+private:
+    SimOptions mOptions;
+    std::mt19937 mRandom;
+    SimSignalBus mBus;
+    std::shared_ptr<SimServerCsmAccessor> mServerCsm;
+    std::shared_ptr<CsmAccessorDemo> mParticipantCsm;
+    std::unique_ptr<FreshnessValueManagerImplServer> mServer;
+    std::vector<ParticipantState> mParticipants;
+    FlatStringMap<SignalRoute> mSignalRoutes;
+
+    uint64_t mNowMs = 0;
+    uint64_t mServerBusyUntilMs = 0;
+    uint64_t mWakeUps = 0;
+    uint64_t mParticipantInitErrors = 0;
+    uint64_t mChallenges = 0;
+    uint64_t mRepeatedChallenges = 0;
+    uint64_t mResponses = 0;
+    uint64_t mServerOverruns = 0;
+    uint64_t mServerSkippedCycles = 0;
+    std::chrono::steady_clock::duration mServerTime{0};
+    std::chrono::nanoseconds mServerMaxCycleTime{0};
+    std::vector<uint64_t> mResponseLatenciesMs;
+    std::vector<uint64_t> mTimesToValidFvMs;
+};
+
+bool
+parseOptions(int argc, char* argv[], SimOptions& options)
+{
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string const option(argv[i]);
+        std::string const value(argv[i + 1]);
+        if ("--participants" == option) {
+            options.participants = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if ("--pattern" == option) {
+            if ("cold" == value) {
+                options.pattern = ArrivalPattern::kColdStart;
+            }
+            else if ("storm" == value) {
+                options.pattern = ArrivalPattern::kWakeUpStorm;
+            }
+            else if ("steady" == value) {
+                options.pattern = ArrivalPattern::kSteadyState;
+            }
+            else {
+                return false;
+            }
+        }
+        else if ("--duration-ms" == option) {
+            options.durationMs = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if ("--resync-ms" == option) {
+            options.resyncMs = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if ("--mac-cost-us" == option) {
+            options.macCostUs = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if ("--seed" == option) {
+            options.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if ("--retry-base-ms" == option) {
+            options.retryBaseMs = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if ("--retry-max-ms" == option) {
+            options.retryMaxMs = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else {
+            return false;
+        }
+    }
+    return (0U != options.participants) && (0U != options.resyncMs);
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    SimOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--participants <n>] [--pattern cold|storm|steady] [--duration-ms <ms>]"
+                  << " [--resync-ms <ms>] [--mac-cost-us <us>] [--seed <n>] [--retry-base-ms <ms>] [--retry-max-ms <ms>]" << std::endl;
+        return 1;
+    }
+
+    ServerSimulation simulation(options);
+    return simulation.Run() ? 0 : 1;
+}
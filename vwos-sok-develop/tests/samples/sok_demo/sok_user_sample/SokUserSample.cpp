@@ -184,11 +184,11 @@ SokUser::OfferCrService(pdu_id pduId, std::vector<uint8_t> const& responseData,
         return false;
     }
 
+    // runs on the challenge indication executor of the FVM, see "cr_indication_executor" in its configuration
     auto cb = [=](SokFreshnessValueId fvID) {
         static std::string responseString = std::string(responseData.begin(), responseData.end());
         LOGD("App response to challenge CB was triggered with FV ID: " << fvID << ", Responding with data: " << responseString);
-        std::thread t([&](){SendAuthPdu(pduId, responseData, signalConf);});
-        t.detach();
+        SendAuthPdu(pduId, responseData, signalConf);
     };
 
     if (FvmErrorCode::kSuccess != mFvm->OfferCrRequest(pduId, cb)) {
@@ -45,4 +45,18 @@ TEST_F(CsmAccessorDemoTest, GenerateRandomBytes)
     EXPECT_EQ(csmAccessorDemo.MacVerify(111,vector2.getObject(),mac2.getObject(),MacAlgorithm::kSipHash24), CsmErrorCode::kSuccess);
     EXPECT_EQ(csmAccessorDemo.MacVerify(111,vector1.getObject(),mac2.getObject(),MacAlgorithm::kSipHash24), CsmErrorCode::kErrorRng);
     EXPECT_EQ(csmAccessorDemo.MacVerify(111,vector2.getObject(),mac1.getObject(),MacAlgorithm::kSipHash24), CsmErrorCode::kErrorRng);
-}
\ No newline at end of file
+}
+
+TEST_F(CsmAccessorDemoTest, GenerateRandomBytesRepeatableWithSeed)
+{
+    CsmAccessorDemo csmAccessorDemo1(42U);
+    CsmAccessorDemo csmAccessorDemo2(42U);
+    CsmAccessorDemo csmAccessorDemo3(43U);
+
+    auto first = csmAccessorDemo1.GenerateRandomBytes(16).getObject();
+    EXPECT_EQ(first, csmAccessorDemo2.GenerateRandomBytes(16).getObject());
+    EXPECT_NE(first, csmAccessorDemo3.GenerateRandomBytes(16).getObject());
+    // the sequence continues instead of restarting
+    EXPECT_EQ(csmAccessorDemo1.GenerateRandomBytes(16).getObject(), csmAccessorDemo2.GenerateRandomBytes(16).getObject());
+    EXPECT_NE(first, csmAccessorDemo1.GenerateRandomBytes(16).getObject());
+}
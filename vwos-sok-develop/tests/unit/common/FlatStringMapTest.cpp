@@ -0,0 +1,75 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <map>
+#include "sok/common/FlatStringMap.hpp"
+
+using namespace sok::common;
+
+class FlatStringMapTest : public ::testing::Test
+{
+
+};
+
+TEST_F(FlatStringMapTest, EmplaceAndFind)
+{
+    FlatStringMap<uint16_t> map;
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(nullptr, map.Find("SOK_Zeit_ECU1_Challenge"));
+
+    auto emplaceRes = map.Emplace("SOK_Zeit_ECU1_Challenge", 1);
+    ASSERT_NE(nullptr, emplaceRes.first);
+    EXPECT_TRUE(emplaceRes.second);
+    EXPECT_EQ(1U, *emplaceRes.first);
+
+    // an existing value is not overwritten
+    emplaceRes = map.Emplace("SOK_Zeit_ECU1_Challenge", 2);
+    EXPECT_FALSE(emplaceRes.second);
+    EXPECT_EQ(1U, *emplaceRes.first);
+    EXPECT_EQ(1U, map.Size());
+
+    map["SOK_Zeit_ECU2_Challenge"] = 2;
+    ASSERT_NE(nullptr, map.Find("SOK_Zeit_ECU2_Challenge"));
+    EXPECT_EQ(2U, *map.Find("SOK_Zeit_ECU2_Challenge"));
+    EXPECT_TRUE(map.Contains("SOK_Zeit_ECU1_Challenge"));
+    EXPECT_FALSE(map.Contains("SOK_Zeit_ECU3_Challenge"));
+    EXPECT_FALSE(map.Contains(""));
+}
+
+TEST_F(FlatStringMapTest, FindWithoutStringConstruction)
+{
+    FlatStringMap<int> map;
+    map["ECU1"] = 1;
+    char const buffer[] = "SOK_Zeit_ECU1_Challenge";
+
+    ASSERT_NE(nullptr, map.Find(buffer + 9, 4));
+    EXPECT_EQ(1, *map.Find(buffer + 9, 4));
+    EXPECT_EQ(nullptr, map.Find(buffer + 9, 3));
+}
+
+TEST_F(FlatStringMapTest, GrowKeepsAllEntries)
+{
+    FlatStringMap<size_t> map;
+    std::map<std::string, size_t> reference;
+    for (size_t i = 0; i < 1000; ++i) {
+        auto key = "signal_" + std::to_string(i);
+        map[key] = i;
+        reference[key] = i;
+    }
+
+    EXPECT_EQ(reference.size(), map.Size());
+    for (auto&& entry : reference) {
+        ASSERT_NE(nullptr, map.Find(entry.first));
+        EXPECT_EQ(entry.second, *map.Find(entry.first));
+    }
+    size_t visited = 0;
+    map.ForEach([&](std::string const& key, size_t& value) {
+        EXPECT_EQ(reference[key], value);
+        ++visited;
+    });
+    EXPECT_EQ(reference.size(), visited);
+
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(nullptr, map.Find("signal_1"));
+}
@@ -0,0 +1,93 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "sok/common/TimerWheel.hpp"
+
+using namespace sok::common;
+
+class TimerWheelTest : public ::testing::Test
+{
+public:
+    TimerWheelTest()
+    : mWheel(5, 8)
+    {
+    }
+
+    std::vector<int> advance(uint64_t nowMs)
+    {
+        std::vector<int> expired;
+        mWheel.Advance(nowMs, [&expired](TimerWheel<int>::TimerId, int value) {
+            expired.push_back(value);
+        });
+        return expired;
+    }
+
+    TimerWheel<int> mWheel;
+};
+
+TEST_F(TimerWheelTest, ScheduleAndExpire)
+{
+    EXPECT_TRUE(mWheel.Empty());
+    auto id = mWheel.Schedule(0, 20, 1);
+    EXPECT_NE(TimerWheel<int>::INVALID_TIMER_ID, id);
+    mWheel.Schedule(0, 12, 2);
+    EXPECT_EQ(2U, mWheel.Size());
+
+    EXPECT_TRUE(advance(10).empty());
+    // expiry is rounded up to the tick
+    EXPECT_EQ(std::vector<int>{2}, advance(15));
+    EXPECT_TRUE(advance(19).empty());
+    EXPECT_EQ(std::vector<int>{1}, advance(20));
+    EXPECT_TRUE(mWheel.Empty());
+}
+
+TEST_F(TimerWheelTest, CancelBeforeExpiry)
+{
+    auto first = mWheel.Schedule(0, 20, 1);
+    auto second = mWheel.Schedule(0, 20, 2);
+    EXPECT_TRUE(mWheel.Cancel(first));
+    EXPECT_FALSE(mWheel.Cancel(first));
+    EXPECT_EQ(1U, mWheel.Size());
+
+    EXPECT_EQ(std::vector<int>{2}, advance(25));
+    // an expired timer cannot be cancelled anymore
+    EXPECT_FALSE(mWheel.Cancel(second));
+}
+
+TEST_F(TimerWheelTest, TimeoutBeyondOneRevolution)
+{
+    // one revolution covers 40 ms
+    mWheel.Schedule(0, 100, 1);
+    mWheel.Schedule(0, 10, 2);
+    EXPECT_EQ(std::vector<int>{2}, advance(45));
+    EXPECT_TRUE(advance(95).empty());
+    EXPECT_EQ(std::vector<int>{1}, advance(100));
+}
+
+TEST_F(TimerWheelTest, AdvanceSkippingRevolutions)
+{
+    mWheel.Schedule(0, 10, 1);
+    mWheel.Schedule(0, 30, 2);
+    mWheel.Schedule(0, 500, 3);
+    auto expired = advance(300);
+    std::sort(expired.begin(), expired.end());
+    EXPECT_EQ((std::vector<int>{1, 2}), expired);
+    EXPECT_EQ(std::vector<int>{3}, advance(500));
+}
+
+TEST_F(TimerWheelTest, ScheduleInThePastExpiresOnNextAdvance)
+{
+    advance(100);
+    mWheel.Schedule(50, 10, 1);
+    EXPECT_TRUE(advance(100).empty());
+    EXPECT_EQ(std::vector<int>{1}, advance(105));
+
+    mWheel.Schedule(105, 10, 2);
+    mWheel.Clear();
+    EXPECT_TRUE(mWheel.Empty());
+    // the time restarts after clearing
+    mWheel.Schedule(0, 10, 3);
+    EXPECT_EQ(std::vector<int>{3}, advance(10));
+}
@@ -1,9 +1,14 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include <gtest/gtest.h>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 #include <thread>
 #include <numeric>
+#include <unistd.h>
 #include "sok/fvm/AFreshnessValueManagerImpl.hpp"
+#include "sok/fvm/SignalManagerShm.hpp"
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
 #include "sok/fvm/FvmRuntimeAttributesManager.hpp"
 #include "sok/common/SokUtilities.hpp"
@@ -39,21 +44,35 @@ public:
         return true;
     }
 
+    std::vector<SignalConfig>
+    serverOrParticipantOutgoingSignals() noexcept override
+    {
+        return {};
+    }
+
     bool 
     registerToSignals() noexcept
     {
         return AFreshnessValueManagerImpl::registerToSignals();
     }
 
+    bool 
+    startCrIndicationExecutor() noexcept
+    {
+        return AFreshnessValueManagerImpl::startCrIndicationExecutor();
+    }
+
     void setFv(uint64_t fv) 
     {
         mFV = fv;
         mIsFvValid = true;
+        publishFvState(true);
     }
 
     void setTimeSinceInit(uint64_t time) 
     {
         mTimeSinceInit = time;
+        publishFvState(false);
     }
 
     uint64_t getFv() 
@@ -71,6 +90,11 @@ public:
         mInitialized = status;
     }
 
+    void setSignalManager(std::shared_ptr<ISignalManager> const& signalManager) 
+    {
+        mSignalManager = signalManager;
+    }
+
     void setRealAttrMgr(std::vector<SokFvConfigInstance> const& configs) 
     {
         std::vector<SokFreshnessValueId> ids(configs.size());
@@ -208,7 +232,7 @@ TEST_F(AFreshnessValueManagerTest, cr_trigger_and_receive_response_success)
     // expected mock calls
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(1).WillOnce(Return(FvmResult<ChallengeConfigInstance>(mTestChallengeConfigInstance)));
     EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(sigValue)));
-    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestChallengeConfigInstance.challengeSignalConfig, sigValue)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, PublishUnbatched(mTestChallengeConfigInstance.challengeSignalConfig, sigValue)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).Times(3).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrChallenge)));
 
     // trigger CR
@@ -228,6 +252,277 @@ TEST_F(AFreshnessValueManagerTest, cr_trigger_and_receive_response_success)
     EXPECT_FALSE(result.isSucceeded());
 }
 
+TEST_F(AFreshnessValueManagerTest, cr_concurrent_sessions_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    std::vector<std::vector<uint8_t>> challenges;
+    for (uint8_t i = 0; i <= SOK_FM_MAX_CR_SESSIONS_PER_FV_ID; ++i) {
+        challenges.push_back({0x1,0x2,0x3,0x4,0x5,0x6,0x7,static_cast<uint8_t>(0x10 + i)});
+    }
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(SOK_FM_MAX_CR_SESSIONS_PER_FV_ID).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(mTestChallengeConfigInstance)));
+    auto& randomBytesCall = EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).Times(SOK_FM_MAX_CR_SESSIONS_PER_FV_ID);
+    for (uint8_t i = 0; i < SOK_FM_MAX_CR_SESSIONS_PER_FV_ID; ++i) {
+        randomBytesCall.WillOnce(Return(CsmResult<std::vector<uint8_t>>(challenges[i])));
+    }
+    EXPECT_CALL(*UTSignalManager::mMockSm, PublishUnbatched(mTestChallengeConfigInstance.challengeSignalConfig, _)).Times(SOK_FM_MAX_CR_SESSIONS_PER_FV_ID).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrChallenge)));
+
+    // trigger CRs until all sessions are pending
+    for (uint8_t i = 0; i < SOK_FM_MAX_CR_SESSIONS_PER_FV_ID; ++i) {
+        ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->TriggerCrRequest(testId));
+    }
+    EXPECT_EQ(FvmErrorCode::kGeneralError, mFvm->TriggerCrRequest(testId));
+
+    // the verify attempts walk the pending challenges, newest first
+    for (uint8_t i = 0; i < SOK_FM_MAX_CR_SESSIONS_PER_FV_ID; ++i) {
+        auto result = mFvm->GetRxFreshness(testId, {}, i);
+        ASSERT_TRUE(result.isSucceeded());
+        EXPECT_EQ(challenges[SOK_FM_MAX_CR_SESSIONS_PER_FV_ID - 1 - i], result.getObject());
+    }
+    EXPECT_FALSE(mFvm->GetRxFreshness(testId, {}, SOK_FM_MAX_CR_SESSIONS_PER_FV_ID).isSucceeded());
+
+    // a truncated challenge selects its session, the verified session completes
+    auto result = mFvm->GetRxFreshness(testId, {0x10}, 0);
+    ASSERT_TRUE(result.isSucceeded());
+    EXPECT_EQ(challenges[0], result.getObject());
+    mFvm->VerificationStatusCallout(SecOC_VerificationStatusType{testId, true});
+    EXPECT_FALSE(mFvm->GetRxFreshness(testId, {0x10}, 0).isSucceeded());
+
+    // the other sessions are still pending
+    result = mFvm->GetRxFreshness(testId, {0x11}, 0);
+    ASSERT_TRUE(result.isSucceeded());
+    EXPECT_EQ(challenges[1], result.getObject());
+}
+
+TEST_F(AFreshnessValueManagerTest, cr_triggers_within_one_cycle_all_transmitted_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    std::vector<uint8_t> firstChallenge{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10};
+    std::vector<uint8_t> secondChallenge{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11};
+    auto challengeConfigInstance = mTestChallengeConfigInstance;
+    challengeConfigInstance.challengeSignalConfig.pduConfig.frameConfig.name = "SOK_CR_TEST_FRAME_" + std::to_string(getpid());
+    std::mutex receivedMutex;
+    std::condition_variable receivedCv;
+    std::vector<std::vector<uint8_t>> received;
+    SignalManagerShm receiver;
+    auto sender = std::make_shared<SignalManagerShm>();
+    sender->SetTxBatching(true);
+    mFvm->setSignalManager(sender);
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(2).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(challengeConfigInstance)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).Times(2)
+        .WillOnce(Return(CsmResult<std::vector<uint8_t>>(firstChallenge)))
+        .WillOnce(Return(CsmResult<std::vector<uint8_t>>(secondChallenge)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrChallenge)));
+    ASSERT_EQ(FvmErrorCode::kSuccess, receiver.Subscribe(challengeConfigInstance.challengeSignalConfig, [&](std::string const&, std::vector<uint8_t> const& value) {
+        std::lock_guard<std::mutex> lock(receivedMutex);
+        received.push_back(value);
+        receivedCv.notify_all();
+    }));
+    // give the receiver thread the chance to take its starting position in the ring
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // the transmit batching would keep only the latest challenge of the cycle, both have to reach the responder
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->TriggerCrRequest(testId));
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->TriggerCrRequest(testId));
+    std::unique_lock<std::mutex> lock(receivedMutex);
+    ASSERT_TRUE(receivedCv.wait_for(lock, std::chrono::seconds(2), [&received]() { return 2U == received.size(); }));
+    EXPECT_EQ((std::vector<std::vector<uint8_t>>{firstChallenge, secondChallenge}), received);
+}
+
+TEST_F(AFreshnessValueManagerTest, cr_interleaved_verifications_complete_their_sessions_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    std::vector<uint8_t> firstChallenge{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10};
+    std::vector<uint8_t> secondChallenge{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11};
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(2).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(mTestChallengeConfigInstance)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).Times(2)
+        .WillOnce(Return(CsmResult<std::vector<uint8_t>>(firstChallenge)))
+        .WillOnce(Return(CsmResult<std::vector<uint8_t>>(secondChallenge)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, PublishUnbatched(mTestChallengeConfigInstance.challengeSignalConfig, _)).Times(2).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrChallenge)));
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->TriggerCrRequest(testId));
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->TriggerCrRequest(testId));
+
+    // the responses of both sessions are being verified before the first status arrives
+    ASSERT_EQ(firstChallenge, mFvm->GetRxFreshness(testId, {0x10}, 0).getObject());
+    ASSERT_EQ(secondChallenge, mFvm->GetRxFreshness(testId, {0x11}, 0).getObject());
+
+    // the first status belongs to the first response, it completes the first session only
+    mFvm->VerificationStatusCallout(SecOC_VerificationStatusType{testId, true});
+    EXPECT_FALSE(mFvm->GetRxFreshness(testId, {0x10}, 0).isSucceeded());
+
+    // a failed verification of the second response leaves its session pending
+    mFvm->VerificationStatusCallout(SecOC_VerificationStatusType{testId, false});
+    ASSERT_EQ(secondChallenge, mFvm->GetRxFreshness(testId, {0x11}, 0).getObject());
+    mFvm->VerificationStatusCallout(SecOC_VerificationStatusType{testId, true});
+    EXPECT_FALSE(mFvm->GetRxFreshness(testId, {0x11}, 0).isSucceeded());
+
+    // a status without a response being verified is ignored
+    mFvm->VerificationStatusCallout(SecOC_VerificationStatusType{testId, true});
+}
+
+TEST_F(AFreshnessValueManagerTest, cr_incoming_sessions_expire_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    ISignalManager::SignalEventCallback cb;
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAllChallengeFreshnessValueIds()).Times(1).WillOnce(Return(std::vector<SokFreshnessValueId>{testId}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(1).WillOnce(Return(FvmResult<ChallengeConfigInstance>(mTestCrResponderConfigInstance)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestCrResponderConfigInstance.challengeSignalConfig, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&cb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrResponse)));
+    ASSERT_TRUE(mFvm->registerToSignals());
+    size_t indications = 0;
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->OfferCrRequest(testId, [&indications](SokFreshnessValueId) {
+        indications++;
+    }));
+
+    // concurrent challenges are indicated, a repeated one and those beyond the pending sessions are dropped
+    auto const& signal = mTestCrResponderConfigInstance.challengeSignalConfig.name;
+    for (uint8_t i = 0; i <= SOK_FM_MAX_CR_SESSIONS_PER_FV_ID; ++i) {
+        cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,static_cast<uint8_t>(0x10 + i)});
+    }
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10});
+    EXPECT_EQ(static_cast<size_t>(SOK_FM_MAX_CR_SESSIONS_PER_FV_ID), indications);
+
+    // the challenges are answered in the order of their arrival
+    auto result = mFvm->GetTxFreshness(testId);
+    ASSERT_TRUE(result.isSucceeded());
+    EXPECT_EQ((std::vector<uint8_t>{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10}), result.getObject());
+
+    // the unanswered challenges time out
+    for (size_t i = 0; i <= (SOK_FM_CHALLENGE_TIMEOUT_MS / SOK_FM_MAIN_FUNCTION_PERIOD_MS); ++i) {
+        ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->MainFunction());
+    }
+    EXPECT_FALSE(mFvm->GetTxFreshness(testId).isSucceeded());
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11});
+    EXPECT_EQ(static_cast<size_t>(SOK_FM_MAX_CR_SESSIONS_PER_FV_ID + 1), indications);
+}
+
+TEST_F(AFreshnessValueManagerTest, cr_indication_on_executor_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    ISignalManager::SignalEventCallback cb;
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetCrIndicationExecutorConfig()).Times(1).WillOnce(Return(CrIndicationExecutorConfig{true, 1, 1}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAllChallengeFreshnessValueIds()).Times(1).WillOnce(Return(std::vector<SokFreshnessValueId>{testId}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(1).WillOnce(Return(FvmResult<ChallengeConfigInstance>(mTestCrResponderConfigInstance)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestCrResponderConfigInstance.challengeSignalConfig, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&cb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrResponse)));
+    ASSERT_TRUE(mFvm->startCrIndicationExecutor());
+    ASSERT_TRUE(mFvm->registerToSignals());
+
+    // the first indication blocks the single thread of the executor
+    std::promise<std::thread::id> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::atomic<size_t> indications(0);
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->OfferCrRequest(testId, [&started, releaseFuture, &indications](SokFreshnessValueId) {
+        if (0U == indications++) {
+            started.set_value(std::this_thread::get_id());
+            releaseFuture.wait();
+        }
+    }));
+    auto const& signal = mTestCrResponderConfigInstance.challengeSignalConfig.name;
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10});
+    auto startedFuture = started.get_future();
+    ASSERT_EQ(std::future_status::ready, startedFuture.wait_for(std::chrono::seconds(5)));
+    EXPECT_NE(std::this_thread::get_id(), startedFuture.get());
+
+    // the second indication waits in the queue, the third does not fit and its challenge is dropped
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11});
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x12});
+    auto info = mFvm->GetCrIndicationInfo();
+    EXPECT_EQ(2U, info.indications);
+    EXPECT_EQ(1U, info.queueOverflows);
+    release.set_value();
+
+    auto result = mFvm->GetTxFreshness(testId);
+    ASSERT_TRUE(result.isSucceeded());
+    EXPECT_EQ((std::vector<uint8_t>{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10}), result.getObject());
+    result = mFvm->GetTxFreshness(testId);
+    ASSERT_TRUE(result.isSucceeded());
+    EXPECT_EQ((std::vector<uint8_t>{0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11}), result.getObject());
+    EXPECT_FALSE(mFvm->GetTxFreshness(testId).isSucceeded());
+}
+
+TEST_F(AFreshnessValueManagerTest, deinit_stops_cr_indication_executor_success)
+{
+    // setup
+    SokFreshnessValueId testId = 0;
+    ISignalManager::SignalEventCallback cb;
+    mFvm->setInitialized(true);
+    mFvm->setFv(0x1234567812345678);
+
+    // expected mock calls
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetCrIndicationExecutorConfig()).Times(2).WillRepeatedly(Return(CrIndicationExecutorConfig{true, 1, 1}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAllChallengeFreshnessValueIds()).Times(2).WillRepeatedly(Return(std::vector<SokFreshnessValueId>{testId}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(testId)).Times(2).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(mTestCrResponderConfigInstance)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestCrResponderConfigInstance.challengeSignalConfig, _)).Times(2).WillRepeatedly(DoAll(SaveArg<1>(&cb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(testId)).WillRepeatedly(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessCrResponse)));
+    EXPECT_CALL(*UTFvmRuntimeAttributesManager::mMockFvmAttrMgr, Reset()).Times(1);
+    ASSERT_TRUE(mFvm->startCrIndicationExecutor());
+    ASSERT_TRUE(mFvm->registerToSignals());
+
+    // the first indication blocks the single thread of the executor, the second one waits in the queue
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::atomic<size_t> indications(0);
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->OfferCrRequest(testId, [&started, releaseFuture, &indications](SokFreshnessValueId) {
+        if (0U == indications++) {
+            started.set_value();
+            releaseFuture.wait();
+        }
+    }));
+    auto const& signal = mTestCrResponderConfigInstance.challengeSignalConfig.name;
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x10});
+    ASSERT_EQ(std::future_status::ready, started.get_future().wait_for(std::chrono::seconds(5)));
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x11});
+
+    // Deinit waits for the running indication, the waiting one is dropped
+    auto deinitResult = std::async(std::launch::async, [this]() { return mFvm->Deinit(); });
+    EXPECT_EQ(std::future_status::timeout, deinitResult.wait_for(std::chrono::milliseconds(50)));
+    release.set_value();
+    ASSERT_EQ(std::future_status::ready, deinitResult.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(FvmErrorCode::kSuccess, deinitResult.get());
+    EXPECT_EQ(1U, indications);
+
+    // the offer is kept, a challenge after the next Init is indicated
+    ASSERT_TRUE(mFvm->startCrIndicationExecutor());
+    ASSERT_TRUE(mFvm->registerToSignals());
+    cb(signal, {0x1,0x2,0x3,0x4,0x5,0x6,0x7,0x12});
+    for (uint32_t i = 0; (i < 500U) && (2U != indications); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(2U, indications);
+    auto info = mFvm->GetCrIndicationInfo();
+    EXPECT_EQ(3U, info.indications);
+    EXPECT_EQ(0U, info.queueOverflows);
+}
+
 TEST_F(AFreshnessValueManagerTest, rx_fv_first_occurrence_success)
 {
     // setup
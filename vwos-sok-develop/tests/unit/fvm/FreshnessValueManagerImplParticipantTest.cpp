@@ -1,6 +1,7 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include <gtest/gtest.h>
+#include <future>
 #include <thread>
 #include "sok/fvm/FreshnessValueManagerImplParticipant.hpp"
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
@@ -14,12 +15,20 @@ using ::testing::DoAll;
 using ::testing::SaveArg;
 using ::testing::_;
 using ::testing::Return;
+using ::testing::Invoke;
 using namespace sok::fvm;
 using namespace sok::common;
 
 class FreshnessValueManagerImplParticipantStub : public FreshnessValueManagerImplParticipant {
 public:
 
+    FreshnessValueManagerImplParticipantStub() = default;
+
+    explicit FreshnessValueManagerImplParticipantStub(FvmDependencies dependencies)
+    : FreshnessValueManagerImplParticipant(std::move(dependencies))
+    {
+    }
+
     bool 
     stub_serverOrParticipantInit()
     {
@@ -29,10 +38,12 @@ public:
     void setFv(uint64_t fv) {
         mFV = fv;
         mIsFvValid = true;
+        publishFvState(true);
     }
 
     void setTimeSinceInit(uint64_t time) {
         mTimeSinceInit = time;
+        publishFvState(false);
     }
 
     uint64_t getFv() {
@@ -46,6 +57,10 @@ public:
     void setInitialized(bool status) {
         mInitialized = status;
     }
+
+    void setSteadyClock(std::chrono::steady_clock::time_point const* now) {
+        mSteadyNow = [now]() { return *now; };
+    }
 };
 
 class FreshnessValueManagerImplParticipantTest : public ::testing::Test
@@ -161,6 +176,95 @@ TEST_F(FreshnessValueManagerImplParticipantTest, auth_time_req_unanswered_iter_s
     }
 }
 
+TEST_F(FreshnessValueManagerImplParticipantTest, auth_time_req_retry_backoff_success)
+{
+    std::vector<uint8_t> bytes{0,0,0,0,0,0,0x1,0x2};
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    FvRequestRetryPolicy retryPolicy{true, 200, 800};
+    ISignalManager::SignalEventCallback authSignalCb;
+    uint16_t iterations = 1000;
+    uint32_t maxRequests = ((iterations * SOK_FM_MAIN_FUNCTION_PERIOD_MS) / SOK_FM_TIME_REQUEST_TIMEOUT_MS) + 1U;
+    uint32_t minRequests = (iterations * SOK_FM_MAIN_FUNCTION_PERIOD_MS) / (SOK_FM_TIME_REQUEST_TIMEOUT_MS + retryPolicy.maxDelayMs + 2 * SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvRequestRetryPolicy()).Times(1).WillOnce(Return(retryPolicy));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).WillRepeatedly(Return(CsmResult<std::vector<uint8_t>>(bytes)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvChallengeSignalConfig()).WillRepeatedly(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal1, bytes)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(mTestKeyId, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    for (int i = 0 ; i < iterations ; i++) {
+        EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    }
+
+    // the unanswered requests are repeated after a growing, randomized delay
+    auto retryInfo = mFvm->GetFvRequestRetryInfo();
+    EXPECT_LE(retryInfo.requests, maxRequests);
+    EXPECT_GE(retryInfo.requests, minRequests);
+    EXPECT_GE(retryInfo.timeouts + 1U, retryInfo.requests);
+    EXPECT_EQ(retryInfo.timeouts, retryInfo.consecutiveRetries);
+    EXPECT_LE(retryInfo.lastBackoffMs, retryPolicy.maxDelayMs);
+
+    // answer the next request, the retries start over
+    auto requests = retryInfo.requests;
+    for (int i = 0 ; (i < iterations) && (requests == mFvm->GetFvRequestRetryInfo().requests) ; i++) {
+        EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    }
+    authSignalCb(mTestSignal1.name, UintToByteVector<uint64_t>(56454));
+    authSignalCb(mTestSignal2.name, mac);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    EXPECT_EQ(56454U, mFvm->getFv());
+    EXPECT_EQ(0U, mFvm->GetFvRequestRetryInfo().consecutiveRetries);
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, auth_time_req_first_retry_jittered_success)
+{
+    std::vector<uint8_t> bytes{0,0,0,0,0,0,0x1,0x2};
+    FvRequestRetryPolicy retryPolicy{true, 200, 800};
+    uint16_t iterations = 200;
+    std::vector<int> publishCycles;
+    int cycle = 0;
+    // a seeded backoff, the collaborators are the mocks of the internal factories
+    mFvm = std::make_shared<FreshnessValueManagerImplParticipantStub>(FvmDependencies{nullptr, nullptr, nullptr, nullptr, nullptr, 12345U});
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvRequestRetryPolicy()).Times(1).WillOnce(Return(retryPolicy));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).WillRepeatedly(Return(CsmResult<std::vector<uint8_t>>(bytes)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvChallengeSignalConfig()).WillRepeatedly(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal1, bytes)).WillRepeatedly(Invoke([&](SignalConfig const&, std::vector<uint8_t> const&) {
+        publishCycles.push_back(cycle);
+        return FvmErrorCode::kSuccess;
+    }));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    for (; (cycle < iterations) && (publishCycles.size() < 2U) ; cycle++) {
+        EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    }
+
+    // the first retry is sent after the timeout and its backoff, not right after the timeout
+    ASSERT_EQ(2U, publishCycles.size());
+    auto retryInfo = mFvm->GetFvRequestRetryInfo();
+    EXPECT_EQ(1U, retryInfo.timeouts);
+    EXPECT_GT(retryInfo.lastBackoffMs, SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+    EXPECT_LE(retryInfo.lastBackoffMs, retryPolicy.baseDelayMs);
+    uint32_t retryDelayMs = static_cast<uint32_t>(publishCycles[1] - publishCycles[0]) * SOK_FM_MAIN_FUNCTION_PERIOD_MS;
+    EXPECT_GE(retryDelayMs, SOK_FM_TIME_REQUEST_TIMEOUT_MS + retryInfo.lastBackoffMs);
+    EXPECT_LE(retryDelayMs, SOK_FM_TIME_REQUEST_TIMEOUT_MS + retryInfo.lastBackoffMs + 2U * SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+}
+
 TEST_F(FreshnessValueManagerImplParticipantTest, unauth_fv_event_success)
 {   
     std::vector<uint8_t> bytes{0x1,0x2};
@@ -172,7 +276,7 @@ TEST_F(FreshnessValueManagerImplParticipantTest, unauth_fv_event_success)
     EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
-    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(2).WillRepeatedly(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
     EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal1, _)).Times(3).WillOnce(Return(FvmErrorCode::kSuccess)).WillOnce(Return(FvmErrorCode::kSuccess)).WillOnce(DoAll(SaveArg<1>(&unAuthSignalCb), Return(FvmErrorCode::kSuccess)));
     authTimeReqSuccessCalls(bytes);
 
@@ -196,9 +300,9 @@ TEST_F(FreshnessValueManagerImplParticipantTest, auth_fv_receive_success)
 
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
     EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
-    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(2).WillRepeatedly(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
     EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillOnce(Return(FvmErrorCode::kSuccess)).WillOnce(Return(FvmErrorCode::kSuccess));
-    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(2).WillRepeatedly(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
     EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
     authTimeReqSuccessCalls(challenge);
     EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, verificationData, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
@@ -209,4 +313,337 @@ TEST_F(FreshnessValueManagerImplParticipantTest, auth_fv_receive_success)
     authSignalCb(mTestSignal2.name, mac);
     EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger handling of auth time
     EXPECT_EQ(mFvm->getFv(), authTime);
-}
\ No newline at end of file
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, auth_fv_adopted_with_round_trip_phase_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    auto serializedAuthTime = UintToByteVector<uint64_t>(authTime);
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    ISignalManager::SignalEventCallback authSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    authTimeReqSuccessCalls(challenge);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    std::chrono::steady_clock::time_point now{};
+    mFvm->setSteadyClock(&now);
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    // the challenge arrived right before the server's FV increment, the round trip is twice the transmission
+    now += std::chrono::milliseconds(8);
+    authSignalCb(mTestSignal1.name, serializedAuthTime);
+    authSignalCb(mTestSignal2.name, mac);
+    now += std::chrono::milliseconds(10);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger handling of auth time
+
+    // the wait for the MainFunction and the transmission have passed since the server sent the FV,
+    // the MainFunction counted its own period on top
+    EXPECT_EQ(authTime, mFvm->getFv());
+    EXPECT_EQ(10U + 4U + SOK_FM_MAIN_FUNCTION_PERIOD_MS, mFvm->getClockCount());
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, auth_fv_long_round_trip_not_sampled_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    auto serializedAuthTime = UintToByteVector<uint64_t>(authTime);
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    ISignalManager::SignalEventCallback authSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    authTimeReqSuccessCalls(challenge);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    std::chrono::steady_clock::time_point now{};
+    mFvm->setSteadyClock(&now);
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    // the challenge was held by the server until its next FV increment, the round trip is no sample of the transmission
+    now += std::chrono::milliseconds(80);
+    authSignalCb(mTestSignal1.name, serializedAuthTime);
+    authSignalCb(mTestSignal2.name, mac);
+    now += std::chrono::milliseconds(10);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger handling of auth time
+
+    // only the wait for the MainFunction has passed since the server sent the FV, the phase stays aligned to the server.
+    // The MainFunction counted its own period on top
+    EXPECT_EQ(authTime, mFvm->getFv());
+    EXPECT_EQ(10U + SOK_FM_MAIN_FUNCTION_PERIOD_MS, mFvm->getClockCount());
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, event_driven_auth_fv_processed_without_main_function_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    ISignalManager::SignalEventCallback authSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, IsEventDrivenProcessingEnabled()).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    authTimeReqSuccessCalls(challenge);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    authSignalCb(mTestSignal1.name, UintToByteVector<uint64_t>(authTime));
+    authSignalCb(mTestSignal2.name, mac);
+
+    // verified by the executor, the next MainFunction is not waited for
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((mFvm->getFv() != authTime) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(mFvm->getFv(), authTime);
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, event_driven_deinit_waits_for_running_processing_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    ISignalManager::SignalEventCallback authSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, IsEventDrivenProcessingEnabled()).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFvmRuntimeAttributesManager::mMockFvmAttrMgr, Reset()).Times(1);
+    authTimeReqSuccessCalls(challenge);
+
+    // the verification on the executor blocks until released
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce([&started, releaseFuture](uint16_t, std::vector<uint8_t> const&, std::vector<uint8_t> const&, MacAlgorithm) {
+        started.set_value();
+        releaseFuture.wait();
+        return CsmErrorCode::kSuccess;
+    });
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    authSignalCb(mTestSignal1.name, UintToByteVector<uint64_t>(authTime));
+    authSignalCb(mTestSignal2.name, mac);
+    ASSERT_EQ(std::future_status::ready, started.get_future().wait_for(std::chrono::seconds(5)));
+
+    // Deinit resets the FV only after the running processing took the authentic FV over
+    auto deinitResult = std::async(std::launch::async, [this]() { return mFvm->Deinit(); });
+    EXPECT_EQ(std::future_status::timeout, deinitResult.wait_for(std::chrono::milliseconds(50)));
+    release.set_value();
+    ASSERT_EQ(std::future_status::ready, deinitResult.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(FvmErrorCode::kSuccess, deinitResult.get());
+    EXPECT_EQ(0U, mFvm->getFv());
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, unauth_fv_drift_slewed_without_resync_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    ISignalManager::SignalEventCallback authSignalCb;
+    ISignalManager::SignalEventCallback unAuthSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(3)
+        .WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess)))
+        .WillOnce(Return(FvmErrorCode::kSuccess))
+        .WillOnce(DoAll(SaveArg<1>(&unAuthSignalCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    // a single challenge, the drift never reaches the jitter limit
+    authTimeReqSuccessCalls(challenge);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    authSignalCb(mTestSignal1.name, UintToByteVector<uint64_t>(authTime));
+    authSignalCb(mTestSignal2.name, mac);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger handling of auth time
+
+    // the server's clock runs 300 ppm faster, without slewing the offset would exceed the jitter limit after ~2 minutes
+    double const serverRate = 1.0003;
+    uint64_t elapsedMs = SOK_FM_MAIN_FUNCTION_PERIOD_MS;
+    uint64_t serverTimeMs = 0;
+    for (int cycle = 0; cycle < 40000; ++cycle) {
+        serverTimeMs = (authTime * SOK_FM_TIME_INCREMENT_PERIOD_MS) + static_cast<uint64_t>(elapsedMs * serverRate);
+        uint64_t previousServerTimeMs = (authTime * SOK_FM_TIME_INCREMENT_PERIOD_MS)
+            + static_cast<uint64_t>((elapsedMs - SOK_FM_MAIN_FUNCTION_PERIOD_MS) * serverRate);
+        if ((serverTimeMs / SOK_FM_TIME_SEND_MS) != (previousServerTimeMs / SOK_FM_TIME_SEND_MS)) {
+            unAuthSignalCb(mTestSignal1.name, UintToByteVector<uint64_t>(serverTimeMs / SOK_FM_TIME_INCREMENT_PERIOD_MS));
+        }
+        EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+        elapsedMs += SOK_FM_MAIN_FUNCTION_PERIOD_MS;
+    }
+
+    uint64_t localTimeMs = (mFvm->getFv() * SOK_FM_TIME_INCREMENT_PERIOD_MS) + mFvm->getClockCount();
+    EXPECT_NEAR(static_cast<double>(serverTimeMs), static_cast<double>(localTimeMs), 2.0 * SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, redundant_time_server_answers_first_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    uint64_t authTime = 56454;
+    auto serializedAuthTime = UintToByteVector<uint64_t>(authTime);
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    auto verificationData = challenge;
+    verificationData.insert(verificationData.end(), serializedAuthTime.begin() + 1, serializedAuthTime.end());
+    TimeServerEndpointConfig backupServer{"BACKUP_SERVER", 789, mTestSignal1, mTestSignal1, mTestSignal1};
+    backupServer.challengeSignal.name = "TEST_BACKUP_CHALLENGE_SIGNAL_NAME";
+    backupServer.responseValueSignal.name = "TEST_BACKUP_VALUE_SIGNAL_NAME";
+    backupServer.responseSignatureSignal.name = "TEST_BACKUP_SIGNATURE_SIGNAL_NAME";
+    ISignalManager::SignalEventCallback backupSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(backupServer.keyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetRedundantTimeServers()).Times(1).WillOnce(Return(TimeServerEndpoints{backupServer}));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal1, _)).Times(2).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal2, _)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(backupServer.responseValueSignal, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&backupSignalCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(backupServer.responseSignatureSignal, _)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+
+    // the server of the authenticated FV signals is not reachable, the challenge goes to the backup server as well
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(CHALLENGE_LENGTH_BYTES)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(challenge)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvChallengeSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal1, challenge)).Times(1).WillOnce(Return(FvmErrorCode::kGeneralError));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(backupServer.challengeSignal, challenge)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(backupServer.keyId, verificationData, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    backupSignalCb(backupServer.responseValueSignal.name, serializedAuthTime);
+    backupSignalCb(backupServer.responseSignatureSignal.name, mac);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger handling of auth time
+    EXPECT_EQ(mFvm->getFv(), authTime);
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, relay_auth_fv_to_downstream_ecu_success)
+{
+    std::vector<uint8_t> challenge{0,0,0,0,0,0,0x1,0x2};
+    std::vector<uint8_t> downstreamChallenge{0x8,0x7,0x6,0x5,0x4,0x3,0x2,0x1};
+    uint16_t downstreamKeyId = 456;
+    uint64_t authTime = 56454;
+    auto serializedAuthTime = UintToByteVector<uint64_t>(authTime);
+    std::vector<uint8_t> mac{0x1,0x2,0x3};
+    std::vector<uint8_t> downstreamMac(16, 0xCD);
+    auto relayedFv = UintToByteVectorTrim<uint64_t>(authTime, FVM_SERVER_NUM_OF_BYTES_INITIAL_FV);
+    auto downstreamData = downstreamChallenge;
+    downstreamData.insert(downstreamData.end(), relayedFv.begin(), relayedFv.end());
+    SignalConfig relaySignal = mTestSignal1;
+    relaySignal.name = "TEST_RELAY_SIGNAL_NAME";
+    FmServerClientsConfigMap downstreamClients;
+    downstreamClients["DOWNSTREAM_ECU"] = {relaySignal, relaySignal, relaySignal, downstreamKeyId};
+    ISignalManager::SignalEventCallback authSignalCb;
+    ISignalManager::SignalEventCallback downstreamChallengeCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(downstreamKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal2));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetClientsConfigMap()).Times(1).WillOnce(Return(downstreamClients));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal1, _)).Times(2).WillOnce(DoAll(SaveArg<1>(&authSignalCb), Return(FvmErrorCode::kSuccess))).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal2, _)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(relaySignal, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&downstreamChallengeCb), Return(FvmErrorCode::kSuccess)));
+    authTimeReqSuccessCalls(challenge);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(_, _, mac, _)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    // answered once, with the authentic FV only
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(downstreamKeyId, downstreamData, _)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(downstreamMac)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(relaySignal, relayedFv)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(relaySignal, std::vector<uint8_t>(AUTH_FV_SIGNATURE_SIZE_BYTES, 0xCD))).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+
+    // the downstream challenge waits while the participant has no authentic FV itself
+    downstreamChallengeCb(relaySignal.name, downstreamChallenge);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+    authSignalCb(mTestSignal1.name, serializedAuthTime);
+    authSignalCb(mTestSignal2.name, mac);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will take over the auth time and relay it
+    EXPECT_EQ(mFvm->getFv(), authTime);
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+}
+
+TEST_F(FreshnessValueManagerImplParticipantTest, group_fv_broadcast_accept_and_replay_rejected_success)
+{
+    uint16_t groupKeyId = 321;
+    GroupFvBroadcastConfig groupConfig{true, groupKeyId, 100, mTestSignal2};
+    uint64_t fv = 56454;
+    uint32_t session = 0xA5A5A5A5;
+    auto groupMessage = [](uint32_t sessionId, uint32_t counter, uint64_t value) {
+        auto message = UintToByteVector<uint64_t>((static_cast<uint64_t>(sessionId) << 32U) | counter);
+        auto serializedFv = UintToByteVector<uint64_t>(value);
+        message.insert(message.end(), serializedFv.begin() + 1, serializedFv.end());
+        message.insert(message.end(), AUTH_FV_SIGNATURE_SIZE_BYTES, 0xAB);
+        return message;
+    };
+    ISignalManager::SignalEventCallback groupSignalCb;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuKeyIdForFvDistribution()).Times(1).WillOnce(Return(mTestKeyId));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(mTestKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(groupKeyId)).Times(1).WillOnce(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvValueSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAuthenticatedFvSignatureSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).Times(1).WillOnce(Return(mTestSignal1));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetGroupFvBroadcastConfig()).Times(1).WillOnce(Return(groupConfig));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal1, _)).Times(3).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(mTestSignal2, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&groupSignalCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacVerify(groupKeyId, _, _, _)).Times(3).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    mFvm->setFv(fv);
+
+    // the first session is adopted since its FV matches the current authentic FV
+    groupSignalCb(mTestSignal2.name, groupMessage(session, 1, fv + 1));
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    EXPECT_EQ(fv + 1, mFvm->getFv());
+
+    // a replayed nonce is ignored
+    groupSignalCb(mTestSignal2.name, groupMessage(session, 1, fv + 5));
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    EXPECT_EQ(fv + 1, mFvm->getFv());
+
+    // an unknown session with a diverging FV falls back to challenge-response
+    authTimeReqSuccessCalls(std::vector<uint8_t>{0,0,0,0,0,0,0x1,0x2});
+    groupSignalCb(mTestSignal2.name, groupMessage(session + 1, 2, fv + 100));
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction());
+    EXPECT_EQ(fv + 1, mFvm->getFv());
+    EXPECT_EQ(FvmErrorCode::kSuccess ,mFvm->MainFunction()); // will trigger auth time req
+
+    // a message of an invalid size is dropped before verification
+    groupSignalCb(mTestSignal2.name, std::vector<uint8_t>{0x1, 0x2});
+}
@@ -1,9 +1,12 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include <gtest/gtest.h>
-#include <thread>
+#include <algorithm>
+#include <map>
+#include <unistd.h>
 #include "sok/fvm/FreshnessValueManagerImplServer.hpp"
 #include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/FvCheckpoint.hpp"
 #include "sok/common/SokUtilities.hpp"
 #include "MockFreshnessValueManagerConfigAccessor.hpp"
 #include "MockSignalManager.hpp"
@@ -14,6 +17,7 @@ using ::testing::DoAll;
 using ::testing::SaveArg;
 using ::testing::_;
 using ::testing::Return;
+using ::testing::ReturnPointee;
 using namespace sok::fvm;
 using namespace sok::common;
 
@@ -29,10 +33,12 @@ public:
     void setFv(uint64_t fv) {
         mFV = fv;
         mIsFvValid = true;
+        publishFvState(true);
     }
 
     void setTimeSinceInit(uint64_t time) {
         mTimeSinceInit = time;
+        publishFvState(false);
     }
 
     uint64_t getFv() {
@@ -41,6 +47,7 @@ public:
 
     void setClockCount(uint16_t time) {
         mClockCount = time;
+        publishFvState(false);
     }
 
     uint32_t getClockCount() {
@@ -84,7 +91,7 @@ public:
         mTestSignal.lengthInBits = 64;
         mTestClientConfig["ECU1"] = {mTestSignal, mTestSignal, mTestSignal, 123};
 
-        EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetClientsConfigMap()).Times(1).WillOnce(Return(mTestClientConfig));
+        EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetClientsConfigMap()).Times(1).WillOnce(ReturnPointee(&mTestClientConfig));
         mFvm = std::make_shared<FreshnessValueManagerImplServerStub>();
     }
 
@@ -115,6 +122,46 @@ TEST_F(FreshnessValueManagerImplServerTest, server_init_success)
     EXPECT_EQ(mFvm->getFv(), expectedInitialFv);
 }
 
+TEST_F(FreshnessValueManagerImplServerTest, init_prepares_outgoing_signals_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    auto signalNamed = [this](std::string const& name) {
+        SignalConfig signal = mTestSignal;
+        signal.name = name;
+        return signal;
+    };
+    SignalConfig unauthFvSignal = signalNamed("TEST_UNAUTH_FV_SIGNAL_NAME");
+    SignalConfig crChallengeSignal = signalNamed("TEST_CR_CHALLENGE_SIGNAL_NAME");
+    SignalConfig crResponderSignal = signalNamed("TEST_CR_RESPONDER_CHALLENGE_SIGNAL_NAME");
+    mTestClientConfig["ECU1"] = {signalNamed("TEST_ECU1_CHALLENGE"), signalNamed("TEST_ECU1_VALUE"), signalNamed("TEST_ECU1_SIGNATURE"), 123};
+    mTestClientConfig["ECU2"] = {signalNamed("TEST_ECU2_CHALLENGE"), signalNamed("TEST_ECU2_VALUE"), signalNamed("TEST_ECU2_SIGNATURE"), 124};
+    SokFreshnessValueId const crChallengeId = 10;
+    SokFreshnessValueId const crResponderId = 11;
+
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, Init()).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*UTFvmRuntimeAttributesManager::mMockFvmAttrMgr, Init()).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetAllChallengeFreshnessValueIds()).WillRepeatedly(Return(std::vector<SokFreshnessValueId>{crChallengeId, crResponderId}));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(crChallengeId)).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(ChallengeConfigInstance{SokFreshnessType::kVwSokFreshnessCrChallenge, crChallengeSignal})));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetChallengeConfigInstanceByFvId(crResponderId)).WillRepeatedly(Return(FvmResult<ChallengeConfigInstance>(ChallengeConfigInstance{SokFreshnessType::kVwSokFreshnessCrResponse, crResponderSignal})));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).WillRepeatedly(Return(unauthFvSignal));
+
+    // every outgoing signal of the server and of the CR challenges once, the received ones are not prepared
+    std::vector<std::string> prepared;
+    EXPECT_CALL(*UTSignalManager::mMockSm, PrepareOutgoing(_)).WillRepeatedly([&prepared](SignalConfig const& signal) {
+        prepared.push_back(signal.name);
+        return FvmErrorCode::kSuccess;
+    });
+
+    ASSERT_EQ(FvmErrorCode::kSuccess, mFvm->Init());
+    std::sort(prepared.begin(), prepared.end());
+    std::vector<std::string> expected{"TEST_CR_CHALLENGE_SIGNAL_NAME", "TEST_ECU1_SIGNATURE", "TEST_ECU1_VALUE", "TEST_ECU2_SIGNATURE",
+                                      "TEST_ECU2_VALUE", "TEST_UNAUTH_FV_SIGNAL_NAME"};
+    EXPECT_EQ(expected, prepared);
+}
+
 TEST_F(FreshnessValueManagerImplServerTest, main_first_iteration_success)
 {   
     std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
@@ -167,4 +214,393 @@ TEST_F(FreshnessValueManagerImplServerTest, challenge_response_success)
 
     // auth FV distribution
     EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
-}
\ No newline at end of file
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, challenge_routed_by_client_index_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    retRandom[FVM_SERVER_NUM_OF_BYTES_INITIAL_FV - 1] = 1;
+    auto serializedFv = UintToByteVectorTrim<uint64_t>(1, 7);
+    SignalConfig ecu2ChallengeSignal = mTestSignal;
+    ecu2ChallengeSignal.name = "ECU2_CHALLENGE";
+    SignalConfig ecu2ValueSignal = mTestSignal;
+    ecu2ValueSignal.name = "ECU2_VALUE";
+    SignalConfig ecu2SignatureSignal = mTestSignal;
+    ecu2SignatureSignal.name = "ECU2_SIGNATURE";
+    mTestClientConfig["ECU2"] = {ecu2ChallengeSignal, ecu2ValueSignal, ecu2SignatureSignal, 456};
+    ISignalManager::SignalEventCallback ecu2ChallengeCb;
+    std::vector<uint8_t> testChallenge{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint8_t> expectedMacData = testChallenge;
+    expectedMacData.insert(expectedMacData.end(), serializedFv.begin(), serializedFv.end());
+    std::vector<uint8_t> testMac(16, 0xA5);
+    std::vector<uint8_t> macRes8Byte(testMac.begin(), testMac.begin() + AUTH_FV_SIGNATURE_SIZE_BYTES);
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).Times(2).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(ecu2ChallengeSignal, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&ecu2ChallengeCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(456, expectedMacData, _)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(testMac)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(ecu2ValueSignal, serializedFv)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(ecu2SignatureSignal, macRes8Byte)).Times(1).WillOnce(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+
+    // the client is identified by its subscription, not by the name of the signal
+    ecu2ChallengeCb("ANY_SIGNAL_NAME", testChallenge);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+
+    // a challenge is answered only once
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, challenge_reception_not_blocked_by_response_round_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    ISignalManager::SignalEventCallback challengeSignalCb;
+    std::vector<uint8_t> firstChallenge{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint8_t> secondChallenge{8, 7, 6, 5, 4, 3, 2, 1};
+    std::vector<std::vector<uint8_t>> macData;
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&challengeSignalCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(_, _, _)).WillRepeatedly(::testing::Invoke(
+        [&](uint16_t, std::vector<uint8_t> const& data, MacAlgorithm) {
+            macData.push_back(data);
+            // a challenge arriving while the round computes its MACs is accepted right away, the round holds no lock
+            // the reception waits for
+            if (1U == macData.size()) {
+                challengeSignalCb("SOK_Zeit_ECU1_Challenge", secondChallenge);
+            }
+            return CsmResult<std::vector<uint8_t>>(std::vector<uint8_t>(16, 0));
+        }));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    challengeSignalCb("SOK_Zeit_ECU1_Challenge", firstChallenge);
+
+    // a MAC per pending challenge and round
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    ASSERT_EQ(1U, macData.size());
+    EXPECT_TRUE(std::equal(firstChallenge.begin(), firstChallenge.end(), macData[0].begin()));
+
+    // the challenge of the first round is answered in the next round, once the minimum challenge interval of the client has elapsed
+    mFvm->setTimeSinceInit(SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    ASSERT_EQ(2U, macData.size());
+    EXPECT_TRUE(std::equal(secondChallenge.begin(), secondChallenge.end(), macData[1].begin()));
+
+    // an answered challenge is not answered again
+    mFvm->setTimeSinceInit(2 * SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    EXPECT_EQ(2U, macData.size());
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, challenge_expired_or_rate_limited_dropped_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    ISignalManager::SignalEventCallback challengeSignalCb;
+    std::vector<uint8_t> testChallenge{1, 2, 3, 4, 5, 6, 7, 8};
+    uint64_t const firstResponseTime = SOK_FM_TIME_REQUEST_TIMEOUT_MS;
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(1).WillOnce(DoAll(SaveArg<1>(&challengeSignalCb), Return(FvmErrorCode::kSuccess)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(_, _, _)).Times(2).WillRepeatedly(Return(CsmResult<std::vector<uint8_t>>(std::vector<uint8_t>(16, 0))));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+
+    // not answered within the participant's request timeout, the participant has given up on it
+    challengeSignalCb("SOK_Zeit_ECU1_Challenge", testChallenge);
+    mFvm->setTimeSinceInit(firstResponseTime);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+
+    mFvm->updateChallengeClock();
+    challengeSignalCb("SOK_Zeit_ECU1_Challenge", testChallenge);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+
+    // the client was answered less than the minimum challenge interval ago
+    mFvm->setTimeSinceInit(firstResponseTime + SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS - SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+    mFvm->updateChallengeClock();
+    challengeSignalCb("SOK_Zeit_ECU1_Challenge", testChallenge);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+
+    challengeSignalCb("SOK_Zeit_ECU1_Challenge", testChallenge);
+    mFvm->setTimeSinceInit(firstResponseTime + SOK_FM_SERVER_MIN_CHALLENGE_INTERVAL_MS);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, responses_earliest_deadline_first_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    size_t const clients = SOK_FM_SERVER_MAX_RESPONSES_PER_CYCLE + 1U;
+    mTestClientConfig.clear();
+    for (size_t i = 0; i < clients; ++i) {
+        SignalConfig challengeSignal = mTestSignal;
+        challengeSignal.name = "ECU" + std::to_string(i) + "_CHALLENGE";
+        mTestClientConfig["ECU" + std::to_string(i)] = {challengeSignal, mTestSignal, mTestSignal, static_cast<uint16_t>(i)};
+    }
+    std::map<std::string, ISignalManager::SignalEventCallback> challengeSignalCbs;
+    std::vector<uint8_t> answeredArrivals;
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(static_cast<int>(clients)).WillRepeatedly(::testing::Invoke(
+        [&](SignalConfig const& signal, ISignalManager::SignalEventCallback const& cb) {
+            challengeSignalCbs[signal.name] = cb;
+            return FvmErrorCode::kSuccess;
+        }));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(_, _, _)).Times(static_cast<int>(clients)).WillRepeatedly(::testing::Invoke(
+        [&](uint16_t, std::vector<uint8_t> const& data, MacAlgorithm) {
+            answeredArrivals.push_back(data[0]);
+            return CsmResult<std::vector<uint8_t>>(std::vector<uint8_t>(16, 0));
+        }));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+
+    // the challenges arrive one cycle apart, in the reverse order of the clients' names
+    for (size_t arrival = 0; arrival < clients; ++arrival) {
+        mFvm->setTimeSinceInit(arrival * SOK_FM_MAIN_FUNCTION_PERIOD_MS);
+        mFvm->updateChallengeClock();
+        auto const clientName = "ECU" + std::to_string(clients - 1U - arrival) + "_CHALLENGE";
+        challengeSignalCbs[clientName](clientName, std::vector<uint8_t>(CHALLENGE_LENGTH_BYTES, static_cast<uint8_t>(arrival)));
+    }
+
+    // the budget of a cycle is spent on the earliest arrivals, the rest is answered in the next cycle
+    mFvm->setClockCount(0);
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    ASSERT_EQ(static_cast<size_t>(SOK_FM_SERVER_MAX_RESPONSES_PER_CYCLE), answeredArrivals.size());
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    ASSERT_EQ(clients, answeredArrivals.size());
+    for (size_t arrival = 0; arrival < clients; ++arrival) {
+        EXPECT_EQ(arrival, answeredArrivals[arrival]);
+    }
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, client_health_and_never_synced_first_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    mTestClientConfig.clear();
+    for (uint16_t i = 0; i < 2; ++i) {
+        SignalConfig challengeSignal = mTestSignal;
+        challengeSignal.name = "ECU" + std::to_string(i) + "_CHALLENGE";
+        mTestClientConfig["ECU" + std::to_string(i)] = {challengeSignal, mTestSignal, mTestSignal, i};
+    }
+    std::map<std::string, ISignalManager::SignalEventCallback> challengeSignalCbs;
+    std::vector<uint16_t> answeredKeys;
+    auto challengeAt = [&](uint64_t timeMs, std::string const& ecuName) {
+        mFvm->setTimeSinceInit(timeMs);
+        mFvm->updateChallengeClock();
+        challengeSignalCbs[ecuName + "_CHALLENGE"](ecuName + "_CHALLENGE", std::vector<uint8_t>(CHALLENGE_LENGTH_BYTES, 1));
+    };
+    auto respondAt = [&](uint64_t timeMs) {
+        mFvm->setTimeSinceInit(timeMs);
+        mFvm->setClockCount(0);
+        EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->stub_sendAuthenticFvResponses());
+    };
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(2).WillRepeatedly(::testing::Invoke(
+        [&](SignalConfig const& signal, ISignalManager::SignalEventCallback const& cb) {
+            challengeSignalCbs[signal.name] = cb;
+            return FvmErrorCode::kSuccess;
+        }));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(_, _, _)).Times(4).WillRepeatedly(::testing::Invoke(
+        [&](uint16_t keyId, std::vector<uint8_t> const&, MacAlgorithm) {
+            answeredKeys.push_back(keyId);
+            if (4U == answeredKeys.size()) {
+                return CsmResult<std::vector<uint8_t>>(CsmErrorCode::kError);
+            }
+            return CsmResult<std::vector<uint8_t>>(std::vector<uint8_t>(16, 0));
+        }));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+
+    challengeAt(0, "ECU0");
+    respondAt(10);
+    // ECU1 was never answered and goes first, even though ECU0 asked earlier
+    challengeAt(100, "ECU0");
+    challengeAt(105, "ECU1");
+    respondAt(110);
+    ASSERT_EQ(3U, answeredKeys.size());
+    EXPECT_EQ(0U, answeredKeys[0]);
+    EXPECT_EQ(1U, answeredKeys[1]);
+    EXPECT_EQ(0U, answeredKeys[2]);
+    // too early after the previous response of ECU1
+    challengeAt(115, "ECU1");
+    respondAt(120);
+    challengeAt(300, "ECU1");
+    respondAt(300);
+
+    auto health = mFvm->GetClientHealth();
+    ASSERT_EQ(2U, health.size());
+    // the records follow the order of the client slots
+    auto ecu0 = std::find_if(health.begin(), health.end(), [](FvmClientHealthRecord const& record) { return "ECU0" == record.ecuName; });
+    auto ecu1 = std::find_if(health.begin(), health.end(), [](FvmClientHealthRecord const& record) { return "ECU1" == record.ecuName; });
+    ASSERT_TRUE((health.end() != ecu0) && (health.end() != ecu1));
+    EXPECT_EQ(2U, ecu0->challenges);
+    EXPECT_EQ(2U, ecu0->responses);
+    EXPECT_EQ(100U, ecu0->lastChallengeTimeMs);
+    EXPECT_EQ(110U, ecu0->lastResponseTimeMs);
+    EXPECT_EQ(10U, ecu0->lastResponseLatencyMs);
+    EXPECT_EQ(10U, ecu0->maxResponseLatencyMs);
+    EXPECT_EQ(100U, ecu0->meanChallengeIntervalMs);
+    EXPECT_EQ(0U, ecu0->droppedChallenges);
+    EXPECT_EQ(0U, ecu0->macFailures);
+    EXPECT_EQ(3U, ecu1->challenges);
+    EXPECT_EQ(1U, ecu1->responses);
+    EXPECT_EQ(5U, ecu1->lastResponseLatencyMs);
+    EXPECT_EQ(1U, ecu1->droppedChallenges);
+    EXPECT_EQ(1U, ecu1->macFailures);
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, init_restores_fv_and_phase_from_checkpoint_success)
+{
+    std::string const path = "/tmp/sok_fm_server_fv_checkpoint_test_" + std::to_string(getpid());
+    unlink(path.c_str());
+    uint64_t const reservedFv = 5000;
+    {
+        // written before the last boot, the records after the reservation was synced are lost
+        auto now = FvCheckpoint::Now();
+        FvCheckpoint checkpoint;
+        ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(path));
+        ASSERT_EQ(FvmErrorCode::kSuccess,
+                  checkpoint.Store(FvCheckpointState{reservedFv - 3, reservedFv, 60}, FvCheckpointTime{now.bootId + 1, 1000}));
+    }
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvCheckpointFile()).WillRepeatedly(Return(path));
+
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    EXPECT_EQ(reservedFv, mFvm->getFv());
+    EXPECT_EQ(60U, mFvm->getClockCount());
+
+    // the restored FV is reserved anew right away
+    FvCheckpoint checkpoint;
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(path));
+    auto restoreRes = checkpoint.Restore(FvCheckpointTime{FvCheckpoint::Now().bootId + 2, 0});
+    ASSERT_FALSE(restoreRes.isFailed());
+    EXPECT_EQ(reservedFv + SOK_FM_FV_CHECKPOINT_MARGIN, restoreRes.getObject().fv);
+    EXPECT_EQ(60U, restoreRes.getObject().phaseMs);
+    unlink(path.c_str());
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, unauth_fv_broadcast_after_increment_with_restored_phase_success)
+{
+    std::string const path = "/tmp/sok_fm_server_fv_broadcast_test_" + std::to_string(getpid());
+    unlink(path.c_str());
+    uint64_t const reservedFv = 5000;
+    {
+        auto now = FvCheckpoint::Now();
+        FvCheckpoint checkpoint;
+        ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(path));
+        ASSERT_EQ(FvmErrorCode::kSuccess,
+                  checkpoint.Store(FvCheckpointState{reservedFv - 3, reservedFv, 60}, FvCheckpointTime{now.bootId + 1, 1000}));
+    }
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    std::vector<uint64_t> broadcastFvs;
+    std::vector<uint32_t> broadcastPhases;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvCheckpointFile()).WillRepeatedly(Return(path));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).WillRepeatedly(Return(mTestSignal));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal, _)).WillRepeatedly([this, &broadcastFvs, &broadcastPhases](SignalConfig const&, std::vector<uint8_t> const& value) {
+        broadcastFvs.push_back(ByteVectorToUint<uint64_t>(value));
+        broadcastPhases.push_back(mFvm->getClockCount());
+        return FvmErrorCode::kSuccess;
+    });
+
+    // the restored phase is 60 ms, the first FV increment follows 40 ms after Init
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    for (uint32_t t = 0; t < 2500U; t += SOK_FM_MAIN_FUNCTION_PERIOD_MS) {
+        EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->MainFunction());
+    }
+
+    // every broadcast follows an FV increment instead of the restored phase
+    EXPECT_EQ((std::vector<uint64_t>{reservedFv + 11U, reservedFv + 21U}), broadcastFvs);
+    EXPECT_EQ((std::vector<uint32_t>{0U, 0U}), broadcastPhases);
+    unlink(path.c_str());
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, group_fv_broadcast_once_per_period_success)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    retRandom[FVM_SERVER_NUM_OF_BYTES_INITIAL_FV - 1] = 1;
+    uint64_t const initialFv = 1;
+    std::vector<uint8_t> session{0xA1, 0xB2, 0xC3, 0xD4};
+    std::vector<uint8_t> mac(16, 0xEE);
+    uint16_t const groupKeyId = 77;
+    uint32_t const periodMs = 3 * SOK_FM_TIME_INCREMENT_PERIOD_MS;
+    SignalConfig groupSignal = mTestSignal;
+    groupSignal.name = "TEST_GROUP_FV_SIGNAL_NAME";
+    std::vector<std::vector<uint8_t>> signedData;
+    std::vector<std::vector<uint8_t>> broadcasts;
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(GROUP_FV_NONCE_LENGTH_BYTES / 2U)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(session)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetGroupFvBroadcastConfig()).Times(1).WillOnce(Return(GroupFvBroadcastConfig{true, groupKeyId, periodMs, groupSignal}));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).WillRepeatedly(Return(mTestSignal));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(groupKeyId, _, MacAlgorithm::kAes128Cmac)).Times(3).WillRepeatedly([&signedData, &mac](uint16_t, std::vector<uint8_t> const& data, MacAlgorithm) {
+        signedData.push_back(data);
+        return CsmResult<std::vector<uint8_t>>(mac);
+    });
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(groupSignal, _)).Times(3).WillRepeatedly([&broadcasts](SignalConfig const&, std::vector<uint8_t> const& value) {
+        broadcasts.push_back(value);
+        return FvmErrorCode::kSuccess;
+    });
+
+    // broadcast right after the FV increments which complete a period, the next MainFunction sends it
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    for (uint32_t t = 0; t < (3U * periodMs); t += SOK_FM_MAIN_FUNCTION_PERIOD_MS) {
+        EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->MainFunction());
+    }
+    EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->MainFunction());
+
+    // nonce (session and counter) | FV | the leading bytes of the MAC over nonce and FV
+    ASSERT_EQ(3U, broadcasts.size());
+    uint64_t const sessionNonce = ByteVectorToUint<uint64_t>(session) << 32U;
+    for (uint32_t i = 0; i < broadcasts.size(); ++i) {
+        auto expected = UintToByteVector<uint64_t>(sessionNonce + i + 1U);
+        auto serializedFv = UintToByteVectorTrim<uint64_t>(initialFv + ((i + 1U) * (periodMs / SOK_FM_TIME_INCREMENT_PERIOD_MS)), FVM_SERVER_NUM_OF_BYTES_INITIAL_FV);
+        expected.insert(expected.end(), serializedFv.begin(), serializedFv.end());
+        EXPECT_EQ(expected, signedData[i]);
+        expected.insert(expected.end(), mac.begin(), mac.begin() + AUTH_FV_SIGNATURE_SIZE_BYTES);
+        EXPECT_EQ(static_cast<size_t>(GROUP_FV_BROADCAST_LENGTH_BYTES), broadcasts[i].size());
+        EXPECT_EQ(expected, broadcasts[i]);
+    }
+}
+
+TEST_F(FreshnessValueManagerImplServerTest, group_fv_broadcast_mac_failure_failed)
+{
+    std::vector<uint8_t> retRandom(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0);
+    std::vector<uint8_t> session{0xA1, 0xB2, 0xC3, 0xD4};
+    SignalConfig groupSignal = mTestSignal;
+    groupSignal.name = "TEST_GROUP_FV_SIGNAL_NAME";
+    mFvm->setInitialized(true);
+
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(retRandom)));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(GROUP_FV_NONCE_LENGTH_BYTES / 2U)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(session)));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetGroupFvBroadcastConfig()).Times(1).WillOnce(Return(GroupFvBroadcastConfig{true, 77, SOK_FM_TIME_INCREMENT_PERIOD_MS, groupSignal}));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, IsKeyExists(_)).WillRepeatedly(Return(CsmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetUnauthenticatedFvSignalConfig()).WillRepeatedly(Return(mTestSignal));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(mTestSignal, _)).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTCsmAccessor::mMockCsm, MacCreate(77, _, _)).Times(1).WillOnce(Return(CsmResult<std::vector<uint8_t>>(CsmErrorCode::kErrorRng)));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Publish(groupSignal, _)).Times(0);
+
+    // a group FV without a MAC is not broadcast
+    EXPECT_TRUE(mFvm->stub_serverOrParticipantInit());
+    for (uint32_t t = 0; t < SOK_FM_TIME_INCREMENT_PERIOD_MS; t += SOK_FM_MAIN_FUNCTION_PERIOD_MS) {
+        EXPECT_EQ(FvmErrorCode::kSuccess, mFvm->MainFunction());
+    }
+    EXPECT_EQ(FvmErrorCode::kGeneralError, mFvm->MainFunction());
+}
@@ -0,0 +1,206 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "sok/fvm/FreshnessValueManager.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+#include "sok/fvm/FvStatePage.hpp"
+#include "sok/fvm/FvmDaemonIpc.hpp"
+#include "sok/common/SokUtilities.hpp"
+#include "MockFreshnessValueManagerConfigAccessor.hpp"
+#include "MockSignalManager.hpp"
+#include "MockCsmAccessor.hpp"
+#include "MockFvmRuntimeAttributesManager.hpp"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+using namespace sok::fvm;
+using namespace sok::common;
+
+class FreshnessValueManagerTest : public ::testing::Test
+{
+public:
+    FreshnessValueManagerTest()
+    {
+        UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor = new NiceMock<MockFreshnessValueManagerConfigAccessor>();
+        UTSignalManager::mMockSm = new NiceMock<MockSignalManager>();
+        UTCsmAccessor::mMockCsm = new NiceMock<MockCsmAccessor>();
+        UTFvmRuntimeAttributesManager::mMockFvmAttrMgr = new NiceMock<MockFvmRuntimeAttributesManager>();
+        ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, Init()).WillByDefault(Return(true));
+        ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuFunction()).WillByDefault(Return(FvmRole::kParticipant));
+        ON_CALL(*UTFvmRuntimeAttributesManager::mMockFvmAttrMgr, Init()).WillByDefault(Return(true));
+        ON_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(_)).WillByDefault(Return(CsmResult<std::vector<uint8_t>>(CsmErrorCode::kErrorRng)));
+        mSignalManager1 = std::make_shared<NiceMock<MockSignalManager>>();
+        mSignalManager2 = std::make_shared<NiceMock<MockSignalManager>>();
+    }
+
+    ~FreshnessValueManagerTest()
+    {
+        delete UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor;
+        delete UTSignalManager::mMockSm;
+        delete UTCsmAccessor::mMockCsm;
+        delete UTFvmRuntimeAttributesManager::mMockFvmAttrMgr;
+    }
+
+    FvmInstanceConfig instanceConfig(std::shared_ptr<ISignalManager> signalManager, bool runMainFunctionThread)
+    {
+        return FvmInstanceConfig{FvmRole::kParticipant, "/tmp/fvm_instance.json", nullptr, std::move(signalManager), runMainFunctionThread, -1};
+    }
+
+    std::shared_ptr<NiceMock<MockSignalManager>> mSignalManager1;
+    std::shared_ptr<NiceMock<MockSignalManager>> mSignalManager2;
+};
+
+TEST_F(FreshnessValueManagerTest, get_instance_is_shared_success)
+{
+    auto defaultInstance = FreshnessValueManager::GetInstance();
+    EXPECT_EQ(defaultInstance, FreshnessValueManager::GetInstance());
+    EXPECT_NE(defaultInstance, FreshnessValueManager::Create(instanceConfig(mSignalManager1, false)));
+}
+
+TEST_F(FreshnessValueManagerTest, created_instances_are_independent_success)
+{
+    EXPECT_CALL(*mSignalManager1, Subscribe(_, _)).Times(3).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*mSignalManager2, Subscribe(_, _)).Times(3).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(0);
+
+    auto fvm1 = FreshnessValueManager::Create(instanceConfig(mSignalManager1, false));
+    auto fvm2 = FreshnessValueManager::Create(instanceConfig(mSignalManager2, false));
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm1->Init());
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm2->Init());
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm1->Deinit());
+    // the second instance stays initialized
+    EXPECT_EQ(FvmErrorCode::kAlreadyInitialized, fvm2->Init());
+}
+
+TEST_F(FreshnessValueManagerTest, main_function_thread_runs_between_init_and_deinit_success)
+{
+    std::atomic<uint32_t> flushes(0);
+    ON_CALL(*mSignalManager1, Flush()).WillByDefault(Invoke([&flushes]() {
+        ++flushes;
+        return FvmErrorCode::kSuccess;
+    }));
+
+    auto fvm = FreshnessValueManager::Create(instanceConfig(mSignalManager1, true));
+    ASSERT_EQ(FvmErrorCode::kSuccess, fvm->Init());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((flushes < 3U) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_LE(3U, flushes);
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->Deinit());
+    auto flushesAtDeinit = flushes.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(4 * SOK_FM_MAIN_FUNCTION_PERIOD_MS));
+    EXPECT_EQ(flushesAtDeinit, flushes);
+}
+
+TEST_F(FreshnessValueManagerTest, not_initialized_before_init_failed)
+{
+    auto fvm = FreshnessValueManager::Create(instanceConfig(mSignalManager1, false));
+    EXPECT_EQ(FvmErrorCode::kNotInitialized, fvm->MainFunction());
+    EXPECT_EQ(FvmErrorCode::kNotInitialized, fvm->GetTxFreshness(1).getResultCode());
+    EXPECT_EQ(FvmErrorCode::kNotInitialized, fvm->Deinit());
+}
+
+TEST_F(FreshnessValueManagerTest, init_config_not_readable_failed)
+{
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, Init()).WillOnce(Return(false));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuFunction()).Times(0);
+
+    auto fvm = FreshnessValueManager::Create(instanceConfig(mSignalManager1, false));
+    EXPECT_EQ(FvmErrorCode::kFVInitializeFailed, fvm->Init());
+}
+
+TEST_F(FreshnessValueManagerTest, gateway_runs_server_and_participant_roles_success)
+{
+    std::atomic<uint32_t> flushes(0);
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEcuFunction()).WillRepeatedly(Return(FvmRole::kGateway));
+    EXPECT_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetGatewayParticipantConfigFile()).Times(1).WillOnce(Return("participant.json"));
+    ON_CALL(*UTCsmAccessor::mMockCsm, GenerateRandomBytes(_)).WillByDefault(Return(CsmResult<std::vector<uint8_t>>(std::vector<uint8_t>(FVM_SERVER_NUM_OF_BYTES_INITIAL_FV, 0x1))));
+    // the FV distribution signals of the participant role, the server role has no clients configured
+    EXPECT_CALL(*mSignalManager1, Subscribe(_, _)).Times(3).WillRepeatedly(Return(FvmErrorCode::kSuccess));
+    ON_CALL(*mSignalManager1, Flush()).WillByDefault(Invoke([&flushes]() {
+        ++flushes;
+        return FvmErrorCode::kSuccess;
+    }));
+
+    auto fvm = FreshnessValueManager::Create(instanceConfig(mSignalManager1, false));
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->Init());
+    fvm->MainFunction();
+    // a MainFunction of each role
+    EXPECT_EQ(2U, flushes);
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->Deinit());
+}
+
+TEST_F(FreshnessValueManagerTest, daemon_publishes_fv_state_and_serves_requests_success)
+{
+    std::string pageName = "/sok_fm_fvm_daemon_test_" + std::to_string(getpid());
+    std::string socketPath = "/tmp/sok_fm_fvm_daemon_test_" + std::to_string(getpid()) + ".sock";
+    ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvDaemonConfig()).WillByDefault(Return(FvDaemonConfig{FvDaemonMode::kDaemon, pageName, socketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID}));
+    ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(_)).WillByDefault(Return(FvmResult<SokFreshnessType>(FvmErrorCode::kFvIdNotFound)));
+
+    auto fvm = FreshnessValueManager::Create(instanceConfig(mSignalManager1, false));
+    ASSERT_EQ(FvmErrorCode::kSuccess, fvm->Init());
+    auto page = FvStatePage::Open(pageName);
+    ASSERT_NE(nullptr, page);
+    // published by Init()
+    EXPECT_LE(1U, page->Load().epoch);
+
+    FvmDaemonClient client(socketPath);
+    ASSERT_TRUE(client.Connect(nullptr));
+    FvmIpcMessage request{};
+    request.type = FvmIpcMessageType::kGetTxFreshness;
+    request.fvId = 5;
+    FvmIpcMessage response{};
+    ASSERT_EQ(FvmErrorCode::kSuccess, client.Request(request, response));
+    EXPECT_EQ(FvmErrorCode::kFvIdNotFound, response.result);
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->Deinit());
+    shm_unlink(pageName.c_str());
+}
+
+TEST_F(FreshnessValueManagerTest, daemon_client_answers_fv_of_daemon_success)
+{
+    std::string pageName = "/sok_fm_fvm_client_test_" + std::to_string(getpid());
+    std::string socketPath = "/tmp/sok_fm_fvm_client_test_" + std::to_string(getpid()) + ".sock";
+    auto daemonPage = FvStatePage::Create(pageName);
+    ASSERT_NE(nullptr, daemonPage);
+    daemonPage->Publish(FvStateRecord{0x1234, true, 1000, 0, 1});
+    // answers the session counter FV in place of the FVM daemon
+    FvmDaemonServer daemon(socketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [](FvmDaemonServer::ConnectionId, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        EXPECT_EQ(FvmIpcMessageType::kGetTxFreshness, request.type);
+        EXPECT_EQ(2U, request.fvId);
+        response.result = FvmErrorCode::kSuccess;
+        response.length = 1;
+        response.data[0] = 0x5A;
+    });
+    ASSERT_TRUE(daemon.Start());
+    ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetFvDaemonConfig()).WillByDefault(Return(FvDaemonConfig{FvDaemonMode::kClient, pageName, socketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID}));
+    ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(1)).WillByDefault(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessValue)));
+    ON_CALL(*UTFreshnessValueManagerConfigAccessor::mMockFvConfAccessor, GetEntryTypeByFvId(2)).WillByDefault(Return(FvmResult<SokFreshnessType>(SokFreshnessType::kVwSokFreshnessValueSessionSender)));
+    ON_CALL(*UTFvmRuntimeAttributesManager::mMockFvmAttrMgr, IsActive(_)).WillByDefault(Return(true));
+    // the signals are exchanged by the daemon only
+    EXPECT_CALL(*UTSignalManager::mMockSm, Subscribe(_, _)).Times(0);
+
+    auto fvm = FreshnessValueManager::Create(instanceConfig(nullptr, false));
+    ASSERT_EQ(FvmErrorCode::kSuccess, fvm->Init());
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->MainFunction());
+
+    auto fvRes = fvm->GetTxFreshness(1);
+    ASSERT_TRUE(fvRes.isSucceeded());
+    EXPECT_EQ(sok::common::UintToByteVector<uint64_t>(0x1234), fvRes.getObject());
+    auto sessionFvRes = fvm->GetTxFreshness(2);
+    ASSERT_TRUE(sessionFvRes.isSucceeded());
+    EXPECT_EQ(FVContainer{0x5A}, sessionFvRes.getObject());
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, fvm->Deinit());
+    shm_unlink(pageName.c_str());
+}
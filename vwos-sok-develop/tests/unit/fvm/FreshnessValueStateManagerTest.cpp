@@ -1,6 +1,7 @@
 /* Copyright (c) 2023 Volkswagen Group */
 
 #include <gtest/gtest.h>
+#include <thread>
 #include "sok/fvm/FreshnessValueStateManager.hpp"
 
 using namespace sok::fvm;
@@ -104,3 +105,82 @@ TEST(FreshnessValuStateManagerTest, stateActionsAndTransactions) {
     stateManager.enter();
     EXPECT_EQ(actionMsg, "run ProcessAnauthFV state");
 }
+
+TEST(FreshnessValuStateManagerTest, groupFvTransitions) {
+
+    FreshnessValueStateManager stateManager;
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::RequestFV);
+    for (auto state : {FreshnessValueState::RequestFV, FreshnessValueState::FVInProgress, FreshnessValueState::ProcessFV,
+                       FreshnessValueState::ProcessAnauthFV, FreshnessValueState::ProcessGroupFV, FreshnessValueState::Idle}) {
+        stateManager.registerState(state, []() -> FvmErrorCode { return FvmErrorCode::kSuccess; });
+    }
+
+    // a group FV is taken over without a request
+    stateManager.transiteTo(FreshnessValueState::RequestFV);
+    stateManager.reactToGroupFVRes();
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::ProcessGroupFV);
+
+    // ignored while another FV is processed
+    stateManager.reactToUnauthenticFVRes();
+    stateManager.reactToFVRes();
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::ProcessGroupFV);
+
+    // ignored while an authentic FV is on the way
+    stateManager.transiteTo(FreshnessValueState::FVInProgress);
+    stateManager.reactToGroupFVRes();
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::FVInProgress);
+
+    stateManager.transiteTo(FreshnessValueState::Idle);
+    stateManager.reactToGroupFVRes();
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::ProcessGroupFV);
+}
+
+TEST(FreshnessValuStateManagerTest, concurrentReactionsTakeASingleTransition) {
+
+    FreshnessValueStateManager stateManager;
+    for (auto state : {FreshnessValueState::RequestFV, FreshnessValueState::FVInProgress, FreshnessValueState::ProcessFV,
+                       FreshnessValueState::ProcessAnauthFV, FreshnessValueState::ProcessGroupFV, FreshnessValueState::Idle}) {
+        stateManager.registerState(state, []() -> FvmErrorCode { return FvmErrorCode::kSuccess; });
+    }
+
+    for (int round = 0; round < 200; ++round) {
+        stateManager.transiteTo(FreshnessValueState::Idle);
+        std::thread unauthThread([&stateManager]() { stateManager.reactToUnauthenticFVRes(); });
+        std::thread groupThread([&stateManager]() { stateManager.reactToGroupFVRes(); });
+        unauthThread.join();
+        groupThread.join();
+        // the later reaction sees the state of the first one, and is ignored there
+        auto state = stateManager.currentState();
+        EXPECT_TRUE((FreshnessValueState::ProcessAnauthFV == state) || (FreshnessValueState::ProcessGroupFV == state));
+    }
+}
+
+TEST(FreshnessValuStateManagerTest, transitionOfActionDroppedAfterReaction) {
+
+    FreshnessValueStateManager stateManager;
+    for (auto state : {FreshnessValueState::RequestFV, FreshnessValueState::ProcessFV, FreshnessValueState::Idle}) {
+        stateManager.registerState(state, []() -> FvmErrorCode { return FvmErrorCode::kSuccess; });
+    }
+    bool transited = true;
+    // the response arrives while the action times the request out
+    stateManager.registerState(FreshnessValueState::FVInProgress, [&]() -> FvmErrorCode {
+        stateManager.reactToFVRes();
+        transited = stateManager.transiteTo(FreshnessValueState::RequestFV);
+        return FvmErrorCode::kSuccess;
+    });
+
+    stateManager.transiteTo(FreshnessValueState::FVInProgress);
+    EXPECT_EQ(stateManager.enter(), FvmErrorCode::kSuccess);
+    EXPECT_FALSE(transited);
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::ProcessFV);
+
+    // without a reaction the transition of the action is taken
+    stateManager.registerState(FreshnessValueState::FVInProgress, [&]() -> FvmErrorCode {
+        transited = stateManager.transiteTo(FreshnessValueState::RequestFV);
+        return FvmErrorCode::kSuccess;
+    });
+    stateManager.transiteTo(FreshnessValueState::FVInProgress);
+    EXPECT_EQ(stateManager.enter(), FvmErrorCode::kSuccess);
+    EXPECT_TRUE(transited);
+    EXPECT_EQ(stateManager.currentState(), FreshnessValueState::RequestFV);
+}
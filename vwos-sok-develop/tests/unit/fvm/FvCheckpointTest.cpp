@@ -0,0 +1,129 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include "sok/fvm/FvCheckpoint.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+
+using namespace sok::fvm;
+
+class FvCheckpointTest : public ::testing::Test
+{
+public:
+    FvCheckpointTest()
+    : mPath("/tmp/sok_fm_fv_checkpoint_test_" + std::to_string(getpid()))
+    {
+        unlink(mPath.c_str());
+    }
+
+    ~FvCheckpointTest()
+    {
+        unlink(mPath.c_str());
+    }
+
+    std::string mPath;
+};
+
+TEST_F(FvCheckpointTest, restore_without_checkpoint_failed)
+{
+    FvCheckpoint checkpoint;
+    EXPECT_TRUE(checkpoint.Restore(FvCheckpointTime{1, 1000}).isFailed());
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+    EXPECT_TRUE(checkpoint.Restore(FvCheckpointTime{1, 1000}).isFailed());
+}
+
+TEST_F(FvCheckpointTest, restore_extrapolates_within_boot_success)
+{
+    uint64_t fv = 0x12345678;
+    uint64_t reservedFv = fv + SOK_FM_FV_CHECKPOINT_MARGIN;
+    {
+        FvCheckpoint checkpoint;
+        ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+        EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv - 1, reservedFv, 0}, FvCheckpointTime{7, 9000}));
+        EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv, reservedFv, 30}, FvCheckpointTime{7, 10000}));
+    }
+
+    // a restarted server continues with the FV and phase of the latest record, advanced by the elapsed time
+    FvCheckpoint checkpoint;
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+    auto restoreRes = checkpoint.Restore(FvCheckpointTime{7, 10000 + 3 * SOK_FM_TIME_INCREMENT_PERIOD_MS + 50});
+    ASSERT_FALSE(restoreRes.isFailed());
+    EXPECT_EQ(fv + 3, restoreRes.getObject().fv);
+    EXPECT_EQ(80U, restoreRes.getObject().phaseMs);
+    EXPECT_EQ(reservedFv, restoreRes.getObject().reservedFv);
+
+    // continues the sequence of the records found in the file
+    EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv + 10, reservedFv + 10, 0}, FvCheckpointTime{7, 11000}));
+    restoreRes = checkpoint.Restore(FvCheckpointTime{7, 11000});
+    ASSERT_FALSE(restoreRes.isFailed());
+    EXPECT_EQ(fv + 10, restoreRes.getObject().fv);
+}
+
+TEST_F(FvCheckpointTest, reservation_synced_in_background_success)
+{
+    uint64_t fv = 0x12345678;
+    FvCheckpoint checkpoint;
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+    EXPECT_EQ(0U, checkpoint.DurableReservedFv());
+
+    // Store does not wait for the sync of a new reservation
+    EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv, fv + SOK_FM_FV_CHECKPOINT_MARGIN, 0}, FvCheckpointTime{7, 10000}));
+    for (uint32_t i = 0; (i < 500U) && (checkpoint.DurableReservedFv() != (fv + SOK_FM_FV_CHECKPOINT_MARGIN)); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(fv + SOK_FM_FV_CHECKPOINT_MARGIN, checkpoint.DurableReservedFv());
+
+    // Sync makes the latest reservation durable before returning
+    EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv + 1, fv + 1 + SOK_FM_FV_CHECKPOINT_MARGIN, 0}, FvCheckpointTime{7, 10100}));
+    EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Sync());
+    EXPECT_EQ(fv + 1 + SOK_FM_FV_CHECKPOINT_MARGIN, checkpoint.DurableReservedFv());
+}
+
+TEST_F(FvCheckpointTest, restore_after_reboot_continues_from_reservation_success)
+{
+    uint64_t fv = 1000;
+    {
+        FvCheckpoint checkpoint;
+        ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+        EXPECT_EQ(FvmErrorCode::kSuccess,
+                  checkpoint.Store(FvCheckpointState{fv, fv + SOK_FM_FV_CHECKPOINT_MARGIN, 0}, FvCheckpointTime{7, 10000}));
+        EXPECT_EQ(FvmErrorCode::kSuccess,
+                  checkpoint.Store(FvCheckpointState{fv + 4, fv + SOK_FM_FV_CHECKPOINT_MARGIN, 40}, FvCheckpointTime{7, 10400}));
+    }
+
+    // after a reboot the elapsed time is unknown and the latest records may be lost, the synced reservation is not
+    FvCheckpoint checkpoint;
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+    auto restoreRes = checkpoint.Restore(FvCheckpointTime{8, 20000});
+    ASSERT_FALSE(restoreRes.isFailed());
+    EXPECT_EQ(fv + SOK_FM_FV_CHECKPOINT_MARGIN, restoreRes.getObject().fv);
+    EXPECT_EQ(fv + SOK_FM_FV_CHECKPOINT_MARGIN, restoreRes.getObject().reservedFv);
+    EXPECT_EQ(40U, restoreRes.getObject().phaseMs);
+}
+
+TEST_F(FvCheckpointTest, corrupted_record_falls_back_to_previous_success)
+{
+    uint64_t fv = 1000;
+    {
+        FvCheckpoint checkpoint;
+        ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+        EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv, fv + 20, 0}, FvCheckpointTime{7, 10000}));
+        EXPECT_EQ(FvmErrorCode::kSuccess, checkpoint.Store(FvCheckpointState{fv + 10, fv + 20, 0}, FvCheckpointTime{7, 11000}));
+    }
+    {
+        // tear the FV of the latest record, the records are written alternately starting with the second one
+        std::fstream file(mPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(16 + sizeof(uint64_t));
+        uint64_t tornFv = 0xFFFF;
+        file.write(reinterpret_cast<char const*>(&tornFv), sizeof(tornFv));
+    }
+
+    FvCheckpoint checkpoint;
+    ASSERT_EQ(FvmErrorCode::kSuccess, checkpoint.Open(mPath));
+    auto restoreRes = checkpoint.Restore(FvCheckpointTime{7, 10000});
+    ASSERT_FALSE(restoreRes.isFailed());
+    EXPECT_EQ(fv, restoreRes.getObject().fv);
+}
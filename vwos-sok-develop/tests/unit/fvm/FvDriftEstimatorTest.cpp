@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <random>
+#include "sok/fvm/FvDriftEstimator.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+
+using namespace sok::fvm;
+
+TEST(FvDriftEstimatorTest, not_valid_below_min_samples)
+{
+    FvDriftEstimator estimator(SOK_FM_DRIFT_WINDOW, SOK_FM_DRIFT_MIN_SAMPLES);
+    for (uint64_t i = 1; i < SOK_FM_DRIFT_MIN_SAMPLES; ++i) {
+        estimator.AddSample(i * 1000U, static_cast<int64_t>(i) * 100);
+        EXPECT_FALSE(estimator.IsValid());
+        EXPECT_EQ(0.0, estimator.DriftPpm());
+        EXPECT_EQ(0.0, estimator.OffsetUs(i * 1000U));
+    }
+    estimator.AddSample(SOK_FM_DRIFT_MIN_SAMPLES * 1000U, SOK_FM_DRIFT_MIN_SAMPLES * 100);
+    EXPECT_TRUE(estimator.IsValid());
+    EXPECT_NEAR(100.0, estimator.DriftPpm(), 0.001);
+}
+
+TEST(FvDriftEstimatorTest, estimate_drift_with_noise_success)
+{
+    // 80 ppm and the 5 ms resolution of the MainFunction
+    std::minstd_rand random(7);
+    std::uniform_int_distribution<int64_t> noiseUs(-2500, 2500);
+    FvDriftEstimator estimator(SOK_FM_DRIFT_WINDOW, SOK_FM_DRIFT_MIN_SAMPLES);
+    uint64_t timeMs = 0;
+    for (size_t i = 0; i < 4U * SOK_FM_DRIFT_WINDOW; ++i) {
+        timeMs += SOK_FM_TIME_SEND_MS;
+        estimator.AddSample(timeMs, 20000 + static_cast<int64_t>((timeMs * 80U) / 1000U) + noiseUs(random));
+    }
+    EXPECT_NEAR(80.0, estimator.DriftPpm(), 40.0);
+    EXPECT_NEAR(20000.0 + ((timeMs * 80.0) / 1000.0), estimator.OffsetUs(timeMs), 2000.0);
+}
+
+TEST(FvDriftEstimatorTest, window_drops_old_samples_success)
+{
+    FvDriftEstimator estimator(SOK_FM_DRIFT_WINDOW, SOK_FM_DRIFT_MIN_SAMPLES);
+    uint64_t timeMs = 0;
+    for (size_t i = 0; i < SOK_FM_DRIFT_WINDOW; ++i) {
+        timeMs += SOK_FM_TIME_SEND_MS;
+        estimator.AddSample(timeMs, -static_cast<int64_t>(timeMs / 10U));
+    }
+    EXPECT_NEAR(-100.0, estimator.DriftPpm(), 0.001);
+
+    // the drift changed, e.g. by the temperature of the oscillator
+    int64_t const offsetUs = -static_cast<int64_t>(timeMs / 10U);
+    uint64_t const changeMs = timeMs;
+    for (size_t i = 0; i < SOK_FM_DRIFT_WINDOW; ++i) {
+        timeMs += SOK_FM_TIME_SEND_MS;
+        estimator.AddSample(timeMs, offsetUs + static_cast<int64_t>((timeMs - changeMs) / 20U));
+    }
+    EXPECT_NEAR(50.0, estimator.DriftPpm(), 0.001);
+}
+
+TEST(FvDriftEstimatorTest, reset_drops_all_samples_success)
+{
+    FvDriftEstimator estimator(SOK_FM_DRIFT_WINDOW, SOK_FM_DRIFT_MIN_SAMPLES);
+    for (uint64_t i = 1; i <= SOK_FM_DRIFT_MIN_SAMPLES; ++i) {
+        estimator.AddSample(i * 1000U, static_cast<int64_t>(i) * 100);
+    }
+    EXPECT_TRUE(estimator.IsValid());
+    estimator.Reset();
+    EXPECT_FALSE(estimator.IsValid());
+    EXPECT_EQ(0.0, estimator.DriftPpm());
+}
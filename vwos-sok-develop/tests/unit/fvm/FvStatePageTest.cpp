@@ -0,0 +1,105 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "sok/fvm/FvStatePage.hpp"
+#include "sok/fvm/FreshnessValueManagerConstants.hpp"
+
+using namespace sok::fvm;
+
+class FvStatePageTest : public ::testing::Test
+{
+public:
+    FvStatePageTest()
+    : mPageName("/sok_fm_fv_state_test_" + std::to_string(getpid()))
+    {
+    }
+
+    ~FvStatePageTest()
+    {
+        shm_unlink(mPageName.c_str());
+    }
+
+    std::string mPageName;
+};
+
+TEST_F(FvStatePageTest, open_without_daemon_failed)
+{
+    EXPECT_EQ(nullptr, FvStatePage::Open(mPageName));
+}
+
+TEST_F(FvStatePageTest, load_published_record_read_only_success)
+{
+    auto daemonPage = FvStatePage::Create(mPageName);
+    ASSERT_NE(nullptr, daemonPage);
+    auto clientPage = FvStatePage::Open(mPageName);
+    ASSERT_NE(nullptr, clientPage);
+    // nothing published yet
+    EXPECT_FALSE(clientPage->Load().valid);
+
+    daemonPage->Publish(FvStateRecord{0x123456, true, 1000, 45, 2});
+    auto record = clientPage->Load();
+    EXPECT_EQ(0x123456U, record.fv);
+    EXPECT_TRUE(record.valid);
+    // advanced by the few milliseconds since the publication
+    EXPECT_GE(record.timeSinceInit, 1000U);
+    EXPECT_EQ(45U + (record.timeSinceInit - 1000U), record.subTick);
+    EXPECT_EQ(2U, record.epoch);
+
+    // a client cannot publish
+    clientPage->Publish(FvStateRecord{1, true, 1, 1, 1});
+    EXPECT_EQ(0x123456U, daemonPage->Load().fv);
+}
+
+TEST_F(FvStatePageTest, record_not_refreshed_by_daemon_not_valid_success)
+{
+    auto daemonPage = FvStatePage::Create(mPageName);
+    ASSERT_NE(nullptr, daemonPage);
+    auto clientPage = FvStatePage::Open(mPageName);
+    ASSERT_NE(nullptr, clientPage);
+    daemonPage->Publish(FvStateRecord{0x123456, true, 1000, 45, 2});
+    EXPECT_TRUE(clientPage->Load().valid);
+
+    // not refreshed within an FV increment period and the jitter
+    std::this_thread::sleep_for(std::chrono::milliseconds(SOK_FM_TIME_INCREMENT_PERIOD_MS + SOK_FM_TIME_JITTER_MAX_MS + 20));
+    auto record = clientPage->Load();
+    EXPECT_FALSE(record.valid);
+    EXPECT_EQ(0x123456U, record.fv);
+}
+
+TEST_F(FvStatePageTest, load_advances_record_by_elapsed_time_success)
+{
+    auto daemonPage = FvStatePage::Create(mPageName);
+    ASSERT_NE(nullptr, daemonPage);
+    auto clientPage = FvStatePage::Open(mPageName);
+    ASSERT_NE(nullptr, clientPage);
+    daemonPage->Publish(FvStateRecord{0x123456, true, 1000, SOK_FM_TIME_INCREMENT_PERIOD_MS - 5, 2});
+
+    // the daemon's FV was incremented since it published the record
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto record = clientPage->Load();
+    ASSERT_TRUE(record.valid);
+    EXPECT_EQ(0x123457U, record.fv);
+    EXPECT_GE(record.timeSinceInit, 1010U);
+    EXPECT_EQ((record.timeSinceInit - 1000U - 5U) % SOK_FM_TIME_INCREMENT_PERIOD_MS, record.subTick);
+    EXPECT_EQ(2U, record.epoch);
+}
+
+TEST_F(FvStatePageTest, new_daemon_takes_over_page_success)
+{
+    auto daemonPage = FvStatePage::Create(mPageName);
+    ASSERT_NE(nullptr, daemonPage);
+    auto clientPage = FvStatePage::Open(mPageName);
+    ASSERT_NE(nullptr, clientPage);
+    daemonPage->Publish(FvStateRecord{0x123456, true, 1000, 45, 2});
+    daemonPage.reset();
+
+    auto restartedDaemonPage = FvStatePage::Create(mPageName);
+    ASSERT_NE(nullptr, restartedDaemonPage);
+    EXPECT_FALSE(clientPage->Load().valid);
+    restartedDaemonPage->Publish(FvStateRecord{0x200000, true, 20, 0, 1});
+    EXPECT_EQ(0x200000U, clientPage->Load().fv);
+}
@@ -0,0 +1,56 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "sok/fvm/FvStateSeqlock.hpp"
+
+using namespace sok::fvm;
+
+TEST(FvStateSeqlockTest, load_published_record_success)
+{
+    FvStateSeqlock fvState;
+    auto initial = fvState.Load();
+    EXPECT_EQ(0U, initial.fv);
+    EXPECT_FALSE(initial.valid);
+
+    fvState.Publish(FvStateRecord{0x123456, true, 1000, 45, 2});
+    auto record = fvState.Load();
+    EXPECT_EQ(0x123456U, record.fv);
+    EXPECT_TRUE(record.valid);
+    EXPECT_EQ(1000U, record.timeSinceInit);
+    EXPECT_EQ(45U, record.subTick);
+    EXPECT_EQ(2U, record.epoch);
+}
+
+TEST(FvStateSeqlockTest, concurrent_readers_see_consistent_records_success)
+{
+    FvStateSeqlock fvState;
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> tornRecords(0);
+    std::atomic<uint64_t> loads(0);
+
+    // every field of a published record is derived from its FV, a torn read mixes records
+    auto reader = [&]() {
+        while (!stop) {
+            auto record = fvState.Load();
+            if ((record.timeSinceInit != (record.fv * 5U)) || (record.subTick != static_cast<uint32_t>(record.fv % 100U))
+                || (record.epoch != static_cast<uint32_t>(record.fv / 1000U)) || (record.valid != (0U != (record.fv & 1U)))) {
+                ++tornRecords;
+            }
+            ++loads;
+        }
+    };
+    std::thread reader1(reader);
+    std::thread reader2(reader);
+    for (uint64_t fv = 1; fv <= 200000U; ++fv) {
+        fvState.Publish(FvStateRecord{fv, 0U != (fv & 1U), fv * 5U, static_cast<uint32_t>(fv % 100U), static_cast<uint32_t>(fv / 1000U)});
+    }
+    stop = true;
+    reader1.join();
+    reader2.join();
+
+    EXPECT_LT(0U, loads.load());
+    EXPECT_EQ(0U, tornRecords.load());
+    EXPECT_EQ(200000U, fvState.Load().fv);
+}
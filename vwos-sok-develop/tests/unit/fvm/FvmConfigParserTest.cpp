@@ -5,10 +5,14 @@
 
 using namespace sok::fvm;
 
+constexpr char TEST_CONFIG_JSON[] = "{\"version\":1,\"network_interface\":\"sw4\",\"ecu_name\":\"ECU1\",\"ecu_key_id_auth_fv\":123,\"auth_br_config\":[{\"fv_id\":1,\"sok_freshness_type\":\"FV\",\"pdu_id\":123,\"session_counter_length_bits\":0}],\"challenge_response_config\":[{\"fv_id\":2,\"challenge_type\":\"CHALLENGE\",\"signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}}}],\"unauthenticated_fv_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_value_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_signature_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_value_challenge_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"key_config\":[{\"fv_id\":1,\"key_id\":321}],\"clients_signals_config\":[{\"client_ecu_name\":\"ECU1\",\"key_id\":132,\"challenge_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"response_value_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"response_signature_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}}}]}";
+
 TEST(FvmConfigParserTest, parseConfigJsonSuccess)
 {
-    std::string json("{\"version\":1,\"network_interface\":\"sw4\",\"ecu_name\":\"ECU1\",\"ecu_key_id_auth_fv\":123,\"auth_br_config\":[{\"fv_id\":1,\"sok_freshness_type\":\"FV\",\"pdu_id\":123,\"session_counter_length_bits\":0}],\"challenge_response_config\":[{\"fv_id\":2,\"challenge_type\":\"CHALLENGE\",\"signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}}}],\"unauthenticated_fv_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_value_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_signature_signal_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"authenticated_fv_value_challenge_config\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"key_config\":[{\"fv_id\":1,\"key_id\":321}],\"clients_signals_config\":[{\"client_ecu_name\":\"ECU1\",\"key_id\":132,\"challenge_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"response_value_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}},\"response_signature_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":64}}}]}");
+    std::string json(TEST_CONFIG_JSON);
     SokFmConfig outConfig;
+    // the role the configuration is read for
+    outConfig.mEcuFunction = FvmRole::kParticipant;
     FvmConfigParser parser;
     ASSERT_TRUE(parser.Parse(json, outConfig));
 
@@ -35,6 +39,17 @@ TEST(FvmConfigParserTest, parseConfigJsonSuccess)
     EXPECT_EQ(outConfig.mNetworkInterface, "sw4");
     EXPECT_EQ(outConfig.mEcuName, "ECU1");
     EXPECT_EQ(outConfig.mKeyIdForAuthFvDistribution, 123);
+    EXPECT_FALSE(outConfig.mSignalTxBatching);
+    EXPECT_TRUE(outConfig.mSignalRecordingFile.empty());
+    EXPECT_TRUE(outConfig.mFvCheckpointFile.empty());
+    EXPECT_FALSE(outConfig.mEventDrivenProcessing);
+    EXPECT_EQ(FvmRole::kParticipant, outConfig.mEcuFunction);
+    EXPECT_TRUE(outConfig.mGatewayParticipantConfigFile.empty());
+    EXPECT_FALSE(outConfig.mGroupFvBroadcast.enabled);
+    EXPECT_TRUE(outConfig.mRedundantTimeServers.empty());
+    EXPECT_FALSE(outConfig.mFvRequestRetryPolicy.enabled);
+    EXPECT_EQ(FvDaemonMode::kDisabled, outConfig.mFvDaemon.mode);
+    EXPECT_FALSE(outConfig.mCrIndicationExecutor.enabled);
     // auth broadcast config
     EXPECT_EQ(outConfig.mAuthBroadcastConfig.size(), 1);
     ASSERT_TRUE(outConfig.mAuthBroadcastConfig.end() != outConfig.mAuthBroadcastConfig.find(1));
@@ -65,3 +80,169 @@ TEST(FvmConfigParserTest, parseConfigJsonSuccess)
     EXPECT_EQ(outConfig.mFmServerClientsConfig["ECU1"].clientResponseSignatureSignal, testSignal);
     EXPECT_EQ(outConfig.mFmServerClientsConfig["ECU1"].clientResponseValueSignal, testSignal);
 }
+
+TEST(FvmConfigParserTest, parseConfigJsonSignalTxBatchingSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"signal_tx_batching\":true,");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_TRUE(outConfig.mSignalTxBatching);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonSignalRecordingFileSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"signal_recording_file\":\"/tmp/fvm_signals.rec\",");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_EQ("/tmp/fvm_signals.rec", outConfig.mSignalRecordingFile);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonEventDrivenProcessingSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"event_driven_processing\":true,");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_TRUE(outConfig.mEventDrivenProcessing);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonEcuFunctionSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"ecu_function\":\"SERVER\",");
+    SokFmConfig outConfig;
+    outConfig.mEcuFunction = FvmRole::kParticipant;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_EQ(FvmRole::kServer, outConfig.mEcuFunction);
+
+    json = TEST_CONFIG_JSON;
+    json.insert(1, "\"ecu_function\":\"GATEWAY\",\"gateway_participant_config_file\":\"config_participant_sink.json\",");
+    FvmConfigParser gatewayParser;
+    ASSERT_TRUE(gatewayParser.Parse(json, outConfig));
+    EXPECT_EQ(FvmRole::kGateway, outConfig.mEcuFunction);
+    EXPECT_EQ("config_participant_sink.json", outConfig.mGatewayParticipantConfigFile);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonGatewayWithoutParticipantConfigFailed)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"ecu_function\":\"GATEWAY\",");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    EXPECT_FALSE(parser.Parse(json, outConfig));
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonInvalidEcuFunctionFailed)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"ecu_function\":\"CLIENT\",");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    EXPECT_FALSE(parser.Parse(json, outConfig));
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonFvDaemonSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"fv_daemon_config\":{\"mode\":\"CLIENT\",\"page_name\":\"/sok_fm_fv_state\",\"socket_path\":\"/run/sok_fm/fvm.sock\"},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_EQ(FvDaemonMode::kClient, outConfig.mFvDaemon.mode);
+    EXPECT_EQ("/sok_fm_fv_state", outConfig.mFvDaemon.pageName);
+    EXPECT_EQ("/run/sok_fm/fvm.sock", outConfig.mFvDaemon.socketPath);
+    EXPECT_EQ(FV_DAEMON_OWN_ID, outConfig.mFvDaemon.clientUid);
+    EXPECT_EQ(FV_DAEMON_OWN_ID, outConfig.mFvDaemon.clientGid);
+
+    json = TEST_CONFIG_JSON;
+    json.insert(1, "\"fv_daemon_config\":{\"mode\":\"DAEMON\",\"page_name\":\"/sok_fm_fv_state\",\"socket_path\":\"/run/sok_fm/fvm.sock\","
+                   "\"client_uid\":1001,\"client_gid\":1002},");
+    FvmConfigParser daemonParser;
+    ASSERT_TRUE(daemonParser.Parse(json, outConfig));
+    EXPECT_EQ(FvDaemonMode::kDaemon, outConfig.mFvDaemon.mode);
+    EXPECT_EQ(1001, outConfig.mFvDaemon.clientUid);
+    EXPECT_EQ(1002, outConfig.mFvDaemon.clientGid);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonFvDaemonInvalidPageNameFailed)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"fv_daemon_config\":{\"mode\":\"DAEMON\",\"page_name\":\"sok/fm\",\"socket_path\":\"/run/sok_fm/fvm.sock\"},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    EXPECT_FALSE(parser.Parse(json, outConfig));
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonCrIndicationExecutorSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"cr_indication_executor\":{\"thread_count\":2,\"queue_depth\":16},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_TRUE(outConfig.mCrIndicationExecutor.enabled);
+    EXPECT_EQ(2U, outConfig.mCrIndicationExecutor.threadCount);
+    EXPECT_EQ(16U, outConfig.mCrIndicationExecutor.queueDepth);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonCrIndicationExecutorWithoutThreadsFailed)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"cr_indication_executor\":{\"thread_count\":0,\"queue_depth\":16},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    EXPECT_FALSE(parser.Parse(json, outConfig));
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonGroupFvBroadcastSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"group_fv_broadcast_config\":{\"key_id\":456,\"period_ms\":100,\"signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":23},\"signal_config\":{\"name\":\"TEST_GROUP_SIGNAL_NAME\",\"start_byte\":0,\"length_in_bits\":184}}},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_TRUE(outConfig.mGroupFvBroadcast.enabled);
+    EXPECT_EQ(456, outConfig.mGroupFvBroadcast.keyId);
+    EXPECT_EQ(100U, outConfig.mGroupFvBroadcast.periodMs);
+    EXPECT_EQ("TEST_GROUP_SIGNAL_NAME", outConfig.mGroupFvBroadcast.signal.name);
+    EXPECT_EQ(184, outConfig.mGroupFvBroadcast.signal.lengthInBits);
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonFvRequestRetryPolicySuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"fv_request_retry_policy\":{\"base_delay_ms\":100,\"max_delay_ms\":2000},");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    EXPECT_TRUE(outConfig.mFvRequestRetryPolicy.enabled);
+    EXPECT_EQ(100U, outConfig.mFvRequestRetryPolicy.baseDelayMs);
+    EXPECT_EQ(2000U, outConfig.mFvRequestRetryPolicy.maxDelayMs);
+
+    // the cap must not be below the base delay
+    json = TEST_CONFIG_JSON;
+    json.insert(1, "\"fv_request_retry_policy\":{\"base_delay_ms\":100,\"max_delay_ms\":50},");
+    FvmConfigParser invalidCapParser;
+    EXPECT_FALSE(invalidCapParser.Parse(json, outConfig));
+}
+
+TEST(FvmConfigParserTest, parseConfigJsonRedundantTimeServersSuccess)
+{
+    std::string json(TEST_CONFIG_JSON);
+    json.insert(1, "\"redundant_time_servers\":[{\"server_ecu_name\":\"BACKUP_SERVER\",\"key_id\":789,\"challenge_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_BACKUP_CHALLENGE\",\"start_byte\":0,\"length_in_bits\":64}},\"response_value_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_BACKUP_VALUE\",\"start_byte\":0,\"length_in_bits\":64}},\"response_signature_signal\":{\"frame_config\":{\"name\":\"TETS_FRAME_NAME\",\"frame_max_payload_size\":16,\"source_ip\":\"fd53:7cb8:383:2::1\",\"destination_ip\":\"::1\",\"source_port\":1234,\"destination_port\":4321},\"pdu_config\":{\"name\":\"TEST_PDU_NAME\",\"pdu_id\":34,\"length_bytes\":8},\"signal_config\":{\"name\":\"TEST_BACKUP_SIGNATURE\",\"start_byte\":0,\"length_in_bits\":64}}}],");
+    SokFmConfig outConfig;
+    FvmConfigParser parser;
+    ASSERT_TRUE(parser.Parse(json, outConfig));
+    ASSERT_EQ(1U, outConfig.mRedundantTimeServers.size());
+    EXPECT_EQ("BACKUP_SERVER", outConfig.mRedundantTimeServers[0].serverEcuName);
+    EXPECT_EQ(789, outConfig.mRedundantTimeServers[0].keyId);
+    EXPECT_EQ("TEST_BACKUP_CHALLENGE", outConfig.mRedundantTimeServers[0].challengeSignal.name);
+    EXPECT_EQ("TEST_BACKUP_VALUE", outConfig.mRedundantTimeServers[0].responseValueSignal.name);
+    EXPECT_EQ("TEST_BACKUP_SIGNATURE", outConfig.mRedundantTimeServers[0].responseSignatureSignal.name);
+}
@@ -0,0 +1,173 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sok/fvm/FvmDaemonIpc.hpp"
+
+using namespace sok::fvm;
+
+class FvmDaemonIpcTest : public ::testing::Test
+{
+public:
+    FvmDaemonIpcTest()
+    : mSocketPath("/tmp/sok_fm_daemon_test_" + std::to_string(getpid()) + ".sock")
+    , mLastConnection(0)
+    {
+    }
+
+    void
+    handle(FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response)
+    {
+        mLastConnection = connection;
+        response.result = FvmErrorCode::kSuccess;
+        if (FvmIpcMessageType::kGetRxFreshness == request.type) {
+            // answers the truncated FV behind a constant FV byte
+            response.data[0] = 0xAA;
+            std::copy(request.data, request.data + request.length, response.data + 1);
+            response.length = static_cast<uint8_t>(request.length + 1U);
+        }
+        else if (FvmIpcMessageType::kTriggerCrRequest == request.type) {
+            response.result = FvmErrorCode::kRngError;
+        }
+    }
+
+    std::string mSocketPath;
+    std::atomic<FvmDaemonServer::ConnectionId> mLastConnection;
+};
+
+TEST_F(FvmDaemonIpcTest, request_response_round_trip_success)
+{
+    FvmDaemonServer server(mSocketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        handle(connection, request, response);
+    });
+    ASSERT_TRUE(server.Start());
+    FvmDaemonClient client(mSocketPath);
+    ASSERT_TRUE(client.Connect(nullptr));
+
+    FvmIpcMessage request{};
+    request.type = FvmIpcMessageType::kGetRxFreshness;
+    request.fvId = 7;
+    request.length = 2;
+    request.data[0] = 0x01;
+    request.data[1] = 0x02;
+    FvmIpcMessage response{};
+    ASSERT_EQ(FvmErrorCode::kSuccess, client.Request(request, response));
+    EXPECT_EQ(FvmIpcMessageType::kResponse, response.type);
+    EXPECT_EQ(FvmErrorCode::kSuccess, response.result);
+    EXPECT_EQ(7U, response.fvId);
+    ASSERT_EQ(3U, response.length);
+    EXPECT_EQ(0xAA, response.data[0]);
+    EXPECT_EQ(0x02, response.data[2]);
+
+    request.type = FvmIpcMessageType::kTriggerCrRequest;
+    ASSERT_EQ(FvmErrorCode::kSuccess, client.Request(request, response));
+    EXPECT_EQ(FvmErrorCode::kRngError, response.result);
+}
+
+TEST_F(FvmDaemonIpcTest, challenge_indication_reaches_client_success)
+{
+    FvmDaemonServer server(mSocketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        handle(connection, request, response);
+    });
+    ASSERT_TRUE(server.Start());
+    std::atomic<SokFreshnessValueId> indicatedFvId(0);
+    FvmDaemonClient client(mSocketPath);
+    ASSERT_TRUE(client.Connect([&indicatedFvId](SokFreshnessValueId fvId) {
+        indicatedFvId = fvId;
+    }));
+
+    FvmIpcMessage request{};
+    request.type = FvmIpcMessageType::kOfferCrRequest;
+    request.fvId = 9;
+    FvmIpcMessage response{};
+    ASSERT_EQ(FvmErrorCode::kSuccess, client.Request(request, response));
+
+    EXPECT_TRUE(server.SendIndication(mLastConnection, 9));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while ((9U != indicatedFvId) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(9U, indicatedFvId);
+    EXPECT_FALSE(server.SendIndication(mLastConnection + 1U, 9));
+}
+
+TEST_F(FvmDaemonIpcTest, socket_restricted_to_client_group_success)
+{
+    FvmDaemonServer server(mSocketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        handle(connection, request, response);
+    });
+    ASSERT_TRUE(server.Start());
+    struct stat socketStat{};
+    ASSERT_EQ(0, stat(mSocketPath.c_str(), &socketStat));
+    EXPECT_EQ(0660U, socketStat.st_mode & 0777U);
+    EXPECT_EQ(getegid(), socketStat.st_gid);
+}
+
+TEST_F(FvmDaemonIpcTest, fv_id_claimed_by_other_connection_failed)
+{
+    FvmDaemonServer server(mSocketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        handle(connection, request, response);
+    });
+    ASSERT_TRUE(server.Start());
+    FvmIpcMessage request{};
+    request.type = FvmIpcMessageType::kOfferCrRequest;
+    request.fvId = 9;
+    FvmIpcMessage response{};
+    FvmDaemonClient owner(mSocketPath);
+    ASSERT_TRUE(owner.Connect(nullptr));
+    ASSERT_EQ(FvmErrorCode::kSuccess, owner.Request(request, response));
+    auto ownerConnection = mLastConnection.load();
+    FvmDaemonClient other(mSocketPath);
+    ASSERT_TRUE(other.Connect(nullptr));
+    ASSERT_EQ(FvmErrorCode::kSuccess, other.Request(request, response));
+    auto otherConnection = mLastConnection.load();
+
+    EXPECT_TRUE(server.ClaimFvId(ownerConnection, 9));
+    EXPECT_FALSE(server.ClaimFvId(otherConnection, 9));
+    EXPECT_TRUE(server.ClaimFvId(ownerConnection, 9));
+    EXPECT_TRUE(server.ClaimFvId(otherConnection, 10));
+
+    // released once the owner disconnected
+    owner.Disconnect();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    auto claimed = server.ClaimFvId(otherConnection, 9);
+    while (!claimed && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        claimed = server.ClaimFvId(otherConnection, 9);
+    }
+    EXPECT_TRUE(claimed);
+}
+
+TEST_F(FvmDaemonIpcTest, request_without_daemon_failed)
+{
+    FvmDaemonClient client(mSocketPath);
+    EXPECT_FALSE(client.Connect(nullptr));
+    FvmIpcMessage request{};
+    FvmIpcMessage response{};
+    EXPECT_EQ(FvmErrorCode::kNotInitialized, client.Request(request, response));
+}
+
+TEST_F(FvmDaemonIpcTest, daemon_stopped_disconnects_client_failed)
+{
+    FvmDaemonServer server(mSocketPath, FV_DAEMON_OWN_ID, FV_DAEMON_OWN_ID, [this](FvmDaemonServer::ConnectionId connection, FvmIpcMessage const& request, FvmIpcMessage& response) {
+        handle(connection, request, response);
+    });
+    ASSERT_TRUE(server.Start());
+    FvmDaemonClient client(mSocketPath);
+    ASSERT_TRUE(client.Connect(nullptr));
+    server.Stop();
+
+    FvmIpcMessage request{};
+    FvmIpcMessage response{};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    auto ret = client.Request(request, response);
+    while ((FvmErrorCode::kNotInitialized != ret) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ret = client.Request(request, response);
+    }
+    EXPECT_EQ(FvmErrorCode::kNotInitialized, ret);
+}
@@ -0,0 +1,100 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <vector>
+#include "sok/fvm/FvmExecutor.hpp"
+
+using namespace sok::fvm;
+
+TEST(FvmExecutorTest, post_before_start_failed)
+{
+    FvmExecutor executor(4);
+    EXPECT_FALSE(executor.Post([]() {}));
+    EXPECT_EQ(0U, executor.GetRejectedTasks());
+}
+
+TEST(FvmExecutorTest, run_tasks_in_order_success)
+{
+    FvmExecutor executor(4);
+    ASSERT_TRUE(executor.Start());
+    std::vector<int> order;
+    std::promise<void> done;
+    EXPECT_TRUE(executor.Post([&order]() { order.push_back(1); }));
+    EXPECT_TRUE(executor.Post([&order]() { order.push_back(2); }));
+    EXPECT_TRUE(executor.Post([&order, &done]() {
+        order.push_back(3);
+        done.set_value();
+    }));
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+TEST(FvmExecutorTest, reject_when_queue_full_success)
+{
+    FvmExecutor executor(2);
+    ASSERT_TRUE(executor.Start());
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    EXPECT_TRUE(executor.Post([&started, releaseFuture]() {
+        started.set_value();
+        releaseFuture.wait();
+    }));
+    ASSERT_EQ(std::future_status::ready, started.get_future().wait_for(std::chrono::seconds(5)));
+
+    // the worker is busy, the queue takes its capacity only
+    EXPECT_TRUE(executor.Post([]() {}));
+    EXPECT_TRUE(executor.Post([]() {}));
+    EXPECT_FALSE(executor.Post([]() {}));
+    EXPECT_EQ(1U, executor.GetRejectedTasks());
+    release.set_value();
+}
+
+TEST(FvmExecutorTest, stop_drops_waiting_tasks_success)
+{
+    FvmExecutor executor(4);
+    ASSERT_TRUE(executor.Start());
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    bool dropped = true;
+    EXPECT_TRUE(executor.Post([&started, releaseFuture]() {
+        started.set_value();
+        releaseFuture.wait();
+    }));
+    EXPECT_TRUE(executor.Post([&dropped]() { dropped = false; }));
+    ASSERT_EQ(std::future_status::ready, started.get_future().wait_for(std::chrono::seconds(5)));
+
+    auto stopped = std::async(std::launch::async, [&executor]() { executor.Stop(); });
+    // Stop() waits for the running task
+    EXPECT_EQ(std::future_status::timeout, stopped.wait_for(std::chrono::milliseconds(20)));
+    release.set_value();
+    stopped.get();
+    EXPECT_TRUE(dropped);
+    EXPECT_FALSE(executor.Post([]() {}));
+}
+
+TEST(FvmExecutorTest, run_tasks_concurrently_on_several_threads_success)
+{
+    FvmExecutor executor(4, 2);
+    ASSERT_TRUE(executor.Start());
+    std::promise<void> firstStarted;
+    std::promise<void> secondStarted;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    EXPECT_TRUE(executor.Post([&firstStarted, releaseFuture]() {
+        firstStarted.set_value();
+        releaseFuture.wait();
+    }));
+    EXPECT_TRUE(executor.Post([&secondStarted, releaseFuture]() {
+        secondStarted.set_value();
+        releaseFuture.wait();
+    }));
+
+    // both tasks run while none of them returned
+    EXPECT_EQ(std::future_status::ready, firstStarted.get_future().wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(std::future_status::ready, secondStarted.get_future().wait_for(std::chrono::seconds(5)));
+    release.set_value();
+}
@@ -0,0 +1,148 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include "sok/fvm/SignalManagerRecorder.hpp"
+#include "sok/fvm/SignalManagerReplay.hpp"
+#include "sok/fvm/FvmReplayDriver.hpp"
+
+using namespace sok::fvm;
+
+namespace
+{
+
+class ReplayTestFvm : public AFreshnessValueManagerImpl
+{
+public:
+    explicit ReplayTestFvm(std::shared_ptr<ISignalManager> signalManager)
+    : AFreshnessValueManagerImpl(std::move(signalManager))
+    {}
+
+    FvmErrorCode MainFunction() noexcept override
+    {
+        ++mainFunctionCalls;
+        return FvmErrorCode::kSuccess;
+    }
+    bool serverOrParticipantInit() noexcept override { return true; }
+    std::vector<SignalConfig> serverOrParticipantOutgoingSignals() noexcept override { return {}; }
+
+    uint64_t mainFunctionCalls = 0;
+};
+
+SignalConfig
+testSignal(std::string const& name)
+{
+    SignalConfig signal;
+    signal.name = name;
+    return signal;
+}
+
+} // namespace
+
+class SignalManagerRecorderTest : public ::testing::Test
+{
+public:
+    SignalManagerRecorderTest()
+    : mRecordingFile("/tmp/sok_fm_recorder_test_" + std::to_string(getpid()) + ".rec")
+    {}
+
+    ~SignalManagerRecorderTest()
+    {
+        std::remove(mRecordingFile.c_str());
+    }
+
+    std::string mRecordingFile;
+};
+
+TEST_F(SignalManagerRecorderTest, record_and_read_success)
+{
+    auto transport = std::make_shared<SignalManagerReplay>();
+    std::vector<uint8_t> received;
+    {
+        SignalManagerRecorder recorder(transport, mRecordingFile);
+        ASSERT_TRUE(recorder.IsRecording());
+        EXPECT_EQ(FvmErrorCode::kSuccess, recorder.Subscribe(testSignal("RX_SIGNAL"), [&received](std::string const&, std::vector<uint8_t> const& value) {
+            received = value;
+        }));
+        EXPECT_TRUE(transport->Deliver("RX_SIGNAL", {1, 2, 3}));
+        EXPECT_EQ(FvmErrorCode::kSuccess, recorder.Publish(testSignal("TX_SIGNAL"), {4, 5}));
+    }
+    EXPECT_EQ((std::vector<uint8_t>{1, 2, 3}), received);
+    EXPECT_EQ(1U, transport->TakePublishedSignals().size());
+
+    auto readRes = ReadSignalRecording(mRecordingFile);
+    ASSERT_TRUE(readRes.isSucceeded());
+    auto records = readRes.getObject();
+    ASSERT_EQ(3U, records.size());
+    EXPECT_EQ(SignalRecordType::kSubscribe, records[0].type);
+    EXPECT_EQ("RX_SIGNAL", records[0].signalName);
+    EXPECT_TRUE(records[0].payload.empty());
+    EXPECT_EQ(SignalRecordType::kReceive, records[1].type);
+    EXPECT_EQ("RX_SIGNAL", records[1].signalName);
+    EXPECT_EQ((std::vector<uint8_t>{1, 2, 3}), records[1].payload);
+    EXPECT_EQ(SignalRecordType::kPublish, records[2].type);
+    EXPECT_EQ("TX_SIGNAL", records[2].signalName);
+    EXPECT_EQ((std::vector<uint8_t>{4, 5}), records[2].payload);
+    EXPECT_LE(records[0].timestampNs, records[1].timestampNs);
+    EXPECT_LE(records[1].timestampNs, records[2].timestampNs);
+}
+
+TEST_F(SignalManagerRecorderTest, read_truncated_recording_success)
+{
+    SignalRecordingWriter writer;
+    ASSERT_EQ(FvmErrorCode::kSuccess, writer.Open(mRecordingFile));
+    EXPECT_EQ(FvmErrorCode::kSuccess, writer.Write({10, SignalRecordType::kReceive, "RX_SIGNAL", {1, 2, 3, 4}}));
+    EXPECT_EQ(FvmErrorCode::kSuccess, writer.Write({20, SignalRecordType::kReceive, "RX_SIGNAL", {5, 6, 7, 8}}));
+    ASSERT_EQ(0, truncate(mRecordingFile.c_str(), 10 + 2 * (15 + 9 + 4) - 2));
+
+    // only the complete records are returned
+    auto readRes = ReadSignalRecording(mRecordingFile);
+    ASSERT_TRUE(readRes.isSucceeded());
+    ASSERT_EQ(1U, readRes.getObject().size());
+    EXPECT_EQ(10U, readRes.getObject()[0].timestampNs);
+}
+
+TEST_F(SignalManagerRecorderTest, read_invalid_recording_failure)
+{
+    std::ofstream(mRecordingFile, std::ios::out | std::ios::binary) << "not a recording";
+
+    EXPECT_TRUE(ReadSignalRecording(mRecordingFile).isFailed());
+    EXPECT_TRUE(ReadSignalRecording(mRecordingFile + ".missing").isFailed());
+}
+
+TEST_F(SignalManagerRecorderTest, replay_virtual_clock_success)
+{
+    auto replaySignalManager = std::make_shared<SignalManagerReplay>();
+    ReplayTestFvm fvm(replaySignalManager);
+    std::vector<uint64_t> receivedAtCycle;
+    EXPECT_EQ(FvmErrorCode::kSuccess, replaySignalManager->Subscribe(testSignal("RX_SIGNAL"), [&](std::string const&, std::vector<uint8_t> const&) {
+        receivedAtCycle.push_back(fvm.mainFunctionCalls);
+        replaySignalManager->Publish(testSignal("TX_SIGNAL"), {0xAA});
+    }));
+    std::vector<SignalRecord> records{
+        {0, SignalRecordType::kSubscribe, "RX_SIGNAL", {}},
+        {12000000, SignalRecordType::kReceive, "RX_SIGNAL", {1}},
+        {1000000, SignalRecordType::kReceive, "RX_SIGNAL", {2}},
+        {3000000, SignalRecordType::kReceive, "UNKNOWN_SIGNAL", {3}},
+        {13000000, SignalRecordType::kPublish, "TX_SIGNAL", {0xAA}},
+    };
+
+    FvmReplayDriver driver(fvm, replaySignalManager);
+    auto statistics = driver.Run(records, ReplaySpeed::kAsFastAsPossible);
+
+    // 12 ms of recording plus the challenge timeout, in steps of the MainFunction period
+    EXPECT_EQ(53U, statistics.mainFunctionCycles);
+    EXPECT_EQ(53U, fvm.mainFunctionCalls);
+    EXPECT_EQ(0U, statistics.mainFunctionErrors);
+    EXPECT_EQ(2U, statistics.deliveredSignals);
+    EXPECT_EQ(1U, statistics.droppedSignals);
+    EXPECT_EQ(1U, statistics.recordedPublications);
+    EXPECT_EQ(2U, statistics.replayedPublications);
+    // signals are delivered in timestamp order before the first cycle at or after their timestamp
+    EXPECT_EQ((std::vector<uint64_t>{1, 3}), receivedAtCycle);
+    ASSERT_EQ(2U, statistics.publishedSignals.size());
+    EXPECT_EQ(5000000U, statistics.publishedSignals[0].timestampNs);
+    EXPECT_EQ(15000000U, statistics.publishedSignals[1].timestampNs);
+}
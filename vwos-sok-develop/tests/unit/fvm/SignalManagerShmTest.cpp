@@ -0,0 +1,220 @@
+/* Copyright (c) 2023 Volkswagen Group */
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "sok/fvm/SignalManagerShm.hpp"
+
+using namespace sok::fvm;
+
+class SignalManagerShmFailingTransmitStub : public SignalManagerShm
+{
+public:
+    FvmErrorCode
+    transmit(std::shared_ptr<ShmFrameRing> const&, std::vector<PendingSignalUpdate> const& updates) const override
+    {
+        mTransmittedUpdates += updates.size();
+        return FvmErrorCode::kGeneralError;
+    }
+
+    mutable size_t mTransmittedUpdates = 0;
+};
+
+class SignalManagerShmTest : public ::testing::Test
+{
+public:
+    SignalManagerShmTest()
+    {
+        FrameConfig testFrame;
+        testFrame.name = "SHM_TEST_FRAME_" + std::to_string(getpid());
+        testFrame.maxPayloadSizeBytes = 16;
+        testFrame.sourceIp = "fd53:7cb8:383:2::1";
+        testFrame.destinationIp = "::1";
+        testFrame.sourcePort = 1234;
+        testFrame.destinationPort = 4321;
+        PduConfig testPdu;
+        testPdu.frameConfig = testFrame;
+        testPdu.name = "SHM_TEST_PDU";
+        testPdu.id = 34;
+        testPdu.lengthBytes = 8;
+        mTestSignal.pduConfig = testPdu;
+        mTestSignal.name = "SHM_TEST_SIGNAL";
+        mTestSignal.startByte = 0;
+        mTestSignal.lengthInBits = 64;
+    }
+
+    ~SignalManagerShmTest()
+    {
+        shm_unlink(segmentName().c_str());
+    }
+
+    std::string
+    segmentName() const
+    {
+        return "/sok_fm_" + mTestSignal.pduConfig.frameConfig.name;
+    }
+
+    bool
+    segmentExists() const
+    {
+        int fd = shm_open(segmentName().c_str(), O_RDONLY, 0);
+        if (-1 == fd) {
+            EXPECT_EQ(ENOENT, errno);
+            return false;
+        }
+        close(fd);
+        return true;
+    }
+
+    bool
+    waitForSignal(std::vector<uint8_t>& value)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        bool received = mCv.wait_for(lock, std::chrono::seconds(2), [this] { return !mReceived.empty(); });
+        if (received) {
+            value = mReceived.front();
+            mReceived.erase(mReceived.begin());
+        }
+        return received;
+    }
+
+    ISignalManager::SignalEventCallback
+    collectingCb()
+    {
+        return [this](std::string const& signal, std::vector<uint8_t> const& value) {
+            EXPECT_EQ(mTestSignal.name, signal);
+            std::lock_guard<std::mutex> lock(mMutex);
+            mReceived.push_back(value);
+            mCv.notify_all();
+        };
+    }
+
+    SignalConfig mTestSignal;
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    std::vector<std::vector<uint8_t>> mReceived;
+};
+
+TEST_F(SignalManagerShmTest, publish_subscribe_success)
+{
+    SignalManagerShm receiver;
+    SignalManagerShm sender;
+    std::vector<uint8_t> value{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint8_t> received;
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, receiver.Subscribe(mTestSignal, collectingCb()));
+    // give the receiver thread the chance to take its starting position in the ring
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, value));
+    ASSERT_TRUE(waitForSignal(received));
+    EXPECT_EQ(value, received);
+
+    value[0] = 9;
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, value));
+    ASSERT_TRUE(waitForSignal(received));
+    EXPECT_EQ(value, received);
+}
+
+TEST_F(SignalManagerShmTest, subscribe_twice_failure)
+{
+    SignalManagerShm receiver;
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, receiver.Subscribe(mTestSignal, collectingCb()));
+    EXPECT_EQ(FvmErrorCode::kAlreadyInitialized, receiver.Subscribe(mTestSignal, collectingCb()));
+}
+
+TEST_F(SignalManagerShmTest, publish_oversized_value_failure)
+{
+    SignalManagerShm sender;
+    std::vector<uint8_t> value(mTestSignal.pduConfig.frameConfig.maxPayloadSizeBytes + 1U, 0xAA);
+
+    EXPECT_EQ(FvmErrorCode::kGeneralError, sender.Publish(mTestSignal, value));
+}
+
+TEST_F(SignalManagerShmTest, tx_batching_flush_success)
+{
+    SignalManagerShm receiver;
+    SignalManagerShm sender;
+    std::vector<uint8_t> firstValue{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint8_t> latestValue{8, 7, 6, 5, 4, 3, 2, 1};
+    std::vector<uint8_t> received;
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, receiver.Subscribe(mTestSignal, collectingCb()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    sender.SetTxBatching(true);
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, firstValue));
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, latestValue));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        EXPECT_TRUE(mReceived.empty());
+    }
+
+    // only the latest value of the signal is transmitted
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Flush());
+    ASSERT_TRUE(waitForSignal(received));
+    EXPECT_EQ(latestValue, received);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::lock_guard<std::mutex> lock(mMutex);
+    EXPECT_TRUE(mReceived.empty());
+}
+
+TEST_F(SignalManagerShmTest, tx_batching_flush_transmit_failure)
+{
+    SignalManagerShmFailingTransmitStub sender;
+    std::vector<uint8_t> value{1, 2, 3, 4, 5, 6, 7, 8};
+
+    sender.SetTxBatching(true);
+    // the update is only queued, the transmit failure is reported by the flush
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, value));
+    EXPECT_EQ(0U, sender.mTransmittedUpdates);
+    EXPECT_EQ(FvmErrorCode::kGeneralError, sender.Flush());
+    EXPECT_EQ(1U, sender.mTransmittedUpdates);
+
+    // the failed update was dropped
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Flush());
+    EXPECT_EQ(1U, sender.mTransmittedUpdates);
+}
+
+TEST_F(SignalManagerShmTest, segment_unlinked_by_last_user_success)
+{
+    std::unique_ptr<SignalManagerShm> receiver(new SignalManagerShm());
+    std::unique_ptr<SignalManagerShm> sender(new SignalManagerShm());
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, receiver->Subscribe(mTestSignal, collectingCb()));
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender->PrepareOutgoing(mTestSignal));
+    EXPECT_TRUE(segmentExists());
+
+    receiver.reset();
+    EXPECT_TRUE(segmentExists());
+    sender.reset();
+    EXPECT_FALSE(segmentExists());
+}
+
+TEST_F(SignalManagerShmTest, leftover_segment_recreated_success)
+{
+    // a creator which died before initializing the ring leaves a zeroed segment behind
+    int fd = shm_open(segmentName().c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    ASSERT_NE(-1, fd);
+    EXPECT_EQ(0, ftruncate(fd, 4096));
+    close(fd);
+
+    SignalManagerShm receiver;
+    SignalManagerShm sender;
+    std::vector<uint8_t> value{1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint8_t> received;
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, receiver.Subscribe(mTestSignal, collectingCb()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    EXPECT_EQ(FvmErrorCode::kSuccess, sender.Publish(mTestSignal, value));
+    ASSERT_TRUE(waitForSignal(received));
+    EXPECT_EQ(value, received);
+}
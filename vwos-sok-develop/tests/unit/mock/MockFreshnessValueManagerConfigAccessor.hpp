@@ -31,6 +31,17 @@ public:
     MOCK_METHOD(SignalConfig, GetAuthenticatedFvChallengeSignalConfig, (), (const, override));
     MOCK_METHOD(SokKeyConfig, GetSokKeyConfig, (), (const, override));
     MOCK_METHOD(uint16_t, GetEcuKeyIdForFvDistribution, (), (const, override));
+    MOCK_METHOD(bool, IsSignalTxBatchingEnabled, (), (const, override));
+    MOCK_METHOD(std::string, GetSignalRecordingFile, (), (const, override));
+    MOCK_METHOD(std::string, GetFvCheckpointFile, (), (const, override));
+    MOCK_METHOD(bool, IsEventDrivenProcessingEnabled, (), (const, override));
+    MOCK_METHOD(FvmRole, GetEcuFunction, (), (const, override));
+    MOCK_METHOD(std::string, GetGatewayParticipantConfigFile, (), (const, override));
+    MOCK_METHOD(GroupFvBroadcastConfig, GetGroupFvBroadcastConfig, (), (const, override));
+    MOCK_METHOD(TimeServerEndpoints, GetRedundantTimeServers, (), (const, override));
+    MOCK_METHOD(FvRequestRetryPolicy, GetFvRequestRetryPolicy, (), (const, override));
+    MOCK_METHOD(FvDaemonConfig, GetFvDaemonConfig, (), (const, override));
+    MOCK_METHOD(CrIndicationExecutorConfig, GetCrIndicationExecutorConfig, (), (const, override));
 };
 
 class UTFreshnessValueManagerConfigAccessor : public IFreshnessValueManagerConfigAccessor
@@ -116,6 +127,50 @@ public:
     {
         return mMockFvConfAccessor->GetEcuKeyIdForFvDistribution();
     }
+    bool IsSignalTxBatchingEnabled() const override 
+    {
+        return mMockFvConfAccessor->IsSignalTxBatchingEnabled();
+    }
+    std::string GetSignalRecordingFile() const override 
+    {
+        return mMockFvConfAccessor->GetSignalRecordingFile();
+    }
+    std::string GetFvCheckpointFile() const override 
+    {
+        return mMockFvConfAccessor->GetFvCheckpointFile();
+    }
+    bool IsEventDrivenProcessingEnabled() const override 
+    {
+        return mMockFvConfAccessor->IsEventDrivenProcessingEnabled();
+    }
+    FvmRole GetEcuFunction() const override 
+    {
+        return mMockFvConfAccessor->GetEcuFunction();
+    }
+    std::string GetGatewayParticipantConfigFile() const override 
+    {
+        return mMockFvConfAccessor->GetGatewayParticipantConfigFile();
+    }
+    GroupFvBroadcastConfig GetGroupFvBroadcastConfig() const override 
+    {
+        return mMockFvConfAccessor->GetGroupFvBroadcastConfig();
+    }
+    TimeServerEndpoints GetRedundantTimeServers() const override 
+    {
+        return mMockFvConfAccessor->GetRedundantTimeServers();
+    }
+    FvRequestRetryPolicy GetFvRequestRetryPolicy() const override 
+    {
+        return mMockFvConfAccessor->GetFvRequestRetryPolicy();
+    }
+    FvDaemonConfig GetFvDaemonConfig() const override 
+    {
+        return mMockFvConfAccessor->GetFvDaemonConfig();
+    }
+    CrIndicationExecutorConfig GetCrIndicationExecutorConfig() const override 
+    {
+        return mMockFvConfAccessor->GetCrIndicationExecutorConfig();
+    }
 
     static MockFreshnessValueManagerConfigAccessor* mMockFvConfAccessor;
 };
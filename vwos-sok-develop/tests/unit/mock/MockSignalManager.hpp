@@ -16,6 +16,10 @@ class MockSignalManager : public ISignalManager
 public:
     MOCK_METHOD(FvmErrorCode, Subscribe, (SignalConfig const&, SignalEventCallback const&), (override));
     MOCK_METHOD(FvmErrorCode, Publish, (SignalConfig const&, std::vector<uint8_t> const&), (override));
+    MOCK_METHOD(FvmErrorCode, PublishUnbatched, (SignalConfig const&, std::vector<uint8_t> const&), (override));
+    MOCK_METHOD(FvmErrorCode, PrepareOutgoing, (SignalConfig const&), (override));
+    MOCK_METHOD(void, SetTxBatching, (bool), (override));
+    MOCK_METHOD(FvmErrorCode, Flush, (), (override));
 };
 
 class UTSignalManager : public ISignalManager
@@ -33,6 +37,30 @@ public:
         return mMockSm->Publish(signalConfig, value);
     }
 
+    FvmErrorCode 
+    PublishUnbatched(SignalConfig const& signalConfig, std::vector<uint8_t> const& value) override
+    {
+        return mMockSm->PublishUnbatched(signalConfig, value);
+    }
+
+    FvmErrorCode 
+    PrepareOutgoing(SignalConfig const& signalConfig) override
+    {
+        return mMockSm->PrepareOutgoing(signalConfig);
+    }
+
+    void 
+    SetTxBatching(bool enabled) override
+    {
+        mMockSm->SetTxBatching(enabled);
+    }
+
+    FvmErrorCode 
+    Flush() override
+    {
+        return mMockSm->Flush();
+    }
+
     static MockSignalManager* mMockSm;
 };
 